@@ -0,0 +1,6 @@
+#include "bsp.h"
+
+#include <stdio.h>
+
+/* 输出由终端按周期刷新 */
+void bsp_init() { setvbuf(stdout, NULL, _IOFBF, BUFSIZ); }
@@ -0,0 +1,70 @@
+#include "bsp_flash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* 数据只保存在内存中，每次仿真都从默认值开始 */
+#define BSP_FLASH_BLOG_NUM (32)
+#define BSP_FLASH_NAME_LEN (32)
+
+typedef struct {
+  char name[BSP_FLASH_NAME_LEN];
+  uint8_t *data;
+  size_t len;
+} bsp_flash_blog_t;
+
+static bsp_flash_blog_t blog_list[BSP_FLASH_BLOG_NUM];
+
+static bsp_flash_blog_t *bsp_flash_find(const char *name) {
+  for (size_t i = 0; i < BSP_FLASH_BLOG_NUM; i++) {
+    if (blog_list[i].data != NULL &&
+        strncmp(blog_list[i].name, name, BSP_FLASH_NAME_LEN) == 0) {
+      return &blog_list[i];
+    }
+  }
+
+  return NULL;
+}
+
+bsp_status_t bsp_flash_init() { return BSP_OK; }
+
+size_t bsp_flash_check_blog(const char *name) {
+  bsp_flash_blog_t *blog = bsp_flash_find(name);
+  return blog ? blog->len : 0;
+}
+
+void bsp_flash_get_blog(const char *name, uint8_t *buff, uint32_t len) {
+  bsp_flash_blog_t *blog = bsp_flash_find(name);
+  if (blog == NULL || blog->len != len) {
+    return;
+  }
+
+  memcpy(buff, blog->data, len);
+}
+
+void bsp_flash_set_blog(const char *name, const uint8_t *buff, uint32_t len) {
+  bsp_flash_blog_t *blog = bsp_flash_find(name);
+
+  if (blog == NULL) {
+    for (size_t i = 0; i < BSP_FLASH_BLOG_NUM; i++) {
+      if (blog_list[i].data == NULL) {
+        blog = &blog_list[i];
+        strncpy(blog->name, name, BSP_FLASH_NAME_LEN - 1);
+        break;
+      }
+    }
+  }
+
+  XB_ASSERT(blog);
+  if (blog == NULL) {
+    return;
+  }
+
+  if (blog->len != len) {
+    free(blog->data);
+    blog->data = (uint8_t *)malloc(len);
+    blog->len = len;
+  }
+
+  memcpy(blog->data, buff, len);
+}
@@ -0,0 +1,36 @@
+#include "bsp_time.h"
+
+#include <time.h>
+
+#include "bsp_sys.h"
+
+/* 虚拟时钟，不随真实时间流逝，只由调度器和休眠推进 */
+static uint64_t time_us = 0;
+static uint32_t end_time = 0;
+
+uint32_t bsp_time_get_ms() { return time_us / 1000; }
+
+uint64_t bsp_time_get_us() { return time_us; }
+
+uint64_t bsp_time_get() __attribute__((alias("bsp_time_get_us")));
+
+uint64_t bsp_time_get_cpu_us() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void bsp_time_advance_to(uint32_t time) {
+  int32_t delta = (int32_t)(time - bsp_time_get_ms());
+  if (delta <= 0) {
+    return;
+  }
+
+  time_us = (time_us / 1000 + (uint64_t)delta) * 1000;
+
+  if (end_time != 0 && (int32_t)(bsp_time_get_ms() - end_time) >= 0) {
+    bsp_sys_shutdown();
+  }
+}
+
+void bsp_time_set_end(uint32_t time) { end_time = time; }
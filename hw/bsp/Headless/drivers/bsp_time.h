@@ -0,0 +1,30 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "bsp.h"
+
+uint32_t bsp_time_get_ms();
+
+uint64_t bsp_time_get_us();
+
+/*
+  虚拟时钟只按整毫秒推进，同一毫秒内两次读取的差值为0，
+  因此trace的时间跨度与perf测得的耗时在此板上均为0。
+*/
+uint64_t bsp_time_get();
+
+/* 本线程消耗的主机CPU时间(us)，只用于统计任务耗时，不影响虚拟时钟 */
+uint64_t bsp_time_get_cpu_us();
+
+/* 将虚拟时钟推进到time毫秒，时间只会向前走 */
+void bsp_time_advance_to(uint32_t time);
+
+/* 虚拟时间到达time毫秒后退出，为0时一直运行 */
+void bsp_time_set_end(uint32_t time);
+
+#ifdef __cplusplus
+}
+#endif
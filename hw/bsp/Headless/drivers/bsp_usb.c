@@ -0,0 +1,76 @@
+#include "bsp_usb.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/* 终端使用标准输入输出 */
+static bsp_callback_t callback_list[BSP_USB_NUM][BSP_USB_CB_NUM];
+
+static int rx_char = -1;
+
+bsp_status_t bsp_usb_transmit(const uint8_t *buffer, uint32_t len) {
+  fwrite(buffer, 1, len, stdout);
+  return BSP_OK;
+}
+
+size_t bsp_usb_avail(void) {
+  if (rx_char >= 0) {
+    return 1;
+  }
+
+  char buff = 0;
+  if (read(STDIN_FILENO, &buff, 1) != 1) {
+    return 0;
+  }
+
+  rx_char = (unsigned char)buff;
+
+  bsp_callback_t cb = callback_list[BSP_USB_CDC][BSP_USB_RX_CPLT_CB];
+  if (cb.fn) {
+    cb.fn(cb.arg);
+  }
+
+  return 1;
+}
+
+char bsp_usb_read_char(void) {
+  if (!bsp_usb_avail()) {
+    return 0;
+  }
+
+  char buff = (char)rx_char;
+  rx_char = -1;
+  return buff;
+}
+
+size_t bsp_usb_read(uint8_t *buffer, uint32_t len) {
+  size_t recv_len = 0;
+  while (recv_len < len && bsp_usb_avail()) {
+    buffer[recv_len++] = (uint8_t)bsp_usb_read_char();
+  }
+  return recv_len;
+}
+
+bool bsp_usb_connect(void) { return true; }
+
+void bsp_usb_init() {
+  /* 交互时不阻塞仿真，从文件或管道读取脚本时阻塞读取，
+     每条输入到达的虚拟时间与主机速度无关 */
+  if (isatty(STDIN_FILENO)) {
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+  }
+}
+
+void bsp_usb_update() { fflush(stdout); }
+
+bsp_status_t bsp_usb_register_callback(bsp_usb_t usb, bsp_usb_callback_t type,
+                                       void (*callback)(void *),
+                                       void *callback_arg) {
+  XB_ASSERT(callback);
+  XB_ASSERT(type != BSP_USB_CB_NUM);
+
+  callback_list[usb][type].fn = callback;
+  callback_list[usb][type].arg = callback_arg;
+  return BSP_OK;
+}
@@ -0,0 +1,18 @@
+#include <cstdlib>
+
+#include "bsp.h"
+#include "bsp_time.h"
+#include "robot.hpp"
+
+/* 参数为仿真时长，单位s，不指定时一直运行 */
+int main(int argc, char** argv) {
+  bsp_init();
+
+  if (argc > 1) {
+    bsp_time_set_end(static_cast<uint32_t>(atof(argv[1]) * 1000.0));
+  }
+
+  robot_init();
+
+  return 0;
+}
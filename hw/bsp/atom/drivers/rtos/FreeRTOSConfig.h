@@ -66,7 +66,11 @@ void xPortSysTickHandler(void);
 
 #define configUSE_PREEMPTION 1
 #define configUSE_TICKLESS_IDLE 0
+#if FREERTOS_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION 1
+#else
 #define configSUPPORT_STATIC_ALLOCATION 0
+#endif
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #define configUSE_IDLE_HOOK 0
 #define configUSE_TICK_HOOK 0
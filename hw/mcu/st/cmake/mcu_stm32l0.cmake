@@ -26,3 +26,6 @@ set(LINKER_SCRIPT ${BOARD_DIR}/ld/LinkerScripts.ld)
 set(CMAKE_EXE_LINKER_FLAGS
     "-T${LINKER_SCRIPT} --specs=nano.specs --specs=nosys.specs -Wl,--cref,--gc-sections,--print-memory-usage,-Map=${CMAKE_PROJECT_NAME}.map"
     CACHE INTERNAL "" FORCE)
+
+# 无FPU，控制器使用定点实现
+add_compile_definitions(COMP_USE_FIXED_POINT=1)
@@ -2,8 +2,10 @@
 
 #include <component.hpp>
 
+#include "comp_biquad.hpp"
 #include "comp_cf.hpp"
 #include "comp_filter.hpp"
+#include "comp_fixed.hpp"
 #include "comp_pid.hpp"
 
 namespace Component {
@@ -58,10 +60,10 @@ class SpeedActuator {
   void Reset();
 
  private:
-  Component::PID pid_;
+  Component::ControlPID pid_;
 
-  Component::LowPassFilter2p in_;
-  Component::LowPassFilter2p out_;
+  Component::ControlFilter in_;
+  Component::ControlFilter out_;
 };
 
 class PosActuator {
@@ -82,12 +84,192 @@ class PosActuator {
   void Reset();
 
  private:
-  Component::PID pid_speed_;
-  Component::PID pid_position_;
+  Component::ControlPID pid_speed_;
+  Component::ControlPID pid_position_;
 
-  Component::LowPassFilter2p in_speed_;
-  Component::LowPassFilter2p in_position_;
+  Component::ControlFilter in_speed_;
+  Component::ControlFilter in_position_;
 
-  Component::LowPassFilter2p out_;
+  Component::ControlFilter out_;
+};
+
+/* 速度执行器组，N个SpeedActuator的状态按数组连续存放，一次遍历全部更新 */
+template <size_t N>
+class ActuatorBank {
+ public:
+  ActuatorBank(const std::array<SpeedActuator::Param, N>& param,
+               float sample_freq) {
+    const float DT_MIN = 1.0f / sample_freq;
+    XB_ASSERT(isfinite(DT_MIN));
+
+    for (size_t i = 0; i < N; i++) {
+      const Component::PID::Param& pid = param[i].speed;
+      this->pid_.k[i] = pid.k;
+      this->pid_.p[i] = pid.p;
+      this->pid_.i[i] = pid.i;
+      this->pid_.d[i] = pid.d;
+      this->pid_.i_limit[i] = pid.i_limit;
+      this->pid_.out_limit[i] = pid.out_limit;
+      this->pid_.cycle[i] = pid.cycle;
+      this->pid_.dt_min[i] = DT_MIN;
+
+      InitFilter(this->dfilter_, i, sample_freq, pid.d_cutoff_freq);
+      InitFilter(this->in_, i, sample_freq, param[i].in_cutoff_freq);
+      InitFilter(this->out_, i, sample_freq, param[i].out_cutoff_freq);
+    }
+
+    this->Reset();
+  }
+
+  /* 默认配置下与逐个调用SpeedActuator::Calculate结果一致 */
+  void Calculate(const float* setpoint, const float* feedback, float dt,
+                 float* out) {
+    float fb[N];
+
+    ApplyFilter(this->in_, feedback, fb);
+
+    const bool DT_VALID = isfinite(dt);
+
+    for (size_t i = 0; i < N; i++) {
+      /* 输入无效时与PID一致，保持全部状态不变 */
+      const bool VALID = DT_VALID && isfinite(setpoint[i]) && isfinite(fb[i]);
+
+      /* 计算误差值 */
+      const float ERR = this->pid_.cycle[i]
+                            ? Component::Type::CycleValue(setpoint[i]) - fb[i]
+                            : setpoint[i] - fb[i];
+
+      /* 计算P项 */
+      const float K_ERR = ERR * this->pid_.k[i];
+
+      /* D项滤波 */
+      const float K_FB = this->pid_.k[i] * fb[i];
+      float delay_0 = K_FB - this->dfilter_.delay_1[i] * this->dfilter_.a1[i] -
+                      this->dfilter_.delay_2[i] * this->dfilter_.a2[i];
+      delay_0 = isinf(delay_0) ? K_FB : delay_0;
+      const float FILTERED_K_FB =
+          delay_0 * this->dfilter_.b0[i] +
+          this->dfilter_.delay_1[i] * this->dfilter_.b1[i] +
+          this->dfilter_.delay_2[i] * this->dfilter_.b2[i];
+
+      /* 计算D项 */
+      float d = (FILTERED_K_FB - this->pid_.last_k_fb[i]) /
+                fmaxf(dt, this->pid_.dt_min[i]);
+      d = isfinite(d) ? d : 0.0f;
+
+      /* 计算PD输出 */
+      float output = (K_ERR * this->pid_.p[i]) - (d * this->pid_.d[i]);
+
+      /* 计算I项 */
+      const float I = this->pid_.i_[i] + (K_ERR * dt);
+      const float I_OUT = I * this->pid_.i[i];
+
+      /* 检查是否饱和 */
+      const bool I_UPDATE = this->pid_.i[i] > SIGMA && isfinite(I) &&
+                            fabsf(output + I_OUT) <= this->pid_.out_limit[i] &&
+                            fabsf(I) <= this->pid_.i_limit[i];
+
+      /* 计算PID输出 */
+      output += I_OUT;
+
+      /* 限制输出 */
+      if (this->pid_.out_limit[i] > SIGMA) {
+        output = abs_clampf(output, this->pid_.out_limit[i]);
+      }
+
+      const bool OUT_UPDATE = VALID && isfinite(output);
+
+      this->dfilter_.delay_2[i] =
+          VALID ? this->dfilter_.delay_1[i] : this->dfilter_.delay_2[i];
+      this->dfilter_.delay_1[i] = VALID ? delay_0 : this->dfilter_.delay_1[i];
+      this->pid_.i_[i] = (VALID && I_UPDATE) ? I : this->pid_.i_[i];
+      this->pid_.last_k_fb[i] =
+          VALID ? FILTERED_K_FB : this->pid_.last_k_fb[i];
+      this->pid_.last_out[i] = OUT_UPDATE ? output : this->pid_.last_out[i];
+
+      out[i] = this->pid_.last_out[i];
+    }
+
+    /* 与SpeedActuator一致，输出滤波器只更新状态 */
+    float filtered[N];
+    ApplyFilter(this->out_, out, filtered);
+  }
+
+  void Reset() {
+    for (size_t i = 0; i < N; i++) {
+      this->Reset(i);
+    }
+  }
+
+  void Reset(size_t index) {
+    this->in_.delay_1[index] = 0.0f;
+    this->in_.delay_2[index] = 0.0f;
+    this->out_.delay_1[index] = 0.0f;
+    this->out_.delay_2[index] = 0.0f;
+    this->dfilter_.delay_1[index] = 0.0f;
+    this->dfilter_.delay_2[index] = 0.0f;
+    this->pid_.i_[index] = 0.0f;
+    this->pid_.last_k_fb[index] = 0.0f;
+    this->pid_.last_out[index] = 0.0f;
+  }
+
+ private:
+  static constexpr float SIGMA = 0.000001f;
+
+  /* N路二阶巴特沃斯低通滤波器 */
+  struct FilterBank {
+    float a1[N];
+    float a2[N];
+    float b0[N];
+    float b1[N];
+    float b2[N];
+    float delay_1[N];
+    float delay_2[N];
+  };
+
+  static void InitFilter(FilterBank& bank, size_t index, float sample_freq,
+                         float cutoff_freq) {
+    /* 复用LowPassFilter2p的系数计算，保证两者行为一致 */
+    LowPassFilter2p filter(sample_freq, cutoff_freq);
+    bank.a1[index] = filter.a1_;
+    bank.a2[index] = filter.a2_;
+    bank.b0[index] = filter.b0_;
+    bank.b1[index] = filter.b1_;
+    bank.b2[index] = filter.b2_;
+  }
+
+  static void ApplyFilter(FilterBank& bank, const float* in, float* out) {
+    for (size_t i = 0; i < N; i++) {
+      float delay_0 =
+          in[i] - bank.delay_1[i] * bank.a1[i] - bank.delay_2[i] * bank.a2[i];
+
+      delay_0 = isinf(delay_0) ? in[i] : delay_0;
+
+      out[i] = delay_0 * bank.b0[i] + bank.delay_1[i] * bank.b1[i] +
+               bank.delay_2[i] * bank.b2[i];
+
+      bank.delay_2[i] = bank.delay_1[i];
+      bank.delay_1[i] = delay_0;
+    }
+  }
+
+  struct {
+    float k[N];
+    float p[N];
+    float i[N];
+    float d[N];
+    float i_limit[N];
+    float out_limit[N];
+    float dt_min[N];
+    bool cycle[N];
+
+    float i_[N];        /* 积分 */
+    float last_k_fb[N]; /* 上次反馈值 */
+    float last_out[N];  /* 上次输出 */
+  } pid_;
+
+  FilterBank dfilter_;
+  FilterBank in_;
+  FilterBank out_;
 };
 }  // namespace Component
@@ -0,0 +1,71 @@
+/*
+  级联二阶IIR滤波器组（Direct Form II Transposed）。
+*/
+
+#include "comp_biquad.hpp"
+
+using namespace Component;
+
+Biquad::Coeff Biquad::Bypass() { return {1.0f, 0.0f, 0.0f, 0.0f, 0.0f}; }
+
+Biquad::Coeff Biquad::LowPass(float sample_freq, float cutoff_freq) {
+  if (cutoff_freq <= 0.0f) {
+    /* no filtering */
+    return Bypass();
+  }
+
+  const float FR = sample_freq / cutoff_freq;
+  const float OHM = tanf(M_PI / FR);
+  const float C = 1.0f + 2.0f * cosf(M_PI / 4.0f) * OHM + OHM * OHM;
+
+  Coeff coeff;
+  coeff.b0 = OHM * OHM / C;
+  coeff.b1 = 2.0f * coeff.b0;
+  coeff.b2 = coeff.b0;
+  coeff.a1 = 2.0f * (OHM * OHM - 1.0f) / C;
+  coeff.a2 = (1.0f - 2.0f * cosf(M_PI / 4.0f) * OHM + OHM * OHM) / C;
+
+  return coeff;
+}
+
+Biquad::Coeff Biquad::HighPass(float sample_freq, float cutoff_freq) {
+  if (cutoff_freq <= 0.0f) {
+    return Bypass();
+  }
+
+  const float FR = sample_freq / cutoff_freq;
+  const float OHM = tanf(M_PI / FR);
+  const float C = 1.0f + 2.0f * cosf(M_PI / 4.0f) * OHM + OHM * OHM;
+
+  Coeff coeff;
+  coeff.b0 = 1.0f / C;
+  coeff.b1 = -2.0f * coeff.b0;
+  coeff.b2 = coeff.b0;
+  coeff.a1 = 2.0f * (OHM * OHM - 1.0f) / C;
+  coeff.a2 = (1.0f - 2.0f * cosf(M_PI / 4.0f) * OHM + OHM * OHM) / C;
+
+  return coeff;
+}
+
+Biquad::Coeff Biquad::Notch(float sample_freq, float center_freq,
+                            float bandwidth) {
+  if (center_freq <= 0.0f || bandwidth <= 0.0f ||
+      center_freq >= sample_freq / 2.0f) {
+    return Bypass();
+  }
+
+  /* RBJ Audio EQ Cookbook */
+  const float OMEGA = M_2PI * center_freq / sample_freq;
+  const float ALPHA = sinf(OMEGA) * bandwidth / (2.0f * center_freq);
+  const float COS_OMEGA = cosf(OMEGA);
+  const float A0 = 1.0f + ALPHA;
+
+  Coeff coeff;
+  coeff.b0 = 1.0f / A0;
+  coeff.b1 = -2.0f * COS_OMEGA / A0;
+  coeff.b2 = coeff.b0;
+  coeff.a1 = coeff.b1;
+  coeff.a2 = (1.0f - ALPHA) / A0;
+
+  return coeff;
+}
@@ -0,0 +1,270 @@
+/*
+  级联二阶IIR滤波器组（Direct Form II Transposed）。
+  Cortex-M上使用CMSIS-DSP，Linux上使用SSE/NEON按通道并行计算。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+#include "comp_filter.hpp"
+
+#ifndef COMP_USE_CMSIS_DSP
+#define COMP_USE_CMSIS_DSP (0)
+#endif
+
+/* 置1后PID微分项和执行器输入输出滤波器改用BiquadCascade实现 */
+#ifndef COMP_FILTER_USE_BIQUAD
+#define COMP_FILTER_USE_BIQUAD (0)
+#endif
+
+#if COMP_USE_CMSIS_DSP
+#include "arm_math.h"
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#define COMP_BIQUAD_SIMD_WIDTH (4)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define COMP_BIQUAD_SIMD_WIDTH (4)
+#endif
+
+namespace Component {
+class Biquad {
+ public:
+  /* y = b0*x + b1*x[-1] + b2*x[-2] - a1*y[-1] - a2*y[-2] */
+  typedef struct {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+  } Coeff;
+
+  /* 直通 */
+  static Coeff Bypass();
+
+  /* 二阶巴特沃斯低通，与LowPassFilter2p系数一致 */
+  static Coeff LowPass(float sample_freq, float cutoff_freq);
+
+  /* 二阶巴特沃斯高通 */
+  static Coeff HighPass(float sample_freq, float cutoff_freq);
+
+  /* 陷波，bandwidth为-3dB带宽 */
+  static Coeff Notch(float sample_freq, float center_freq, float bandwidth);
+};
+
+template <size_t Stages, size_t Channels = 1>
+class BiquadCascade {
+ public:
+  BiquadCascade() {
+    for (size_t i = 0; i < Stages; i++) {
+      this->SetStage(i, Biquad::Bypass());
+    }
+
+#if COMP_USE_CMSIS_DSP
+    for (size_t ch = 0; ch < Channels; ch++) {
+      arm_biquad_cascade_df2T_init_f32(&this->instance_[ch], Stages,
+                                       this->coeff_, this->state_[ch]);
+    }
+#endif
+
+    this->Reset(0.0f);
+  }
+
+  /* 设置单级系数，不影响滤波器状态 */
+  void SetStage(size_t stage, const Biquad::Coeff& coeff) {
+    XB_ASSERT(stage < Stages);
+    float* c = &this->coeff_[stage * 5];
+    c[0] = coeff.b0;
+    c[1] = coeff.b1;
+    c[2] = coeff.b2;
+    /* 系数按CMSIS-DSP约定存储，反馈项取负 */
+    c[3] = -coeff.a1;
+    c[4] = -coeff.a2;
+  }
+
+  /* 每个通道输入一个采样，输出对应通道的滤波结果 */
+  void Apply(const float* in, float* out) {
+#if COMP_USE_CMSIS_DSP
+    for (size_t ch = 0; ch < Channels; ch++) {
+      arm_biquad_cascade_df2T_f32(&this->instance_[ch], &in[ch], &out[ch], 1);
+    }
+#else
+    size_t start = 0;
+#ifdef COMP_BIQUAD_SIMD_WIDTH
+    start = Channels - Channels % COMP_BIQUAD_SIMD_WIDTH;
+    this->ApplySIMD(in, out, start);
+#endif
+    this->ApplyScalar(in, out, start);
+#endif
+
+    /* 不让无效值在滤波器中传递 */
+    for (size_t ch = 0; ch < Channels; ch++) {
+      if (!isfinite(out[ch])) {
+        this->Reset(ch, in[ch]);
+        out[ch] = in[ch];
+      }
+    }
+  }
+
+  /* 单通道快捷接口 */
+  float Apply(float sample) {
+    static_assert(Channels == 1, "Use Apply(in, out) for multi-channel.");
+    float out = 0.0f;
+    this->Apply(&sample, &out);
+    return out;
+  }
+
+  /* 对某一通道连续处理len个采样 */
+  void ApplyBlock(size_t channel, const float* in, float* out, size_t len) {
+    XB_ASSERT(channel < Channels);
+#if COMP_USE_CMSIS_DSP
+    arm_biquad_cascade_df2T_f32(&this->instance_[channel], in, out, len);
+#else
+    for (size_t n = 0; n < len; n++) {
+      float x = in[n];
+      for (size_t s = 0; s < Stages; s++) {
+        const float* c = &this->coeff_[s * 5];
+        float& s1 = this->State1(s, channel);
+        float& s2 = this->State2(s, channel);
+        const float Y = c[0] * x + s1;
+        s1 = c[1] * x + c[3] * Y + s2;
+        s2 = c[2] * x + c[4] * Y;
+        x = Y;
+      }
+      out[n] = x;
+    }
+#endif
+  }
+
+  /* 将通道状态设置为输入恒为sample时的稳态 */
+  void Reset(size_t channel, float sample) {
+    XB_ASSERT(channel < Channels);
+    float x = sample;
+    for (size_t s = 0; s < Stages; s++) {
+      const float* c = &this->coeff_[s * 5];
+      const float DEN = 1.0f - c[3] - c[4];
+      float y = (c[0] + c[1] + c[2]) / DEN * x;
+      if (!isfinite(y)) {
+        y = x;
+      }
+      this->State1(s, channel) = y - c[0] * x;
+      this->State2(s, channel) = c[2] * x + c[4] * y;
+      x = y;
+    }
+  }
+
+  void Reset(float sample) {
+    for (size_t ch = 0; ch < Channels; ch++) {
+      this->Reset(ch, sample);
+    }
+  }
+
+ private:
+#if COMP_USE_CMSIS_DSP
+  float& State1(size_t stage, size_t channel) {
+    return this->state_[channel][stage * 2];
+  }
+
+  float& State2(size_t stage, size_t channel) {
+    return this->state_[channel][stage * 2 + 1];
+  }
+
+  arm_biquad_cascade_df2T_instance_f32 instance_[Channels];
+  float state_[Channels][Stages * 2];
+#else
+  float& State1(size_t stage, size_t channel) {
+    return this->s1_[stage][channel];
+  }
+
+  float& State2(size_t stage, size_t channel) {
+    return this->s2_[stage][channel];
+  }
+
+  void ApplyScalar(const float* in, float* out, size_t start) {
+    for (size_t ch = start; ch < Channels; ch++) {
+      out[ch] = in[ch];
+    }
+
+    for (size_t s = 0; s < Stages; s++) {
+      const float* c = &this->coeff_[s * 5];
+      for (size_t ch = start; ch < Channels; ch++) {
+        const float X = out[ch];
+        const float Y = c[0] * X + this->s1_[s][ch];
+        this->s1_[s][ch] = c[1] * X + c[3] * Y + this->s2_[s][ch];
+        this->s2_[s][ch] = c[2] * X + c[4] * Y;
+        out[ch] = Y;
+      }
+    }
+  }
+
+#ifdef COMP_BIQUAD_SIMD_WIDTH
+  void ApplySIMD(const float* in, float* out, size_t end) {
+    for (size_t ch = 0; ch < end; ch += COMP_BIQUAD_SIMD_WIDTH) {
+#if defined(__SSE__)
+      __m128 x = _mm_loadu_ps(&in[ch]);
+      for (size_t s = 0; s < Stages; s++) {
+        const float* c = &this->coeff_[s * 5];
+        __m128 s1 = _mm_loadu_ps(&this->s1_[s][ch]);
+        __m128 s2 = _mm_loadu_ps(&this->s2_[s][ch]);
+        __m128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(c[0]), x), s1);
+        s1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(c[1]), x),
+                                   _mm_mul_ps(_mm_set1_ps(c[3]), y)),
+                        s2);
+        s2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(c[2]), x),
+                        _mm_mul_ps(_mm_set1_ps(c[4]), y));
+        _mm_storeu_ps(&this->s1_[s][ch], s1);
+        _mm_storeu_ps(&this->s2_[s][ch], s2);
+        x = y;
+      }
+      _mm_storeu_ps(&out[ch], x);
+#elif defined(__ARM_NEON)
+      float32x4_t x = vld1q_f32(&in[ch]);
+      for (size_t s = 0; s < Stages; s++) {
+        const float* c = &this->coeff_[s * 5];
+        float32x4_t s1 = vld1q_f32(&this->s1_[s][ch]);
+        float32x4_t s2 = vld1q_f32(&this->s2_[s][ch]);
+        float32x4_t y = vmlaq_n_f32(s1, x, c[0]);
+        s1 = vmlaq_n_f32(vmlaq_n_f32(s2, x, c[1]), y, c[3]);
+        s2 = vmlaq_n_f32(vmulq_n_f32(x, c[2]), y, c[4]);
+        vst1q_f32(&this->s1_[s][ch], s1);
+        vst1q_f32(&this->s2_[s][ch], s2);
+        x = y;
+      }
+      vst1q_f32(&out[ch], x);
+#endif
+    }
+  }
+#endif
+
+  float s1_[Stages][Channels];
+  float s2_[Stages][Channels];
+#endif
+
+  float coeff_[Stages * 5];
+};
+
+/* 与LowPassFilter2p接口一致的二阶低通滤波器 */
+class BiquadLowPassFilter {
+ public:
+  BiquadLowPassFilter(float sample_freq, float cutoff_freq) {
+    this->filter_.SetStage(0, Biquad::LowPass(sample_freq, cutoff_freq));
+  }
+
+  float Apply(float sample) { return this->filter_.Apply(sample); }
+
+  float Reset(float sample) {
+    this->filter_.Reset(sample);
+    return this->filter_.Apply(sample);
+  }
+
+ private:
+  BiquadCascade<1, 1> filter_;
+};
+
+#if COMP_FILTER_USE_BIQUAD
+typedef BiquadLowPassFilter ControlFilter;
+#else
+typedef LowPassFilter2p ControlFilter;
+#endif
+}  // namespace Component
@@ -0,0 +1,167 @@
+/*
+  双向时间戳时钟同步。
+*/
+
+#include "comp_clock_sync.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Component;
+
+/* 往返时间超过窗口最小值加上此门限的样本受排队影响，不采用 */
+#define CLOCK_SYNC_RTT_GATE_MIN (100)
+/* 残差超过此值认为远端时钟跳变，直接重新对齐 */
+#define CLOCK_SYNC_STEP_THRESHOLD (20000)
+#define CLOCK_SYNC_MAX_SKEW (500e-6f)
+#define CLOCK_SYNC_KP (0.05f)
+/* 频率误差在较长的间隔上估计，单个样本的噪声远大于间隔内的漂移 */
+#define CLOCK_SYNC_SKEW_INTERVAL (1000000)
+#define CLOCK_SYNC_SKEW_ALPHA (0.25f)
+#define CLOCK_SYNC_JITTER_ALPHA (0.05f)
+
+ClockSync::ClockSync() { this->Reset(); }
+
+void ClockSync::Reset() {
+  this->synced_ = false;
+  this->offset_ = 0;
+  this->ref_time_ = 0;
+  this->anchor_offset_ = 0;
+  this->anchor_time_ = 0;
+  this->skew_ = 0.0f;
+  this->jitter_ = 0.0f;
+  this->err_square_ = 0.0f;
+  this->last_error_ = 0;
+  this->rtt_index_ = 0;
+  this->last_rtt_ = 0;
+  this->sample_count_ = 0;
+  this->reject_count_ = 0;
+  this->step_count_ = 0;
+
+  for (uint32_t i = 0; i < WINDOW; i++) {
+    this->rtt_[i] = UINT32_MAX;
+  }
+}
+
+bool ClockSync::Update(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4) {
+  const int64_t RTT = static_cast<int64_t>(t4 - t1) -
+                      static_cast<int64_t>(t3 - t2);
+
+  if (RTT < 0 || RTT > UINT32_MAX) {
+    this->reject_count_++;
+    return false;
+  }
+
+  this->last_rtt_ = static_cast<uint32_t>(RTT);
+  this->rtt_[this->rtt_index_++ % WINDOW] = this->last_rtt_;
+
+  uint32_t min_rtt = UINT32_MAX;
+  for (uint32_t i = 0; i < WINDOW; i++) {
+    if (this->rtt_[i] < min_rtt) {
+      min_rtt = this->rtt_[i];
+    }
+  }
+
+  uint32_t gate = min_rtt / 2;
+  if (gate < CLOCK_SYNC_RTT_GATE_MIN) {
+    gate = CLOCK_SYNC_RTT_GATE_MIN;
+  }
+
+  if (this->last_rtt_ > min_rtt + gate) {
+    this->reject_count_++;
+    return false;
+  }
+
+  /* 假设上下行延迟对称 */
+  const int64_t THETA =
+      (static_cast<int64_t>(t2 - t1) + static_cast<int64_t>(t3 - t4)) / 2;
+
+  this->sample_count_++;
+
+  if (!this->synced_) {
+    this->synced_ = true;
+    this->offset_ = THETA;
+    this->ref_time_ = t4;
+    this->anchor_offset_ = THETA;
+    this->anchor_time_ = t4;
+    return true;
+  }
+
+  const int64_t PREDICT = this->Offset(t4);
+  const int64_t ERROR = THETA - PREDICT;
+
+  if (llabs(ERROR) > CLOCK_SYNC_STEP_THRESHOLD) {
+    this->offset_ = THETA;
+    this->ref_time_ = t4;
+    this->anchor_offset_ = THETA;
+    this->anchor_time_ = t4;
+    this->skew_ = 0.0f;
+    this->step_count_++;
+    return true;
+  }
+
+  const float ERR = static_cast<float>(ERROR);
+
+  this->offset_ = PREDICT + static_cast<int64_t>(CLOCK_SYNC_KP * ERR);
+  this->ref_time_ = t4;
+
+  const uint64_t SPAN = t4 - this->anchor_time_;
+  if (SPAN >= CLOCK_SYNC_SKEW_INTERVAL) {
+    const float SKEW = static_cast<float>(this->offset_ - this->anchor_offset_) /
+                       static_cast<float>(SPAN);
+
+    this->skew_ += CLOCK_SYNC_SKEW_ALPHA * (SKEW - this->skew_);
+    if (this->skew_ > CLOCK_SYNC_MAX_SKEW) {
+      this->skew_ = CLOCK_SYNC_MAX_SKEW;
+    } else if (this->skew_ < -CLOCK_SYNC_MAX_SKEW) {
+      this->skew_ = -CLOCK_SYNC_MAX_SKEW;
+    }
+
+    this->anchor_offset_ = this->offset_;
+    this->anchor_time_ = t4;
+  }
+
+  this->last_error_ = ERROR;
+  this->err_square_ += CLOCK_SYNC_JITTER_ALPHA * (ERR * ERR - this->err_square_);
+  this->jitter_ = sqrtf(this->err_square_);
+
+  return true;
+}
+
+int64_t ClockSync::Offset(uint64_t local_time) {
+  const float DT = static_cast<float>(
+      static_cast<int64_t>(local_time - this->ref_time_));
+  return this->offset_ + static_cast<int64_t>(this->skew_ * DT);
+}
+
+uint64_t ClockSync::ToRemote(uint64_t local_time) {
+  return local_time + this->Offset(local_time);
+}
+
+uint64_t ClockSync::ToLocal(uint64_t remote_time) {
+  /* 频率误差很小，用远端时间近似计算偏差 */
+  return remote_time - this->Offset(remote_time - this->offset_);
+}
+
+void ClockSync::PrintInfo() {
+  uint32_t min_rtt = UINT32_MAX;
+  for (uint32_t i = 0; i < WINDOW; i++) {
+    if (this->rtt_[i] < min_rtt) {
+      min_rtt = this->rtt_[i];
+    }
+  }
+
+  printf("synced:%d offset:%lld us skew:%.2f ppm\r\n", this->synced_,
+         static_cast<long long>(this->offset_),
+         static_cast<double>(this->skew_ * 1e6f));
+  printf("rtt:%lu us min:%lu us jitter:%.1f us error:%lld us\r\n",
+         static_cast<unsigned long>(this->last_rtt_),
+         static_cast<unsigned long>(min_rtt == UINT32_MAX ? 0 : min_rtt),
+         static_cast<double>(this->jitter_),
+         static_cast<long long>(this->last_error_));
+  printf("sample:%lu reject:%lu step:%lu\r\n",
+         static_cast<unsigned long>(this->sample_count_),
+         static_cast<unsigned long>(this->reject_count_),
+         static_cast<unsigned long>(this->step_count_));
+}
@@ -0,0 +1,55 @@
+/*
+  双向时间戳时钟同步。
+  每次交换得到本地发送t1、远端接收t2、远端发送t3与本地接收t4，
+  只采用往返时间接近窗口内最小值的样本，按比例修正偏差，
+  并在较长的间隔上估计两端时钟的频率误差。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+namespace Component {
+class ClockSync {
+ public:
+  static constexpr uint32_t WINDOW = 8;
+
+  ClockSync();
+
+  /* 时间单位均为us，返回样本是否被采用 */
+  bool Update(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+  bool Synced() { return this->synced_; }
+
+  /* local_time时刻远端时钟与本地时钟的差值 */
+  int64_t Offset(uint64_t local_time);
+
+  uint64_t ToRemote(uint64_t local_time);
+
+  uint64_t ToLocal(uint64_t remote_time);
+
+  void Reset();
+
+  void PrintInfo();
+
+ private:
+  bool synced_;
+
+  int64_t offset_;     /* ref_time_时刻的偏差 */
+  uint64_t ref_time_;  /* 上次采用样本的本地时间 */
+  int64_t anchor_offset_; /* 估计频率误差的起点 */
+  uint64_t anchor_time_;
+  float skew_;         /* 远端相对本地的频率误差 */
+  float jitter_;       /* 偏差残差的均方根 */
+  float err_square_;   /* 残差平方的滑动平均 */
+  int64_t last_error_; /* 上次采用样本的残差 */
+
+  uint32_t rtt_[WINDOW];
+  uint32_t rtt_index_;
+  uint32_t last_rtt_;
+
+  uint32_t sample_count_;
+  uint32_t reject_count_;
+  uint32_t step_count_;
+};
+}  // namespace Component
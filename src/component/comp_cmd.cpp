@@ -13,6 +13,10 @@ CMD::CMD(Mode mode)
       ext_data_tp_("cmd_ext") {
   CMD::self_ = this;
 
+  TopicRegistry<TopicHash("cmd_chassis")>::Register(this->chassis_data_tp_);
+  TopicRegistry<TopicHash("cmd_gimbal")>::Register(this->gimbal_data_tp_);
+  TopicRegistry<TopicHash("cmd_ext")>::Register(this->ext_data_tp_);
+
   auto op_ctrl_callback = [](Data& data, CMD* cmd) {
     XB_ASSERT(data.ctrl_source < CTRL_SOURCE_NUM);
     memcpy(&(cmd->data_[data.ctrl_source]), &data, sizeof(Data));
@@ -3,6 +3,8 @@
 #include <component.hpp>
 #include <vector>
 
+#include "comp_topic.hpp"
+
 namespace Component {
 class CMD {
  public:
@@ -83,8 +85,9 @@ class CMD {
     std::vector<Component::CMD::EventMapItem>::const_iterator it;
 
     for (it = map.begin(); it != map.end(); it++) {
-      EventCallbackBlock* block = static_cast<EventCallbackBlock*>(
-          System::Memory::Malloc(sizeof(EventCallbackBlock)));
+      EventCallbackBlock* block =
+          static_cast<EventCallbackBlock*>(System::Memory::MallocStatic(
+              sizeof(EventCallbackBlock), System::Memory::STATIC_CALLBACK));
 
       block->arg = arg;
       block->callback = callback;
@@ -123,3 +126,7 @@ class CMD {
 };
 
 }  // namespace Component
+
+COMP_TOPIC_DECLARE("cmd_chassis", Component::CMD::ChassisCMD);
+COMP_TOPIC_DECLARE("cmd_gimbal", Component::CMD::GimbalCMD);
+COMP_TOPIC_DECLARE("cmd_ext", Component::CMD::ExtCMD);
@@ -0,0 +1,67 @@
+#include "comp_deferred.hpp"
+
+using namespace Component;
+
+Deferred* Deferred::self_;
+Deferred::QueueBase* Deferred::list_;
+
+Deferred::QueueBase::QueueBase(const char* name) {
+  strncpy(this->name_, name, sizeof(this->name_) - 1);
+  this->name_[sizeof(this->name_) - 1] = '\0';
+
+  Deferred::Add(this);
+}
+
+Deferred::Deferred()
+    : ready_(0), cmd_(this, Command, "deferred", System::Term::DevDir()) {
+  auto dispatch_thread = [](Deferred* deferred) {
+    while (1) {
+      deferred->ready_.Wait(UINT32_MAX);
+
+      for (QueueBase* item = list_; item != nullptr; item = item->next_) {
+        item->Drain();
+      }
+    }
+  };
+
+  this->thread_.Create(dispatch_thread, this, "deferred_dispatch",
+                       COMP_DEFERRED_TASK_STACK_DEPTH,
+                       System::Thread::REALTIME);
+}
+
+void Deferred::Add(QueueBase* queue) {
+  queue->next_ = list_;
+  list_ = queue;
+
+  /* 第一个队列创建时启动分发线程，此时终端已经初始化 */
+  if (self_ == nullptr) {
+    self_ = new Deferred();
+  }
+}
+
+int Deferred::Command(Deferred* deferred, int argc, char** argv) {
+  XB_UNUSED(deferred);
+
+  if (argc == 1) {
+    printf("%-20s %8s %6s %6s %10s %10s\r\n", "name", "push", "drop", "depth",
+           "isr(us)", "dispatch");
+    for (QueueBase* item = list_; item != nullptr; item = item->next_) {
+      printf("%-20s %8lu %6lu %6lu %10lu %10lu\r\n", item->name_,
+             static_cast<unsigned long>(item->push_count_),
+             static_cast<unsigned long>(item->drop_count_),
+             static_cast<unsigned long>(item->max_depth_),
+             static_cast<unsigned long>(item->isr_max_us_),
+             static_cast<unsigned long>(item->dispatch_max_us_));
+    }
+  } else if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+    for (QueueBase* item = list_; item != nullptr; item = item->next_) {
+      item->max_depth_ = 0;
+      item->isr_max_us_ = 0;
+      item->dispatch_max_us_ = 0;
+    }
+  } else {
+    printf("[reset] 清除最大值统计\r\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*
+  中断到任务的延迟执行。
+  中断中只把数据写入无锁环形队列，由高优先级分发线程执行回调，缩短中断时间。
+*/
+
+#pragma once
+
+#include <atomic>
+#include <component.hpp>
+
+#include "bsp_time.h"
+
+#ifndef COMP_DEFERRED_TASK_STACK_DEPTH
+#define COMP_DEFERRED_TASK_STACK_DEPTH (512)
+#endif
+
+namespace Component {
+class Deferred {
+ public:
+  typedef enum {
+    RUN_IN_ISR,   /* 在中断中直接执行 */
+    RUN_DEFERRED, /* 交给分发线程执行 */
+  } Policy;
+
+  class QueueBase {
+   public:
+    QueueBase(const char* name);
+
+    /* 在分发线程中执行队列中的全部回调 */
+    virtual void Drain() = 0;
+
+    /* 记录一次中断处理耗时 */
+    void RecordIsr(uint64_t start) {
+      const uint32_t DURATION = static_cast<uint32_t>(bsp_time_get() - start);
+      if (DURATION > this->isr_max_us_) {
+        this->isr_max_us_ = DURATION;
+      }
+    }
+
+   protected:
+    void RecordPush(uint32_t depth) {
+      this->push_count_++;
+      if (depth > this->max_depth_) {
+        this->max_depth_ = depth;
+      }
+    }
+
+    char name_[24];
+    QueueBase* next_ = nullptr;
+
+    uint32_t push_count_ = 0;
+    uint32_t drop_count_ = 0;
+    uint32_t max_depth_ = 0;
+    uint32_t isr_max_us_ = 0;
+    uint32_t dispatch_max_us_ = 0;
+
+    friend class Deferred;
+  };
+
+  /* 不支持多线程时退回中断中执行 */
+  static Policy Resolve(Policy policy) {
+    return System::Thread::MULTITHREAD ? policy : RUN_IN_ISR;
+  }
+
+  /* 可在中断中调用 */
+  static void Notify() {
+    if (self_ != nullptr) {
+      self_->ready_.Post();
+    }
+  }
+
+  static int Command(Deferred* deferred, int argc, char** argv);
+
+ private:
+  Deferred();
+
+  static void Add(QueueBase* queue);
+
+  System::Thread thread_;
+  System::Semaphore ready_;
+  System::Term::Command<Deferred*> cmd_;
+
+  static Deferred* self_;
+  static QueueBase* list_;
+};
+
+/*
+  单生产者单消费者环形队列，只使用原子读写，不关中断。
+  同一队列只能由同一优先级的中断写入。
+*/
+template <typename Data, uint32_t Length>
+class DeferredQueue : public Deferred::QueueBase {
+ public:
+  static_assert((Length & (Length - 1)) == 0 && Length >= 2,
+                "Length must be a power of 2.");
+
+  typedef void (*Callback)(Data& data, void* arg);
+
+  DeferredQueue(const char* name, Callback fun, void* arg)
+      : QueueBase(name), fun_(fun), arg_(arg) {}
+
+  /* 在中断中调用，队列满时丢弃 */
+  bool Push(const Data& data) {
+    const uint32_t HEAD = this->head_.load(std::memory_order_relaxed);
+    const uint32_t TAIL = this->tail_.load(std::memory_order_acquire);
+
+    if (HEAD - TAIL >= Length) {
+      this->drop_count_++;
+      return false;
+    }
+
+    this->buffer_[HEAD & (Length - 1)] = data;
+    this->head_.store(HEAD + 1, std::memory_order_release);
+
+    this->RecordPush(HEAD + 1 - TAIL);
+    Deferred::Notify();
+
+    return true;
+  }
+
+  void Drain() override {
+    uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t HEAD = this->head_.load(std::memory_order_acquire);
+
+    if (tail == HEAD) {
+      return;
+    }
+
+    const uint64_t START = bsp_time_get();
+
+    while (tail != HEAD) {
+      Data data = this->buffer_[tail & (Length - 1)];
+      tail++;
+      this->tail_.store(tail, std::memory_order_release);
+      this->fun_(data, this->arg_);
+    }
+
+    const uint32_t DURATION = static_cast<uint32_t>(bsp_time_get() - START);
+    if (DURATION > this->dispatch_max_us_) {
+      this->dispatch_max_us_ = DURATION;
+    }
+  }
+
+ private:
+  Callback fun_;
+  void* arg_;
+
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  Data buffer_[Length];
+};
+}  // namespace Component
@@ -0,0 +1,37 @@
+/*
+  快速三角函数。
+*/
+
+#include "comp_fastmath.hpp"
+
+using namespace Component;
+
+namespace {
+/* 编译期用泰勒级数生成，表放在flash中 */
+constexpr double TableSin(double x) {
+  constexpr double PI = 3.14159265358979323846;
+  while (x > PI) {
+    x -= 2.0 * PI;
+  }
+
+  double term = x, sum = x;
+  for (int n = 1; n < 16; n++) {
+    term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr std::array<float, FastMath::TABLE_LEN> MakeSinTable() {
+  std::array<float, FastMath::TABLE_LEN> table{};
+  for (uint32_t i = 0; i < FastMath::TABLE_LEN; i++) {
+    const double X = 6.28318530717958647692 * static_cast<double>(i) /
+                     static_cast<double>(FastMath::TABLE_SIZE);
+    table[i] = static_cast<float>(TableSin(X));
+  }
+  return table;
+}
+}  // namespace
+
+const std::array<float, FastMath::TABLE_LEN> FastMath::SIN_TABLE =
+    MakeSinTable();
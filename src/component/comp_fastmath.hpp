@@ -0,0 +1,168 @@
+/*
+  快速三角函数。
+  查表线性插值与极小极大多项式两种实现，精度可配置。
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/* 0：查表插值与低阶atan，误差约2e-4；1：多项式，误差约5e-7 */
+#ifndef COMP_FAST_MATH_ACCURACY
+#define COMP_FAST_MATH_ACCURACY (1)
+#endif
+
+/* 查表点数，必须为4的倍数的2的幂 */
+#ifndef COMP_FAST_MATH_TABLE_SIZE
+#define COMP_FAST_MATH_TABLE_SIZE (256)
+#endif
+
+namespace Component {
+class FastMath {
+ public:
+  static constexpr uint32_t TABLE_SIZE = COMP_FAST_MATH_TABLE_SIZE;
+
+  static_assert((TABLE_SIZE & (TABLE_SIZE - 1)) == 0 && TABLE_SIZE >= 4,
+                "Table size must be a power of 2.");
+
+  /* 多出1/4周期用于直接查cos，多出1点用于插值 */
+  static constexpr uint32_t TABLE_LEN = TABLE_SIZE + TABLE_SIZE / 4 + 1;
+
+  static const std::array<float, TABLE_LEN> SIN_TABLE;
+
+  /* 查表线性插值 */
+  static void SinCosTable(float x, float* s, float* c) {
+    const float T = x * (TABLE_SIZE / TWO_PI);
+
+    /* 超出范围或非有限值时退回libm */
+    if (!(fabsf(T) < 8388608.0f)) {
+      *s = sinf(x);
+      *c = cosf(x);
+      return;
+    }
+
+    int32_t index = static_cast<int32_t>(T);
+    index -= T < static_cast<float>(index);
+    const float FRAC = T - static_cast<float>(index);
+    const uint32_t I = static_cast<uint32_t>(index) & (TABLE_SIZE - 1);
+    const uint32_t J = I + TABLE_SIZE / 4;
+
+    *s = SIN_TABLE[I] + (SIN_TABLE[I + 1] - SIN_TABLE[I]) * FRAC;
+    *c = SIN_TABLE[J] + (SIN_TABLE[J + 1] - SIN_TABLE[J]) * FRAC;
+  }
+
+  /* 按象限归约到[-PI/4, PI/4]后用极小极大多项式计算 */
+  static void SinCosPoly(float x, float* s, float* c) {
+    const float T = x * (1.0f / HALF_PI);
+
+    if (!(fabsf(T) < 8388608.0f)) {
+      *s = sinf(x);
+      *c = cosf(x);
+      return;
+    }
+
+    const int32_t Q = static_cast<int32_t>(T + (T >= 0.0f ? 0.5f : -0.5f));
+    const float R = (x - static_cast<float>(Q) * HALF_PI_HI) -
+                    static_cast<float>(Q) * HALF_PI_LO;
+    const float Z = R * R;
+
+    const float SIN_R =
+        R + R * Z * (-1.6666654611e-1f +
+                     Z * (8.3321608736e-3f + Z * -1.9515295891e-4f));
+    const float COS_R =
+        1.0f - 0.5f * Z +
+        Z * Z *
+            (4.166664568298827e-2f +
+             Z * (-1.388731625493765e-3f + Z * 2.443315711809948e-5f));
+
+    /* 按象限交换并取反，无分支 */
+    const uint32_t QUADRANT = static_cast<uint32_t>(Q);
+    const float SIN_ANS = (QUADRANT & 1) ? COS_R : SIN_R;
+    const float COS_ANS = (QUADRANT & 1) ? SIN_R : COS_R;
+    *s = (QUADRANT & 2) ? -SIN_ANS : SIN_ANS;
+    *c = ((QUADRANT + 1) & 2) ? -COS_ANS : COS_ANS;
+  }
+
+  /* 三阶多项式，误差约2e-4弧度 */
+  static float Atan2Fast(float y, float x) {
+    return Atan2Impl<false>(y, x);
+  }
+
+  /* 八阶多项式，误差约5e-7弧度 */
+  static float Atan2Poly(float y, float x) { return Atan2Impl<true>(y, x); }
+
+  static void SinCos(float x, float* s, float* c) {
+#if COMP_FAST_MATH_ACCURACY
+    SinCosPoly(x, s, c);
+#else
+    SinCosTable(x, s, c);
+#endif
+  }
+
+  static float Sin(float x) {
+    float s = 0.0f, c = 0.0f;
+    SinCos(x, &s, &c);
+    return s;
+  }
+
+  static float Cos(float x) {
+    float s = 0.0f, c = 0.0f;
+    SinCos(x, &s, &c);
+    return c;
+  }
+
+  static float Atan2(float y, float x) {
+#if COMP_FAST_MATH_ACCURACY
+    return Atan2Poly(y, x);
+#else
+    return Atan2Fast(y, x);
+#endif
+  }
+
+ private:
+  static constexpr float PI = 3.14159265358979323846f;
+  static constexpr float TWO_PI = 6.28318530717958647692f;
+  static constexpr float HALF_PI = 1.57079632679489661923f;
+  static constexpr float HALF_PI_HI = 1.5703125f;
+  static constexpr float HALF_PI_LO = 4.8382679489661923e-4f;
+
+  /* [0, 1]上的atan */
+  template <bool Precise>
+  static float Atan(float a) {
+    const float S = a * a;
+    if (Precise) {
+      /* Abramowitz & Stegun 4.4.49 */
+      return a *
+             (1.0f +
+              S * (-0.3333314528f +
+                   S * (0.1999355085f +
+                        S * (-0.1420889944f +
+                             S * (0.1065626393f +
+                                  S * (-0.0752896400f +
+                                       S * (0.0429096138f +
+                                            S * (-0.0161657367f +
+                                                 S * 0.0028662257f))))))));
+    }
+    return ((-0.0464964749f * S + 0.15931422f) * S - 0.327622764f) * S * a +
+           a;
+  }
+
+  template <bool Precise>
+  static float Atan2Impl(float y, float x) {
+    const float AX = fabsf(x), AY = fabsf(y);
+    const float MAX = AX > AY ? AX : AY;
+    const float MIN = AX > AY ? AY : AX;
+
+    if (!(MAX > 0.0f) || !std::isfinite(MAX)) {
+      return atan2f(y, x);
+    }
+
+    float ans = Atan<Precise>(MIN / MAX);
+    ans = AY > AX ? HALF_PI - ans : ans;
+    ans = x < 0.0f ? PI - ans : ans;
+    return std::signbit(y) ? -ans : ans;
+  }
+};
+}  // namespace Component
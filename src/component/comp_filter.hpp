@@ -7,6 +7,9 @@
 #include <component.hpp>
 
 namespace Component {
+template <size_t N>
+class ActuatorBank;
+
 /* 一阶数字低通滤波器 */
 class LowPassFilter {
  public:
@@ -31,6 +34,9 @@ class LowPassFilter2p {
   float Reset(float sample);
 
  private:
+  template <size_t N>
+  friend class ActuatorBank;
+
   float cutoff_freq_; /* 截止频率 */
 
   float a1_;
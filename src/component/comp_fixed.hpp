@@ -0,0 +1,443 @@
+/*
+  定点数类型与定点控制器。
+  用于无FPU的MCU（如STM32F103），避免软件浮点运算。
+*/
+
+#pragma once
+
+#include <component.hpp>
+#include <limits>
+#include <type_traits>
+
+#include "comp_pid.hpp"
+
+/* 由板级cmake在无FPU的MCU上置1 */
+#ifndef COMP_USE_FIXED_POINT
+#define COMP_USE_FIXED_POINT (0)
+#endif
+
+namespace Component {
+namespace Type {
+/* Q格式定点数，Raw为存储类型，FracBits为小数位数，运算结果饱和 */
+template <typename Raw, int FracBits>
+class Fixed {
+ public:
+  static_assert(std::is_signed<Raw>::value, "Raw must be signed.");
+  static_assert(FracBits > 0 && FracBits < static_cast<int>(sizeof(Raw) * 8),
+                "Invalid fraction bits.");
+
+  typedef Raw RawType;
+  typedef typename std::conditional<sizeof(Raw) <= 2, int32_t, int64_t>::type
+      WideType;
+
+  static constexpr int FRAC_BITS = FracBits;
+  static constexpr WideType ONE = static_cast<WideType>(1) << FracBits;
+
+  constexpr Fixed() : raw_(0) {}
+
+  constexpr Fixed(float value) : raw_(FromFloat(value)) {}
+
+  static constexpr Fixed FromRaw(Raw raw) {
+    Fixed ans;
+    ans.raw_ = raw;
+    return ans;
+  }
+
+  static constexpr Fixed Max() {
+    return FromRaw(std::numeric_limits<Raw>::max());
+  }
+
+  static constexpr Fixed Min() {
+    return FromRaw(std::numeric_limits<Raw>::min());
+  }
+
+  constexpr Raw GetRaw() const { return this->raw_; }
+
+  constexpr float ToFloat() const {
+    return static_cast<float>(this->raw_) * (1.0f / static_cast<float>(ONE));
+  }
+
+  static constexpr Raw Saturate(WideType value) {
+    return value > std::numeric_limits<Raw>::max()
+               ? std::numeric_limits<Raw>::max()
+           : value < std::numeric_limits<Raw>::min()
+               ? std::numeric_limits<Raw>::min()
+               : static_cast<Raw>(value);
+  }
+
+  Fixed operator+(const Fixed& value) const {
+    return FromRaw(Saturate(static_cast<WideType>(this->raw_) + value.raw_));
+  }
+
+  Fixed operator-(const Fixed& value) const {
+    return FromRaw(Saturate(static_cast<WideType>(this->raw_) - value.raw_));
+  }
+
+  Fixed operator-() const {
+    return FromRaw(Saturate(-static_cast<WideType>(this->raw_)));
+  }
+
+  /* 与任意Q格式相乘，结果保持本类型 */
+  template <typename R, int F>
+  Fixed operator*(const Fixed<R, F>& value) const {
+    const int64_t ANS = static_cast<int64_t>(this->raw_) * value.GetRaw();
+    return FromRaw(Saturate(static_cast<WideType>(
+        (ANS + (static_cast<int64_t>(1) << (F - 1))) >> F)));
+  }
+
+  Fixed operator/(const Fixed& value) const {
+    if (value.raw_ == 0) {
+      return this->raw_ >= 0 ? Max() : Min();
+    }
+    const int64_t ANS = (static_cast<int64_t>(this->raw_) << FracBits);
+    return FromRaw(Saturate(static_cast<WideType>(ANS / value.raw_)));
+  }
+
+  Fixed& operator+=(const Fixed& value) { return *this = *this + value; }
+
+  Fixed& operator-=(const Fixed& value) { return *this = *this - value; }
+
+  bool operator<(const Fixed& value) const { return this->raw_ < value.raw_; }
+
+  bool operator>(const Fixed& value) const { return this->raw_ > value.raw_; }
+
+  bool operator<=(const Fixed& value) const {
+    return this->raw_ <= value.raw_;
+  }
+
+  bool operator>=(const Fixed& value) const {
+    return this->raw_ >= value.raw_;
+  }
+
+  bool operator==(const Fixed& value) const {
+    return this->raw_ == value.raw_;
+  }
+
+  bool operator!=(const Fixed& value) const {
+    return this->raw_ != value.raw_;
+  }
+
+  Fixed Abs() const { return this->raw_ < 0 ? -*this : *this; }
+
+  /* 限制绝对值不超过limit */
+  Fixed AbsClamp(const Fixed& limit) const {
+    if (*this > limit) {
+      return limit;
+    }
+    if (*this < -limit) {
+      return -limit;
+    }
+    return *this;
+  }
+
+ private:
+  static constexpr Raw FromFloat(float value) {
+    /* 先在浮点域限幅，避免转换溢出 */
+    return value * static_cast<float>(ONE) >=
+                   static_cast<float>(std::numeric_limits<Raw>::max())
+               ? std::numeric_limits<Raw>::max()
+           : value * static_cast<float>(ONE) <=
+                   static_cast<float>(std::numeric_limits<Raw>::min())
+               ? std::numeric_limits<Raw>::min()
+               : static_cast<Raw>(value * static_cast<float>(ONE) +
+                                  (value >= 0.0f ? 0.5f : -0.5f));
+  }
+
+  Raw raw_;
+};
+
+typedef Fixed<int16_t, 15> Q15;  /* [-1, 1) */
+typedef Fixed<int32_t, 31> Q31;  /* [-1, 1) */
+typedef Fixed<int32_t, 16> Q16;  /* [-32768, 32768)，用于转速、角度等 */
+typedef Fixed<int32_t, 28> Q28;  /* [-8, 8)，用于滤波器系数 */
+
+/* 以整数表示圈数的角度，满量程为一圈，溢出即完成环绕 */
+template <typename Raw>
+class BinaryAngle {
+ public:
+  static_assert(std::is_unsigned<Raw>::value, "Raw must be unsigned.");
+
+  typedef typename std::make_signed<Raw>::type DiffType;
+
+  static constexpr float TURN =
+      static_cast<float>(std::numeric_limits<Raw>::max()) + 1.0f;
+  static constexpr float RAW2RAD = M_2PI / TURN;
+
+  constexpr BinaryAngle() : raw_(0) {}
+
+  BinaryAngle(float radian) : raw_(FromRadian(radian)) {}
+
+  static BinaryAngle FromRaw(Raw raw) {
+    BinaryAngle ans;
+    ans.raw_ = raw;
+    return ans;
+  }
+
+  Raw GetRaw() const { return this->raw_; }
+
+  /* [0, 2PI) */
+  float ToFloat() const { return static_cast<float>(this->raw_) * RAW2RAD; }
+
+  BinaryAngle operator+(const BinaryAngle& value) const {
+    return FromRaw(static_cast<Raw>(this->raw_ + value.raw_));
+  }
+
+  BinaryAngle& operator+=(const BinaryAngle& value) {
+    this->raw_ = static_cast<Raw>(this->raw_ + value.raw_);
+    return *this;
+  }
+
+  BinaryAngle& operator-=(const BinaryAngle& value) {
+    this->raw_ = static_cast<Raw>(this->raw_ - value.raw_);
+    return *this;
+  }
+
+  /* 最短路径差值，范围[-PI, PI) */
+  DiffType operator-(const BinaryAngle& value) const {
+    return static_cast<DiffType>(static_cast<Raw>(this->raw_ - value.raw_));
+  }
+
+  static float DiffToFloat(DiffType diff) {
+    return static_cast<float>(diff) * RAW2RAD;
+  }
+
+  /* 差值转为Q16弧度 */
+  static Q16 DiffToQ16(DiffType diff) {
+    /* diff * 2PI * 2^16 / 2^bits */
+    constexpr int64_t SCALE = static_cast<int64_t>(M_2PI * 65536.0f + 0.5f);
+    constexpr int SHIFT = sizeof(Raw) * 8;
+    return Q16::FromRaw(static_cast<int32_t>(
+        (static_cast<int64_t>(diff) * SCALE) >> SHIFT));
+  }
+
+  bool operator==(const BinaryAngle& value) const {
+    return this->raw_ == value.raw_;
+  }
+
+ private:
+  static Raw FromRadian(float radian) {
+    /* 去掉整圈后转为有符号整数再截断，负角度自然环绕 */
+    float turns = radian * (1.0f / M_2PI);
+    turns -= static_cast<float>(static_cast<int32_t>(turns));
+    return static_cast<Raw>(static_cast<int64_t>(turns * TURN));
+  }
+
+  Raw raw_;
+};
+
+typedef BinaryAngle<uint16_t> Angle16;
+typedef BinaryAngle<uint32_t> Angle32;
+}  // namespace Type
+
+/* 定点一阶低通滤波器 */
+template <typename T>
+class FixedLowPassFilter {
+ public:
+  FixedLowPassFilter(float cut_freq)
+      : k_(2.0f * M_2PI * cut_freq), last_out_() {}
+
+  T Apply(T sample, T dt) {
+    /* k = 2*2PI*fc*dt / (1 + 2*2PI*fc*dt) */
+    Type::Q16 k = this->k_ * dt;
+    k = k / (Type::Q16(1.0f) + k);
+    this->last_out_ = this->last_out_ + (sample - this->last_out_) * k;
+    return this->last_out_;
+  }
+
+  void Reset(T sample) { this->last_out_ = sample; }
+
+ private:
+  Type::Q16 k_;
+
+  T last_out_;
+};
+
+/* 定点二阶巴特沃斯低通滤波器，直接I型，系数为Q28 */
+template <typename T>
+class FixedLowPassFilter2p {
+ public:
+  FixedLowPassFilter2p(float sample_freq, float cutoff_freq) {
+    const Biquad::Coeff COEFF = Biquad::LowPass(sample_freq, cutoff_freq);
+    this->b0_ = COEFF.b0;
+    this->b1_ = COEFF.b1;
+    this->b2_ = COEFF.b2;
+    this->a1_ = COEFF.a1;
+    this->a2_ = COEFF.a2;
+  }
+
+  T Apply(T sample) {
+    /* 64位累加，仅在最后移位一次 */
+    int64_t acc = static_cast<int64_t>(this->b0_.GetRaw()) * sample.GetRaw();
+    acc += static_cast<int64_t>(this->b1_.GetRaw()) * this->x_[0].GetRaw();
+    acc += static_cast<int64_t>(this->b2_.GetRaw()) * this->x_[1].GetRaw();
+    acc -= static_cast<int64_t>(this->a1_.GetRaw()) * this->y_[0].GetRaw();
+    acc -= static_cast<int64_t>(this->a2_.GetRaw()) * this->y_[1].GetRaw();
+
+    const T OUTPUT = T::FromRaw(T::Saturate(static_cast<typename T::WideType>(
+        (acc + (static_cast<int64_t>(1) << (Type::Q28::FRAC_BITS - 1))) >>
+        Type::Q28::FRAC_BITS)));
+
+    this->x_[1] = this->x_[0];
+    this->x_[0] = sample;
+    this->y_[1] = this->y_[0];
+    this->y_[0] = OUTPUT;
+
+    return OUTPUT;
+  }
+
+  T Reset(T sample) {
+    this->x_[0] = this->x_[1] = sample;
+    this->y_[0] = this->y_[1] = sample;
+    return this->Apply(sample);
+  }
+
+ private:
+  Type::Q28 a1_, a2_, b0_, b1_, b2_;
+
+  T x_[2] = {};
+  T y_[2] = {};
+};
+
+/* 定点PID，算法与PID一致，参数沿用PID::Param */
+template <typename T>
+class FixedPID {
+ public:
+  FixedPID(PID::Param& param, float sample_freq)
+      : k_(param.k),
+        p_(param.p),
+        i_gain_(param.i),
+        d_(param.d),
+        i_limit_(param.i_limit),
+        out_limit_(param.out_limit),
+        dt_min_(1.0f / sample_freq),
+        cycle_(param.cycle),
+        dfilter_(sample_freq, param.d_cutoff_freq) {
+    this->Reset();
+  }
+
+  T Calculate(T sp, T fb, T dt) {
+    /* 计算误差值 */
+    T err = sp - fb;
+    if (this->cycle_) {
+      err = WrapPI(err);
+    }
+
+    /* 计算P项 */
+    const T K_ERR = err * this->k_;
+
+    /* 计算D项，通过fb计算避免sp突变 */
+    const T K_FB = fb * this->k_;
+    const T FILTERED_K_FB = this->dfilter_.Apply(K_FB);
+    const T D = (FILTERED_K_FB - this->last_.k_fb) /
+                (dt > this->dt_min_ ? dt : this->dt_min_);
+
+    this->last_.err = err;
+    this->last_.k_fb = FILTERED_K_FB;
+
+    return this->Output(K_ERR, D, dt);
+  }
+
+  T Calculate(T sp, T fb, T fb_dot, T dt) {
+    T err = sp - fb;
+    if (this->cycle_) {
+      err = WrapPI(err);
+    }
+
+    const T K_ERR = err * this->k_;
+
+    const T K_FB = fb * this->k_;
+    this->last_.err = err;
+    this->last_.k_fb = this->dfilter_.Apply(K_FB);
+
+    return this->Output(K_ERR, fb_dot, dt);
+  }
+
+  /* 浮点接口，便于与PID互换 */
+  float Calculate(float sp, float fb, float dt) {
+    return this->Calculate(T(sp), T(fb), T(dt)).ToFloat();
+  }
+
+  float Calculate(float sp, float fb, float fb_dot, float dt) {
+    return this->Calculate(T(sp), T(fb), T(fb_dot), T(dt)).ToFloat();
+  }
+
+  void SetK(float k) { this->k_ = k; }
+
+  void SetP(float p) { this->p_ = p; }
+
+  void SetI(float i) { this->i_gain_ = i; }
+
+  void SetD(float d) { this->d_ = d; }
+
+  void Reset() {
+    this->i_ = T();
+    this->last_.err = T();
+    this->last_.k_fb = T();
+    this->last_.out = T();
+    this->dfilter_.Reset(T());
+  }
+
+ private:
+  static T WrapPI(T err) {
+    constexpr T PI(M_PI), TWO_PI(M_2PI);
+    while (err >= PI) {
+      err -= TWO_PI;
+    }
+    while (err < -PI) {
+      err += TWO_PI;
+    }
+    return err;
+  }
+
+  T Output(T k_err, T d, T dt) {
+    /* 计算PD输出 */
+    T output = k_err * this->p_ - d * this->d_;
+
+    /* 计算I项 */
+    const T I = this->i_ + k_err * dt;
+    const T I_OUT = I * this->i_gain_;
+
+    if (this->i_gain_ > T()) {
+      /* 检查是否饱和 */
+      if ((output + I_OUT).Abs() <= this->out_limit_ &&
+          I.Abs() <= this->i_limit_) {
+        /* 未饱和，使用新积分 */
+        this->i_ = I;
+      }
+    }
+
+    /* 计算PID输出 */
+    output += I_OUT;
+
+    /* 限制输出 */
+    if (this->out_limit_ > T()) {
+      output = output.AbsClamp(this->out_limit_);
+    }
+    this->last_.out = output;
+
+    return output;
+  }
+
+  T k_, p_, i_gain_, d_, i_limit_, out_limit_;
+
+  T dt_min_;
+  bool cycle_;
+
+  T i_; /* 积分 */
+
+  struct {
+    T err;  /* 上次误差 */
+    T k_fb; /* 上次反馈值 */
+    T out;  /* 上次输出 */
+  } last_;
+
+  FixedLowPassFilter2p<T> dfilter_;
+};
+
+/* 按板级配置选择的PID实现，定点实现时输入与中间量需在Q16范围内 */
+#if COMP_USE_FIXED_POINT
+typedef FixedPID<Type::Q16> ControlPID;
+#else
+typedef PID ControlPID;
+#endif
+}  // namespace Component
@@ -0,0 +1,135 @@
+/*
+  发射机构热量估计。
+*/
+
+#include "comp_heat.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace Component;
+
+#define HEAT_ERROR_ALPHA (0.1f)
+
+HeatEstimator::HeatEstimator()
+    : limit_(0.0f), cooling_rate_(0.0f), heat_per_shot_(0.0f) {
+  this->Reset();
+}
+
+void HeatEstimator::Reset() {
+  this->heat_ = 0.0f;
+  this->shot_index_ = 0;
+
+  memset(this->shot_time_, 0, sizeof(this->shot_time_));
+  memset(this->shot_num_, 0, sizeof(this->shot_num_));
+
+  this->ResetStats();
+}
+
+void HeatEstimator::ResetStats() {
+  this->last_error_ = 0.0f;
+  this->error_rms_ = 0.0f;
+  this->err_square_ = 0.0f;
+  this->max_error_ = 0.0f;
+  this->shot_count_ = 0;
+  this->sample_count_ = 0;
+  this->over_count_ = 0;
+}
+
+void HeatEstimator::SetParam(float limit, float cooling_rate,
+                             float heat_per_shot) {
+  this->limit_ = limit;
+  this->cooling_rate_ = cooling_rate;
+  this->heat_per_shot_ = heat_per_shot;
+}
+
+void HeatEstimator::Shoot(uint32_t num, uint32_t now) {
+  if (num == 0) {
+    return;
+  }
+
+  this->heat_ += static_cast<float>(num) * this->heat_per_shot_;
+
+  const uint32_t INDEX = this->shot_index_++ % HISTORY;
+  this->shot_time_[INDEX] = now;
+  this->shot_num_[INDEX] = num;
+
+  this->shot_count_ += num;
+}
+
+void HeatEstimator::Update(float dt) {
+  this->heat_ -= this->cooling_rate_ * dt;
+  if (this->heat_ < 0.0f) {
+    this->heat_ = 0.0f;
+  }
+}
+
+void HeatEstimator::Reconcile(float ref_heat, uint32_t ref_time,
+                              uint32_t delay) {
+  /* 裁判系统还未计入的弹丸，包括收到数据之后发射的 */
+  uint32_t pending = 0;
+  for (uint32_t i = 0; i < HISTORY; i++) {
+    if (this->shot_num_[i] == 0) {
+      continue;
+    }
+    if (static_cast<int32_t>(ref_time - this->shot_time_[i]) <
+        static_cast<int32_t>(delay)) {
+      pending += this->shot_num_[i];
+    }
+  }
+
+  const float PENDING_HEAT = static_cast<float>(pending) * this->heat_per_shot_;
+
+  float predicted = this->heat_ - PENDING_HEAT;
+  if (predicted < 0.0f) {
+    predicted = 0.0f;
+  }
+
+  const float ERROR = predicted - ref_heat;
+
+  this->last_error_ = ERROR;
+  this->err_square_ =
+      this->sample_count_ == 0
+          ? ERROR * ERROR
+          : this->err_square_ +
+                HEAT_ERROR_ALPHA * (ERROR * ERROR - this->err_square_);
+  this->error_rms_ = sqrtf(this->err_square_);
+  if (-ERROR > this->max_error_) {
+    this->max_error_ = -ERROR;
+  }
+  if (ref_heat > this->limit_ && this->limit_ > 0.0f) {
+    this->over_count_++;
+  }
+  this->sample_count_++;
+
+  /* 以裁判系统为准，加上其尚未计入的部分 */
+  this->heat_ = ref_heat + PENDING_HEAT;
+}
+
+uint32_t HeatEstimator::Available(float margin) {
+  if (this->heat_per_shot_ <= 0.0f) {
+    return 0;
+  }
+
+  const float REMAIN = this->limit_ - margin - this->heat_;
+  if (REMAIN < this->heat_per_shot_) {
+    return 0;
+  }
+
+  return static_cast<uint32_t>(REMAIN / this->heat_per_shot_);
+}
+
+void HeatEstimator::PrintInfo() {
+  printf("heat:%.1f/%.1f cooling:%.1f per_shot:%.1f\r\n",
+         static_cast<double>(this->heat_), static_cast<double>(this->limit_),
+         static_cast<double>(this->cooling_rate_),
+         static_cast<double>(this->heat_per_shot_));
+  printf("error:%.1f rms:%.2f max_under:%.1f\r\n",
+         static_cast<double>(this->last_error_),
+         static_cast<double>(this->error_rms_),
+         static_cast<double>(this->max_error_));
+  printf("shot:%lu sample:%lu over:%lu\r\n",
+         static_cast<unsigned long>(this->shot_count_),
+         static_cast<unsigned long>(this->sample_count_),
+         static_cast<unsigned long>(this->over_count_));
+}
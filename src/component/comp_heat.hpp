@@ -0,0 +1,67 @@
+/*
+  发射机构热量估计。
+  在控制周期内按发射的弹丸与冷却速率积分热量，
+  裁判系统热量到达时扣除其滞后期间发射的弹丸后比较，用差值修正估计，
+  并统计预测误差，供发射逻辑在两帧之间使用。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+namespace Component {
+class HeatEstimator {
+ public:
+  /* 记录最近几次发射，用于扣除裁判系统尚未计入的热量 */
+  static constexpr uint32_t HISTORY = 16;
+
+  HeatEstimator();
+
+  /* 热量上限、每秒冷却值与每发热量，裁判系统数据更新时调用 */
+  void SetParam(float limit, float cooling_rate, float heat_per_shot);
+
+  /* now单位ms */
+  void Shoot(uint32_t num, uint32_t now);
+
+  /* 按冷却速率积分，dt单位s */
+  void Update(float dt);
+
+  /* ref_time为收到热量的时间，delay为弹丸计入热量的滞后，单位ms */
+  void Reconcile(float ref_heat, uint32_t ref_time, uint32_t delay);
+
+  float Heat() { return this->heat_; }
+
+  /* 保留margin热量后还能发射的弹丸数 */
+  uint32_t Available(float margin);
+
+  /* 上次比较时估计值减去裁判系统热量，正值表示估计偏保守 */
+  float Error() { return this->last_error_; }
+
+  float ErrorRms() { return this->error_rms_; }
+
+  void Reset();
+
+  void ResetStats();
+
+  void PrintInfo();
+
+ private:
+  float heat_;
+  float limit_;
+  float cooling_rate_;
+  float heat_per_shot_;
+
+  uint32_t shot_time_[HISTORY];
+  uint32_t shot_num_[HISTORY];
+  uint32_t shot_index_;
+
+  float last_error_;
+  float error_rms_;  /* 误差的均方根 */
+  float err_square_; /* 误差平方的滑动平均 */
+  float max_error_;  /* 低估的最大值，低估会导致超热量 */
+
+  uint32_t shot_count_;
+  uint32_t sample_count_;
+  uint32_t over_count_; /* 裁判系统热量超过上限的次数 */
+};
+}  // namespace Component
@@ -7,7 +7,7 @@
 
 #include <component.hpp>
 
-#include "comp_filter.hpp"
+#include "comp_biquad.hpp"
 
 namespace Component {
 class PID {
@@ -52,6 +52,6 @@ class PID {
     float out = 0.0f;  /* 上次输出 */
   } last_;
 
-  LowPassFilter2p dfilter_;
+  ControlFilter dfilter_;
 };
 }  // namespace Component
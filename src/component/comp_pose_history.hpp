@@ -0,0 +1,118 @@
+/*
+  带时间戳的姿态历史。
+  单个线程按时间顺序写入环形缓冲区，其他线程无锁地按时间戳插值查找，
+  用于补偿上位机处理图像期间云台姿态的变化。
+*/
+
+#pragma once
+
+#include <atomic>
+#include <component.hpp>
+
+#include "comp_type.hpp"
+
+namespace Component {
+template <uint32_t Num>
+class PoseHistory {
+ public:
+  static_assert(Num >= 2 && (Num & (Num - 1)) == 0,
+                "Num must be a power of 2.");
+
+  /* 角度均映射到[0, 2PI)，作差时使用CycleValue::WrapDiff */
+  typedef struct {
+    uint64_t time; /* us */
+    float yaw;
+    float pit;
+    float rol;
+  } Pose;
+
+  /* 只能在一个线程中调用，时间戳需递增 */
+  void Push(uint64_t time, Type::Eulr& eulr) {
+    const uint32_t HEAD = this->head_.load(std::memory_order_relaxed);
+    Slot& slot = this->slot_[HEAD & (Num - 1)];
+
+    /* 写入期间序号为奇数 */
+    const uint32_t SEQ = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(SEQ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.pose.time = time;
+    slot.pose.yaw = eulr.yaw.Value();
+    slot.pose.pit = eulr.pit.Value();
+    slot.pose.rol = eulr.rol.Value();
+
+    slot.seq.store(SEQ + 2, std::memory_order_release);
+    this->head_.store(HEAD + 1, std::memory_order_release);
+  }
+
+  /* 在time前后两个姿态间线性插值，time超出记录范围时返回false */
+  bool Lookup(uint64_t time, Pose& pose) {
+    const uint32_t HEAD = this->head_.load(std::memory_order_acquire);
+    const uint32_t NUM = HEAD < Num - 1 ? HEAD : Num - 1;
+
+    Pose newer;
+
+    /* 从最新的记录向前查找，最旧的槽位可能正在被覆盖 */
+    for (uint32_t i = 1; i <= NUM; i++) {
+      Pose older;
+      if (!this->Read(HEAD - i, older)) {
+        return false;
+      }
+
+      if (older.time <= time) {
+        if (i == 1) {
+          /* 比最新记录还新时不外推 */
+          pose = older;
+        } else {
+          Interpolate(older, newer, time, pose);
+        }
+        return true;
+      }
+
+      newer = older;
+    }
+
+    return false;
+  }
+
+  uint32_t Count() { return this->head_.load(std::memory_order_relaxed); }
+
+ private:
+  typedef struct {
+    std::atomic<uint32_t> seq;
+    Pose pose;
+  } Slot;
+
+  bool Read(uint32_t index, Pose& pose) {
+    Slot& slot = this->slot_[index & (Num - 1)];
+
+    const uint32_t SEQ = slot.seq.load(std::memory_order_acquire);
+    if (SEQ & 1) {
+      return false;
+    }
+
+    pose = slot.pose;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == SEQ;
+  }
+
+  static void Interpolate(const Pose& older, const Pose& newer, uint64_t time,
+                          Pose& pose) {
+    const float SPAN = static_cast<float>(newer.time - older.time);
+    const float RATIO =
+        SPAN > 0.0f ? static_cast<float>(time - older.time) / SPAN : 0.0f;
+
+    pose.time = time;
+    pose.yaw = Type::CycleValue::Wrap(
+        older.yaw + Type::CycleValue::WrapDiff(newer.yaw - older.yaw) * RATIO);
+    pose.pit = Type::CycleValue::Wrap(
+        older.pit + Type::CycleValue::WrapDiff(newer.pit - older.pit) * RATIO);
+    pose.rol = Type::CycleValue::Wrap(
+        older.rol + Type::CycleValue::WrapDiff(newer.rol - older.rol) * RATIO);
+  }
+
+  std::atomic<uint32_t> head_{0};
+  Slot slot_[Num] = {};
+};
+}  // namespace Component
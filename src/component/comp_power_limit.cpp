@@ -0,0 +1,288 @@
+/*
+  底盘功率限制。
+*/
+
+#include "comp_power_limit.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace Component;
+
+/* 回归量的缩放，使各项与系数都在相近的数量级，避免单精度下协方差病态 */
+static const float POWER_SCALE[] = {1e-3f, 1e-6f, 1.0f, 1.0f};
+
+/* 遗忘因子，约对应最近1/(1-λ)个样本 */
+#define POWER_FIT_FORGETTING (0.999f)
+#define POWER_FIT_P0 (10.0f)
+/* 协方差迹超过此值时不再放大，防止激励不足时发散 */
+#define POWER_FIT_TRACE_MAX (1e4f)
+/* 残差超过 k*rms 与下限中较大者认为测量异常，单位W */
+#define POWER_FIT_GATE_K (4.0f)
+#define POWER_FIT_GATE_FLOOR (10.0f)
+/* 前若干个样本无条件采用，初始系数偏差较大时也能收敛 */
+#define POWER_FIT_WARMUP (100)
+/* 连续拒绝过多时认为模型已变化，重新无条件采用 */
+#define POWER_FIT_REJECT_MAX (50)
+#define POWER_FIT_RMS_ALPHA (0.02f)
+/* 分配时转速误差的下限，单位RPM，保证误差为零的轮子仍能维持转速 */
+#define POWER_ALLOC_ERROR_FLOOR (100.0f)
+
+PowerLimiter::PowerLimiter(const Model &model) : init_(model) {
+  this->Reset();
+}
+
+void PowerLimiter::Reset() {
+  this->theta_[0] = this->init_.torque / POWER_SCALE[0];
+  this->theta_[1] = this->init_.speed_2 / POWER_SCALE[1];
+  this->theta_[2] = this->init_.out_2 / POWER_SCALE[2];
+  this->theta_[3] = this->init_.constant / POWER_SCALE[3];
+
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    for (size_t j = 0; j < PARAM_NUM; j++) {
+      this->p_[i][j] = (i == j) ? POWER_FIT_P0 : 0.0f;
+    }
+  }
+
+  this->last_residual_ = 0.0f;
+  this->residual_rms_ = 0.0f;
+  this->err_square_ = 0.0f;
+  this->fit_count_ = 0;
+  this->reject_count_ = 0;
+  this->reject_run_ = 0;
+  this->warmup_ = POWER_FIT_WARMUP;
+  this->limit_count_ = 0;
+}
+
+void PowerLimiter::Regressor(const float *out, const float *speed, size_t len,
+                             float *phi) {
+  float torque = 0.0f, speed_2 = 0.0f, out_2 = 0.0f;
+  for (size_t i = 0; i < len; i++) {
+    torque += fabsf(out[i] * speed[i]);
+    speed_2 += speed[i] * speed[i];
+    out_2 += out[i] * out[i];
+  }
+
+  phi[0] = torque * POWER_SCALE[0];
+  phi[1] = speed_2 * POWER_SCALE[1];
+  phi[2] = out_2 * POWER_SCALE[2];
+  phi[3] = POWER_SCALE[3];
+}
+
+float PowerLimiter::Estimate(const float *out, const float *speed,
+                             size_t len) {
+  float phi[PARAM_NUM];
+  Regressor(out, speed, len, phi);
+
+  float power = 0.0f;
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    power += phi[i] * this->theta_[i];
+  }
+  return power;
+}
+
+bool PowerLimiter::Fit(const float *out, const float *speed, size_t len,
+                       float power) {
+  float phi[PARAM_NUM];
+  Regressor(out, speed, len, phi);
+
+  float predicted = 0.0f;
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    predicted += phi[i] * this->theta_[i];
+  }
+
+  const float RESIDUAL = power - predicted;
+  this->last_residual_ = RESIDUAL;
+
+  if (!std::isfinite(power)) {
+    this->reject_count_++;
+    return false;
+  }
+
+  if (this->warmup_ > 0) {
+    this->warmup_--;
+  } else {
+    const float GATE = fmaxf(POWER_FIT_GATE_K * this->residual_rms_,
+                             POWER_FIT_GATE_FLOOR);
+    if (fabsf(RESIDUAL) > GATE) {
+      this->reject_count_++;
+      if (++this->reject_run_ >= POWER_FIT_REJECT_MAX) {
+        this->reject_run_ = 0;
+        this->warmup_ = POWER_FIT_WARMUP;
+      }
+      return false;
+    }
+  }
+  this->reject_run_ = 0;
+
+  /* K = P*phi / (λ + phi'*P*phi) */
+  float p_phi[PARAM_NUM];
+  float denom = POWER_FIT_FORGETTING;
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    p_phi[i] = 0.0f;
+    for (size_t j = 0; j < PARAM_NUM; j++) {
+      p_phi[i] += this->p_[i][j] * phi[j];
+    }
+    denom += phi[i] * p_phi[i];
+  }
+
+  float gain[PARAM_NUM];
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    gain[i] = p_phi[i] / denom;
+    /* 不在此处截断为非负，截断后的系数与协方差不再对应，收敛变慢 */
+    this->theta_[i] += gain[i] * RESIDUAL;
+  }
+
+  /* P = (P - K*phi'*P) / λ，P对称，phi'*P即p_phi' */
+  float trace = 0.0f;
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    trace += this->p_[i][i];
+  }
+  const float FORGET =
+      trace < POWER_FIT_TRACE_MAX ? 1.0f / POWER_FIT_FORGETTING : 1.0f;
+
+  for (size_t i = 0; i < PARAM_NUM; i++) {
+    for (size_t j = i; j < PARAM_NUM; j++) {
+      const float VALUE = (this->p_[i][j] - gain[i] * p_phi[j]) * FORGET;
+      this->p_[i][j] = VALUE;
+      this->p_[j][i] = VALUE;
+    }
+  }
+
+  this->err_square_ += POWER_FIT_RMS_ALPHA * (RESIDUAL * RESIDUAL -
+                                             this->err_square_);
+  this->residual_rms_ = sqrtf(this->err_square_);
+  this->fit_count_++;
+
+  return true;
+}
+
+bool PowerLimiter::Allocate(float power_limit, float *out, const float *speed,
+                            const float *error, size_t len) {
+  XB_ASSERT(len <= MAX_MOTOR_NUM);
+
+  const Model MODEL = this->GetModel();
+
+  /* 与输出无关的部分 */
+  float fixed = MODEL.constant;
+  float demand[MAX_MOTOR_NUM];
+  float total = 0.0f;
+  for (size_t i = 0; i < len; i++) {
+    fixed += MODEL.speed_2 * speed[i] * speed[i];
+    demand[i] = MODEL.torque * fabsf(out[i] * speed[i]) +
+                MODEL.out_2 * out[i] * out[i];
+    total += demand[i];
+  }
+
+  if (fixed + total <= power_limit) {
+    return false;
+  }
+
+  this->limit_count_++;
+
+  float remain = power_limit - fixed;
+  if (remain <= 0.0f) {
+    for (size_t i = 0; i < len; i++) {
+      out[i] = 0.0f;
+    }
+    return true;
+  }
+
+  /* 按转速误差分配，需求小于份额的轮子满足后将余量再分给其他轮子 */
+  float alloc[MAX_MOTOR_NUM];
+  float weight[MAX_MOTOR_NUM];
+  bool active[MAX_MOTOR_NUM];
+  for (size_t i = 0; i < len; i++) {
+    weight[i] = fabsf(error[i]) + POWER_ALLOC_ERROR_FLOOR;
+    active[i] = demand[i] > 0.0f;
+    alloc[i] = active[i] ? 0.0f : demand[i];
+  }
+
+  for (size_t round = 0; round < len; round++) {
+    float weight_sum = 0.0f;
+    for (size_t i = 0; i < len; i++) {
+      if (active[i]) {
+        weight_sum += weight[i];
+      }
+    }
+    if (weight_sum <= 0.0f) {
+      break;
+    }
+
+    bool saturated = false;
+    for (size_t i = 0; i < len; i++) {
+      if (active[i] && remain * weight[i] / weight_sum >= demand[i]) {
+        alloc[i] = demand[i];
+        active[i] = false;
+        saturated = true;
+      }
+    }
+
+    if (saturated) {
+      remain = power_limit - fixed;
+      for (size_t i = 0; i < len; i++) {
+        if (!active[i]) {
+          remain -= alloc[i];
+        }
+      }
+      continue;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+      if (active[i]) {
+        alloc[i] = remain * weight[i] / weight_sum;
+      }
+    }
+    break;
+  }
+
+  /* 解 k3*x^2 + k1*|rpm|*x = alloc */
+  for (size_t i = 0; i < len; i++) {
+    if (alloc[i] >= demand[i]) {
+      continue;
+    }
+
+    const float A = MODEL.out_2;
+    const float B = MODEL.torque * fabsf(speed[i]);
+    float x = 0.0f;
+    if (A > 1e-6f) {
+      x = (sqrtf(B * B + 4.0f * A * alloc[i]) - B) / (2.0f * A);
+    } else if (B > 1e-6f) {
+      x = alloc[i] / B;
+    }
+
+    out[i] = out[i] < 0.0f ? -x : x;
+  }
+
+  return true;
+}
+
+PowerLimiter::Model PowerLimiter::GetModel() {
+  /* 各项功耗均不为负 */
+  Model model;
+  model.torque = fmaxf(this->theta_[0], 0.0f) * POWER_SCALE[0];
+  model.speed_2 = fmaxf(this->theta_[1], 0.0f) * POWER_SCALE[1];
+  model.out_2 = fmaxf(this->theta_[2], 0.0f) * POWER_SCALE[2];
+  model.constant = fmaxf(this->theta_[3], 0.0f) * POWER_SCALE[3];
+  return model;
+}
+
+void PowerLimiter::PrintInfo() {
+  const Model MODEL = this->GetModel();
+
+  printf("k1:%e k2:%e k3:%e k0:%f\r\n", static_cast<double>(MODEL.torque),
+         static_cast<double>(MODEL.speed_2), static_cast<double>(MODEL.out_2),
+         static_cast<double>(MODEL.constant));
+  printf("init k1:%e k2:%e k3:%e k0:%f\r\n",
+         static_cast<double>(this->init_.torque),
+         static_cast<double>(this->init_.speed_2),
+         static_cast<double>(this->init_.out_2),
+         static_cast<double>(this->init_.constant));
+  printf("residual:%.2f W rms:%.2f W\r\n",
+         static_cast<double>(this->last_residual_),
+         static_cast<double>(this->residual_rms_));
+  printf("fit:%lu reject:%lu limit:%lu\r\n",
+         static_cast<unsigned long>(this->fit_count_),
+         static_cast<unsigned long>(this->reject_count_),
+         static_cast<unsigned long>(this->limit_count_));
+}
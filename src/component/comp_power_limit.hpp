@@ -0,0 +1,63 @@
+/*
+  底盘功率限制。
+  单个电机功率按 k1*|out*rpm| + k2*rpm^2 + k3*out^2 估计，整车另加常数k0，
+  用测得的底盘总功率以带遗忘因子的递推最小二乘在线修正系数。
+  超出功率上限时，扣除与输出无关的部分后按各轮转速误差分配剩余功率，
+  再由各轮分到的功率反解输出，使总功率恰好用满上限。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+namespace Component {
+class PowerLimiter {
+ public:
+  typedef struct {
+    float torque;   /* k1，输出与转速乘积的系数 */
+    float speed_2;  /* k2，转速平方的系数 */
+    float out_2;    /* k3，输出平方的系数 */
+    float constant; /* k0，静态功耗 */
+  } Model;
+
+  PowerLimiter(const Model &model);
+
+  /* out为上个周期的输出，power为对应的底盘总功率，返回样本是否被采用 */
+  bool Fit(const float *out, const float *speed, size_t len, float power);
+
+  float Estimate(const float *out, const float *speed, size_t len);
+
+  /* error为各轮转速误差，超出power_limit时修改out并返回true */
+  bool Allocate(float power_limit, float *out, const float *speed,
+                const float *error, size_t len);
+
+  Model GetModel();
+
+  /* 恢复初始系数 */
+  void Reset();
+
+  void PrintInfo();
+
+ private:
+  static constexpr size_t PARAM_NUM = 4;
+  static constexpr size_t MAX_MOTOR_NUM = 8;
+
+  static void Regressor(const float *out, const float *speed, size_t len,
+                        float *phi);
+
+  Model init_;
+
+  float theta_[PARAM_NUM];        /* 归一化后的系数 */
+  float p_[PARAM_NUM][PARAM_NUM]; /* 协方差 */
+
+  float last_residual_;
+  float residual_rms_;
+  float err_square_; /* 残差平方的滑动平均 */
+
+  uint32_t fit_count_;
+  uint32_t reject_count_;
+  uint32_t reject_run_; /* 连续拒绝次数 */
+  uint32_t warmup_;     /* 剩余无条件采用的样本数 */
+  uint32_t limit_count_;
+};
+}  // namespace Component
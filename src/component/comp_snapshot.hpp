@@ -0,0 +1,108 @@
+/*
+  带版本号的双缓冲数据快照。
+  发布者每次发布只拷贝一次，订阅者通过版本号判断是否更新，
+  有更新时拷贝一份，拷贝期间有新的发布则重读。
+*/
+
+#pragma once
+
+#include <atomic>
+#include <component.hpp>
+#include <cstring>
+
+namespace Component {
+template <typename Data>
+class Snapshot {
+ public:
+  Snapshot(const char* name) : name_(name), next_(list_) { list_ = this; }
+
+  Snapshot(const Snapshot&) = delete;
+
+  Snapshot& operator=(const Snapshot&) = delete;
+
+  /* 写入非活动缓冲区后切换，读者读取的缓冲区不会被本次写入修改 */
+  void Publish(const Data& data) {
+    /* 上次发布的版本号先于本次写入可见，读者据此发现覆盖 */
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint32_t NEXT = this->active_.load(std::memory_order_relaxed) ^ 1;
+    this->buffer_[NEXT] = data;
+    this->active_.store(NEXT, std::memory_order_release);
+    this->seq_.fetch_add(1, std::memory_order_release);
+  }
+
+  /* 发布次数，0表示尚未发布 */
+  uint32_t Sequence() const {
+    return this->seq_.load(std::memory_order_acquire);
+  }
+
+  /* 拷贝最新快照，返回其发布次数。拷贝期间缓冲区被覆盖时版本号必然变化 */
+  uint32_t Read(Data& data) const {
+    uint32_t seq = 0;
+    do {
+      seq = this->seq_.load(std::memory_order_acquire);
+      data = this->buffer_[this->active_.load(std::memory_order_acquire)];
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (seq != this->seq_.load(std::memory_order_relaxed));
+    return seq;
+  }
+
+  static Snapshot* Find(const char* name) {
+    for (Snapshot* item = list_; item != nullptr; item = item->next_) {
+      if (strcmp(item->name_, name) == 0) {
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  const char* name_;
+  Snapshot* next_;
+
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint32_t> active_{0};
+  Data buffer_[2] = {};
+
+  static inline Snapshot* list_ = nullptr;
+};
+
+/* 订阅端只读视图，持有最近一次更新的拷贝 */
+template <typename Data>
+class SnapshotView {
+ public:
+  SnapshotView(const char* name) : name_(name) {}
+
+  /* 有新数据时返回true，并拷贝最新快照 */
+  bool Update() {
+    if (this->snapshot_ == nullptr) {
+      /* 发布者可能晚于订阅者创建 */
+      this->snapshot_ = Snapshot<Data>::Find(this->name_);
+      if (this->snapshot_ == nullptr) {
+        return false;
+      }
+    }
+
+    const uint32_t SEQ = this->snapshot_->Sequence();
+    if (SEQ == this->last_seq_) {
+      return false;
+    }
+
+    this->last_seq_ = this->snapshot_->Read(this->data_);
+    return true;
+  }
+
+  /* 上次Update后的快照，下次Update前不会改变 */
+  const Data& operator*() const { return this->data_; }
+
+  const Data* operator->() const { return &this->data_; }
+
+  uint32_t Sequence() const { return this->last_seq_; }
+
+ private:
+  const char* name_;
+  Snapshot<Data>* snapshot_ = nullptr;
+  uint32_t last_seq_ = 0;
+  Data data_ = {};
+};
+}  // namespace Component
@@ -0,0 +1,123 @@
+/*
+  变长多消息帧。
+*/
+
+#include "comp_tlv.hpp"
+
+#include <cstring>
+
+#include "comp_crc16.hpp"
+
+using namespace Component;
+
+TLVFrame::TLVFrame(uint8_t *buff, size_t size)
+    : buff_(buff), size_(size), len_(0) {}
+
+void TLVFrame::Reset(uint8_t seq) {
+  this->buff_[0] = seq;
+  this->len_ = 1;
+}
+
+bool TLVFrame::Append(uint8_t type, const void *data, uint8_t len) {
+  /* 预留CRC16 */
+  if (this->len_ + HEADER_SIZE + len + sizeof(uint16_t) > this->size_) {
+    return false;
+  }
+
+  this->buff_[this->len_++] = type;
+  this->buff_[this->len_++] = len;
+  memcpy(this->buff_ + this->len_, data, len);
+  this->len_ += len;
+
+  return true;
+}
+
+size_t TLVFrame::Encode(uint8_t *out, size_t out_size) {
+  const uint16_t CRC = CRC16::Calculate(this->buff_, this->len_, CRC16_INIT);
+  memcpy(this->buff_ + this->len_, &CRC, sizeof(CRC));
+
+  const size_t RAW_LEN = this->len_ + sizeof(CRC);
+  if (out_size < MaxEncodedSize(RAW_LEN)) {
+    return 0;
+  }
+
+  size_t len = CobsEncode(this->buff_, RAW_LEN, out);
+  out[len++] = DELIMITER;
+
+  return len;
+}
+
+bool TLVFrame::Parse(uint8_t *frame, size_t len, Callback fun, void *arg) {
+  len = CobsDecode(frame, len, frame);
+
+  /* 序号与CRC16 */
+  if (len < 1 + sizeof(uint16_t) || !CRC16::Verify(frame, len)) {
+    return false;
+  }
+
+  const size_t END = len - sizeof(uint16_t);
+  size_t pos = 1;
+
+  /* 先检查长度，避免只处理了一部分消息 */
+  while (pos < END) {
+    if (pos + HEADER_SIZE > END || pos + HEADER_SIZE + frame[pos + 1] > END) {
+      return false;
+    }
+    pos += HEADER_SIZE + frame[pos + 1];
+  }
+
+  for (pos = 1; pos < END; pos += HEADER_SIZE + frame[pos + 1]) {
+    fun(frame[pos], frame + pos + HEADER_SIZE, frame[pos + 1], arg);
+  }
+
+  return true;
+}
+
+size_t TLVFrame::CobsEncode(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t code_pos = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++) {
+    if (src[i] == 0) {
+      dst[code_pos] = code;
+      code_pos = out++;
+      code = 1;
+    } else {
+      dst[out++] = src[i];
+      code++;
+      if (code == 0xff) {
+        dst[code_pos] = code;
+        code_pos = out++;
+        code = 1;
+      }
+    }
+  }
+
+  dst[code_pos] = code;
+
+  return out;
+}
+
+size_t TLVFrame::CobsDecode(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < len) {
+    const uint8_t CODE = src[in++];
+    if (CODE == 0 || in + CODE - 1 > len) {
+      return 0;
+    }
+
+    for (uint8_t i = 1; i < CODE; i++) {
+      dst[out++] = src[in++];
+    }
+
+    /* 最后一组之后没有被编码的0 */
+    if (CODE != 0xff && in < len) {
+      dst[out++] = 0;
+    }
+  }
+
+  return out;
+}
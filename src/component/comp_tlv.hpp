@@ -0,0 +1,53 @@
+/*
+  变长多消息帧。
+  一帧由序号、若干TLV消息与CRC16组成，经COBS编码后以0x00结尾，
+  接收端丢失数据后在下一个0x00处即可重新同步。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+namespace Component {
+class TLVFrame {
+ public:
+  static constexpr uint8_t DELIMITER = 0x00;
+
+  /* 每条消息的类型与长度各占一字节 */
+  static constexpr size_t HEADER_SIZE = 2;
+
+  typedef void (*Callback)(uint8_t type, const uint8_t *data, uint8_t len,
+                           void *arg);
+
+  /* buff用于暂存未编码的帧 */
+  TLVFrame(uint8_t *buff, size_t size);
+
+  void Reset(uint8_t seq);
+
+  /* 空间不足时返回false，已写入的消息不受影响 */
+  bool Append(uint8_t type, const void *data, uint8_t len);
+
+  /* 除序号外没有消息 */
+  bool Empty() { return this->len_ <= 1; }
+
+  /* 附加CRC16并编码到out，返回包含结尾0x00的长度，out不足时返回0 */
+  size_t Encode(uint8_t *out, size_t out_size);
+
+  /* 解码不含结尾0x00的一帧，校验通过后对每条消息调用fun */
+  static bool Parse(uint8_t *frame, size_t len, Callback fun, void *arg);
+
+  static constexpr size_t MaxEncodedSize(size_t raw_len) {
+    return raw_len + raw_len / 254 + 2;
+  }
+
+  static size_t CobsEncode(const uint8_t *src, size_t len, uint8_t *dst);
+
+  /* 可原地解码，格式错误时返回0 */
+  static size_t CobsDecode(const uint8_t *src, size_t len, uint8_t *dst);
+
+ private:
+  uint8_t *buff_;
+  size_t size_;
+  size_t len_;
+};
+}  // namespace Component
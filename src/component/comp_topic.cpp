@@ -0,0 +1,124 @@
+#include "comp_topic.hpp"
+
+using namespace Component;
+
+#if COMP_TOPIC_STATS
+TopicStats* TopicStats::list_;
+System::Term::Command<TopicStats*>* TopicStats::cmd_;
+
+void TopicStats::Link() {
+  if (this->linked_) {
+    return;
+  }
+
+  this->linked_ = true;
+  this->next_ = list_;
+  list_ = this;
+
+  /* 终端在机器人对象构造前初始化，此时注册命令是安全的 */
+  if (cmd_ == nullptr) {
+    cmd_ = new System::Term::Command<TopicStats*>(list_, Command, "topic",
+                                                  System::Term::BinDir());
+  }
+}
+
+void TopicStats::Reset() {
+  this->publish_count_ = 0;
+  this->callback_count_ = 0;
+  this->callback_max_us_ = 0;
+  this->read_count_ = 0;
+  memset(this->age_hist_, 0, sizeof(this->age_hist_));
+  this->query_count_ = 0;
+  this->query_time_us_ = bsp_time_get();
+}
+
+int TopicStats::Command(TopicStats* stats, int argc, char** argv) {
+  XB_UNUSED(stats);
+
+  if (argc != 2) {
+    printf("[stats] 打印话题统计\r\n");
+    printf("[dump]  以CSV格式输出话题统计\r\n");
+    printf("[reset] 清除统计数据\r\n");
+    return 0;
+  }
+
+  const bool DUMP = strcmp(argv[1], "dump") == 0;
+
+  if (strcmp(argv[1], "reset") == 0) {
+    for (TopicStats* item = list_; item != nullptr; item = item->next_) {
+      item->Reset();
+    }
+    return 0;
+  }
+
+  if (!DUMP && strcmp(argv[1], "stats") != 0) {
+    printf("未知参数\r\n");
+    return -1;
+  }
+
+  if (DUMP) {
+    printf("name,publish,rate_hz,last_us,subscriber,callback,callback_max_us,"
+           "read,age_100us,age_500us,age_1ms,age_5ms,age_20ms,age_over\r\n");
+  } else {
+    printf(
+        "%-20s %8s %8s %10s %4s %8s %8s %8s  age<100u/500u/1m/5m/20m/over\r\n",
+        "name", "publish", "rate", "last(us)", "sub", "callback", "cb_max",
+        "read");
+  }
+
+  const uint64_t NOW = bsp_time_get();
+
+  for (TopicStats* item = list_; item != nullptr; item = item->next_) {
+    /* 频率按距离上次查询的时间计算 */
+    const uint64_t SPAN = NOW - item->query_time_us_;
+    const float RATE =
+        SPAN > 0 ? static_cast<float>(item->publish_count_ -
+                                      item->query_count_) *
+                       1000000.0f / static_cast<float>(SPAN)
+                 : 0.0f;
+    item->query_count_ = item->publish_count_;
+    item->query_time_us_ = NOW;
+
+    const uint32_t LAST =
+        item->publish_count_ > 0
+            ? static_cast<uint32_t>(NOW - item->last_publish_us_)
+            : UINT32_MAX;
+
+    const uint32_t* HIST = item->age_hist_;
+
+    if (DUMP) {
+      printf("%s,%lu,%.1f,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+             item->name_, static_cast<unsigned long>(item->publish_count_),
+             static_cast<double>(RATE), static_cast<unsigned long>(LAST),
+             static_cast<unsigned long>(item->subscriber_count_),
+             static_cast<unsigned long>(item->callback_count_),
+             static_cast<unsigned long>(item->callback_max_us_),
+             static_cast<unsigned long>(item->read_count_),
+             static_cast<unsigned long>(HIST[0]),
+             static_cast<unsigned long>(HIST[1]),
+             static_cast<unsigned long>(HIST[2]),
+             static_cast<unsigned long>(HIST[3]),
+             static_cast<unsigned long>(HIST[4]),
+             static_cast<unsigned long>(HIST[5]));
+    } else {
+      printf(
+          "%-20s %8lu %8.1f %10lu %4lu %8lu %8lu %8lu  "
+          "%lu/%lu/%lu/%lu/%lu/%lu\r\n",
+          item->name_, static_cast<unsigned long>(item->publish_count_),
+          static_cast<double>(RATE), static_cast<unsigned long>(LAST),
+          static_cast<unsigned long>(item->subscriber_count_),
+          static_cast<unsigned long>(item->callback_count_),
+          static_cast<unsigned long>(item->callback_max_us_),
+          static_cast<unsigned long>(item->read_count_),
+          static_cast<unsigned long>(HIST[0]),
+          static_cast<unsigned long>(HIST[1]),
+          static_cast<unsigned long>(HIST[2]),
+          static_cast<unsigned long>(HIST[3]),
+          static_cast<unsigned long>(HIST[4]),
+          static_cast<unsigned long>(HIST[5]));
+    }
+  }
+
+  return 0;
+}
+#endif
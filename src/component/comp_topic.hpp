@@ -0,0 +1,414 @@
+/*
+  编译期话题描述。
+  话题名在编译期哈希并与数据类型绑定，订阅时直接取得发布者登记的话题，
+  类型不一致时无法通过编译。
+*/
+
+#pragma once
+
+#include <component.hpp>
+#include <new>
+
+#include "trace.hpp"
+
+/* 话题统计：发布次数、订阅数、回调耗时与读取时的数据年龄，关闭时不产生代码 */
+#ifndef COMP_TOPIC_STATS
+#define COMP_TOPIC_STATS (0)
+#endif
+
+#if COMP_TOPIC_STATS
+#include "bsp_time.h"
+#endif
+
+/* 有线程池的平台上异步回调交给线程池执行 */
+#if __has_include(<thread_pool.hpp>)
+#include <thread_pool.hpp>
+#define COMP_TOPIC_ASYNC (1)
+#else
+#define COMP_TOPIC_ASYNC (0)
+#endif
+
+namespace Component {
+/* FNV-1a */
+constexpr uint32_t TopicHash(const char* str, uint32_t hash = 2166136261u) {
+  return *str == '\0'
+             ? hash
+             : TopicHash(str + 1,
+                         (hash ^ static_cast<uint8_t>(*str)) * 16777619u);
+}
+
+/* 话题名与数据类型的绑定，由COMP_TOPIC_DECLARE特化 */
+template <uint32_t Hash>
+struct TopicType;
+
+/* 在全局命名空间中声明话题，重名或哈希冲突时重复特化无法通过编译 */
+#define COMP_TOPIC_DECLARE(_name, _type)                     \
+  template <>                                                \
+  struct Component::TopicType<Component::TopicHash(_name)> { \
+    typedef _type Type;                                      \
+    static constexpr const char* NAME = _name;               \
+  }
+
+#if COMP_TOPIC_STATS
+class TopicStats {
+ public:
+  static constexpr uint32_t AGE_BUCKET_NUM = 6;
+
+  /* 读取时数据年龄的分桶上界，单位us，最后一档为超出部分 */
+  static constexpr uint32_t AGE_BUCKET_US[AGE_BUCKET_NUM - 1] = {
+      100, 500, 1000, 5000, 20000};
+
+  constexpr TopicStats(const char* name) : name_(name) {}
+
+  /* 首次使用时加入统计列表，并注册终端命令 */
+  void Link();
+
+  void OnPublish() {
+    this->publish_count_++;
+    this->last_publish_us_ = bsp_time_get();
+  }
+
+  void OnSubscribe() {
+    this->Link();
+    this->subscriber_count_++;
+  }
+
+  void OnCallback(uint32_t duration) {
+    this->callback_count_++;
+    if (duration > this->callback_max_us_) {
+      this->callback_max_us_ = duration;
+    }
+  }
+
+  void OnRead() {
+    this->read_count_++;
+
+    if (this->publish_count_ == 0) {
+      return;
+    }
+
+    const uint64_t AGE = bsp_time_get() - this->last_publish_us_;
+    uint32_t i = 0;
+    while (i < AGE_BUCKET_NUM - 1 && AGE >= AGE_BUCKET_US[i]) {
+      i++;
+    }
+    this->age_hist_[i]++;
+  }
+
+  static int Command(TopicStats* stats, int argc, char** argv);
+
+ private:
+  void Reset();
+
+  const char* name_;
+  TopicStats* next_ = nullptr;
+  bool linked_ = false;
+
+  uint32_t publish_count_ = 0;
+  uint32_t subscriber_count_ = 0;
+  uint32_t callback_count_ = 0;
+  uint32_t callback_max_us_ = 0;
+  uint32_t read_count_ = 0;
+  uint32_t age_hist_[AGE_BUCKET_NUM] = {};
+  uint64_t last_publish_us_ = 0;
+
+  /* 上次查询时的计数，用于计算发布频率 */
+  uint32_t query_count_ = 0;
+  uint64_t query_time_us_ = 0;
+
+  static TopicStats* list_;
+  static System::Term::Command<TopicStats*>* cmd_;
+};
+#endif
+
+template <uint32_t Hash>
+class TopicRegistry {
+ public:
+  typedef typename TopicType<Hash>::Type Data;
+
+  static constexpr const char* NAME = TopicType<Hash>::NAME;
+
+  /* 发布者构造时登记，之后订阅不再按名称查找 */
+  static void Register(Message::Topic<Data>& topic) {
+    topic_ = &topic;
+
+#if COMP_TOPIC_STATS
+    stats_.Link();
+
+    auto publish_cb = [](Data& data, TopicStats* stats) {
+      XB_UNUSED(data);
+      stats->OnPublish();
+      return true;
+    };
+
+    topic.RegisterCallback(publish_cb, &stats_);
+#endif
+
+#if SYSTEM_TRACE
+    auto trace_cb = [](Data& data, const char* name) {
+      XB_UNUSED(data);
+      System::Trace::Instant(System::Trace::TOPIC, name);
+      return true;
+    };
+
+    topic.RegisterCallback(trace_cb, NAME);
+#endif
+
+    /* 挂上发布者登记前注册的回调 */
+    while (pending_ != nullptr) {
+      PendingCallback* pending = pending_;
+      pending_ = pending->next;
+      pending->attach(topic, pending);
+    }
+  }
+
+  static bool Registered() { return topic_ != nullptr; }
+
+  /* 发布者尚未登记时退回按名称查找 */
+  static Message::Topic<Data> Get() {
+    if (topic_ != nullptr) {
+      return *topic_;
+    }
+    return Message::Topic<Data>(Message::Topic<Data>::Find(NAME));
+  }
+
+  /* 发布者尚未登记时暂存，登记后再挂到话题上；开启统计时记录回调耗时 */
+  template <typename Fun, typename Arg>
+  static void RegisterCallback(Fun fun, Arg arg) {
+    typedef struct {
+      PendingCallback pending;
+      bool (*fun)(Data&, Arg);
+      Arg arg;
+    } CallbackBlock;
+
+    CallbackBlock* block =
+        static_cast<CallbackBlock*>(System::Memory::MallocStatic(
+            sizeof(CallbackBlock), System::Memory::STATIC_CALLBACK));
+    block->fun = fun;
+    block->arg = arg;
+
+    block->pending.attach = [](Message::Topic<Data>& topic,
+                               PendingCallback* pending) {
+      CallbackBlock* block = reinterpret_cast<CallbackBlock*>(pending);
+
+#if COMP_TOPIC_STATS
+      auto timed_cb = [](Data& data, CallbackBlock* block) {
+        const uint64_t START = bsp_time_get();
+        bool ans = block->fun(data, block->arg);
+        stats_.OnCallback(static_cast<uint32_t>(bsp_time_get() - START));
+        return ans;
+      };
+
+      topic.RegisterCallback(timed_cb, block);
+#else
+      topic.RegisterCallback(block->fun, block->arg);
+#endif
+    };
+
+    if (Registered()) {
+      block->pending.attach(*topic_, &block->pending);
+    } else {
+      block->pending.next = pending_;
+      pending_ = &block->pending;
+    }
+  }
+
+  /* 异步回调的状态，注销时用作句柄 */
+  typedef struct {
+    System::Mutex mutex;
+    System::Thread::Priority priority;
+    bool scheduled;   /* 线程池中有任务，同一时刻最多一个 */
+    bool updated;     /* 有尚未交给回调的数据 */
+    uint32_t running; /* 正在执行的回调数 */
+    bool detached;    /* 已注销 */
+  } AsyncState;
+
+  typedef AsyncState* AsyncHandle;
+
+  /*
+    回调在线程池中执行，不阻塞发布者。回调未执行完时到达的数据只保留最新一份。
+    没有线程池的平台退回同步回调。
+  */
+  template <typename Fun, typename Arg>
+  static AsyncHandle RegisterAsyncCallback(
+      Fun fun, Arg arg,
+      System::Thread::Priority priority = System::Thread::MEDIUM) {
+    typedef struct {
+      AsyncState state;
+      bool (*fun)(Data&, Arg);
+      Arg arg;
+      Data data;
+    } AsyncBlock;
+
+    /* 话题上的回调无法撤销，控制块不释放，注销后只是不再转发 */
+    AsyncBlock* block = new (System::Memory::MallocStatic(
+        sizeof(AsyncBlock), System::Memory::STATIC_CALLBACK)) AsyncBlock;
+    block->state.priority = priority;
+    block->state.scheduled = false;
+    block->state.updated = false;
+    block->state.running = 0;
+    block->state.detached = false;
+    block->fun = fun;
+    block->arg = arg;
+
+#if COMP_TOPIC_ASYNC
+    auto publish_cb = [](Data& data, AsyncBlock* block) {
+      block->state.mutex.Lock();
+      if (block->state.detached) {
+        block->state.mutex.Unlock();
+        return true;
+      }
+      block->data = data;
+      block->state.updated = true;
+      const bool SUBMIT = !block->state.scheduled;
+      block->state.scheduled = true;
+      block->state.mutex.Unlock();
+
+      if (SUBMIT) {
+        /* 执行期间到达的新数据由同一个任务继续处理，回调不会并发 */
+        auto async_fn = [](AsyncBlock* block) {
+          while (true) {
+            block->state.mutex.Lock();
+            if (block->state.detached || !block->state.updated) {
+              block->state.scheduled = false;
+              block->state.mutex.Unlock();
+              return;
+            }
+            Data data = block->data;
+            block->state.updated = false;
+            block->state.running++;
+            block->state.mutex.Unlock();
+
+            block->fun(data, block->arg);
+
+            block->state.mutex.Lock();
+            block->state.running--;
+            block->state.mutex.Unlock();
+          }
+        };
+
+        System::ThreadPool::Default().Submit(async_fn, block,
+                                             block->state.priority);
+      }
+
+      return true;
+    };
+#else
+    auto publish_cb = [](Data& data, AsyncBlock* block) {
+      block->state.mutex.Lock();
+      if (block->state.detached) {
+        block->state.mutex.Unlock();
+        return true;
+      }
+      block->state.running++;
+      block->state.mutex.Unlock();
+
+      block->fun(data, block->arg);
+
+      block->state.mutex.Lock();
+      block->state.running--;
+      block->state.mutex.Unlock();
+
+      return true;
+    };
+#endif
+
+    RegisterCallback(publish_cb, block);
+
+    return &block->state;
+  }
+
+  /*
+    注销异步回调。返回时回调已执行完且不会再被调用，之后可以释放arg。
+    会等待正在执行的回调，不能在该回调中调用。
+  */
+  static void UnregisterAsyncCallback(AsyncHandle handle) {
+    handle->mutex.Lock();
+    handle->detached = true;
+    while (handle->running > 0) {
+      handle->mutex.Unlock();
+      System::Thread::Sleep(1);
+      handle->mutex.Lock();
+    }
+    handle->mutex.Unlock();
+  }
+
+#if COMP_TOPIC_STATS
+  static TopicStats& Stats() { return stats_; }
+#endif
+
+ private:
+  typedef struct PendingCallback {
+    void (*attach)(Message::Topic<Data>& topic, PendingCallback* pending);
+    PendingCallback* next;
+  } PendingCallback;
+
+  static inline Message::Topic<Data>* topic_ = nullptr;
+  static inline PendingCallback* pending_ = nullptr;
+
+#if COMP_TOPIC_STATS
+  static inline TopicStats stats_ = TopicStats(NAME);
+#endif
+};
+
+/* 首次读取时才绑定话题，订阅者可以先于发布者构造 */
+template <uint32_t Hash>
+class StaticSubscriber {
+ public:
+  typedef typename TopicType<Hash>::Type Data;
+  typedef Message::Subscriber<Data> SubscriberType;
+
+  StaticSubscriber() {
+#if COMP_TOPIC_STATS
+    TopicRegistry<Hash>::Stats().OnSubscribe();
+#endif
+  }
+
+  ~StaticSubscriber() {
+    if (this->sub_ != nullptr) {
+      this->sub_->~SubscriberType();
+    }
+  }
+
+  StaticSubscriber(const StaticSubscriber&) = delete;
+  StaticSubscriber& operator=(const StaticSubscriber&) = delete;
+
+  bool DumpData(Data& data) {
+#if COMP_TOPIC_STATS
+    if (!this->Bind().DumpData(data)) {
+      return false;
+    }
+    TopicRegistry<Hash>::Stats().OnRead();
+    return true;
+#else
+    return this->Bind().DumpData(data);
+#endif
+  }
+
+ private:
+  SubscriberType& Bind() {
+    if (this->sub_ == nullptr) {
+      this->sub_ = new (this->storage_) SubscriberType(Create());
+    }
+    return *this->sub_;
+  }
+
+  static SubscriberType Create() {
+    if (TopicRegistry<Hash>::Registered()) {
+      return SubscriberType(TopicRegistry<Hash>::Get());
+    }
+    return SubscriberType(TopicRegistry<Hash>::NAME);
+  }
+
+  SubscriberType* sub_ = nullptr;
+  alignas(SubscriberType) uint8_t storage_[sizeof(SubscriberType)];
+};
+}  // namespace Component
+
+/* 由component中类型承载的公共话题 */
+COMP_TOPIC_DECLARE("imu_accl", Component::Type::Vector3);
+COMP_TOPIC_DECLARE("imu_gyro", Component::Type::Vector3);
+COMP_TOPIC_DECLARE("magn", Component::Type::Vector3);
+COMP_TOPIC_DECLARE("imu_eulr", Component::Type::Eulr);
+COMP_TOPIC_DECLARE("imu_quat", Component::Type::Quaternion);
+COMP_TOPIC_DECLARE("chassis_yaw", float);
@@ -12,71 +12,32 @@ class Trans {
     float yaw;
   } Angle;
 
+  /* 依次绕roll、yaw、pitch旋转，等价于r1 * r2 * r3 * v */
   static void EulrPosTrans(Angle &eulr, Type::Vector3 &pos) {
-    float r1[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    float cy = 0.0f, sy = 0.0f, cp = 0.0f, sp = 0.0f, cr = 0.0f, sr = 0.0f;
+    FastMath::SinCos(eulr.yaw, &sy, &cy);
+    FastMath::SinCos(-eulr.pit, &sp, &cp);
+    FastMath::SinCos(eulr.rol, &sr, &cr);
 
-    float r2[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    /* 计算向量坐标，旋转矩阵中的0和1项不参与运算 */
+    const float V0 = pos.y, V1 = pos.x, V2 = pos.z;
 
-    float r3[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    /* r3：绕第0轴 */
+    const float R3_1 = cr * V1 - sr * V2;
+    const float R3_2 = sr * V1 + cr * V2;
 
-    float cy = cosf(eulr.yaw);
-    float sy = sinf(eulr.yaw);
-    float cp = cosf(-eulr.pit);
-    float sp = sinf(-eulr.pit);
-    float cr = cosf(eulr.rol);
-    float sr = sinf(eulr.rol);
+    /* r2：绕第2轴 */
+    const float R2_0 = cy * V0 - sy * R3_1;
+    const float R2_1 = sy * V0 + cy * R3_1;
 
-    r1[0][0] = cp;
-    r1[0][2] = sp;
-    r1[2][0] = -sp;
-    r1[2][2] = cp;
-
-    r2[0][0] = cy;
-    r2[0][1] = -sy;
-    r2[1][0] = sy;
-    r2[1][1] = cy;
-
-    r3[1][1] = cr;
-    r3[1][2] = -sr;
-    r3[2][1] = sr;
-    r3[2][2] = cr;
-
-    // 计算向量坐标
-    float v[3] = {pos.y, pos.x, pos.z};
-    float temp[3] = {0, 0, 0};
-
-    for (int i = 0; i < 3; i++) {
-      for (int j = 0; j < 3; j++) {
-        temp[i] += r3[i][j] * v[j];
-      }
-    }
-
-    for (int i = 0; i < 3; i++) {
-      v[i] = temp[i];
-      temp[i] = 0;
-    }
-
-    for (int i = 0; i < 3; i++) {
-      for (int j = 0; j < 3; j++) {
-        temp[i] += r2[i][j] * v[j];
-      }
-    }
-
-    for (int i = 0; i < 3; i++) {
-      v[i] = temp[i];
-      temp[i] = 0;
-    }
-
-    for (int i = 0; i < 3; i++) {
-      for (int j = 0; j < 3; j++) {
-        temp[i] += r1[i][j] * v[j];
-      }
-    }
+    /* r1：绕第1轴 */
+    const float R1_0 = cp * R2_0 + sp * R3_2;
+    const float R1_2 = -sp * R2_0 + cp * R3_2;
 
     // 返回结果
-    pos.x = temp[1];
-    pos.y = temp[0];
-    pos.z = temp[2];
+    pos.x = R2_1;
+    pos.y = R1_0;
+    pos.z = R1_2;
   }
 };
 }  // namespace Component
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
+
+#include "comp_fastmath.hpp"
 
 #define M_DEG2RAD_MULT (0.01745329251f)
 #define M_RAD2DEG_MULT (57.2957795131f)
@@ -27,12 +30,35 @@ class CycleValue {
  public:
   CycleValue& operator=(const CycleValue&) = default;
 
+  /* 映射到[0, 2PI)，用乘倒数取整代替fmodf */
   static float Calculate(float value) {
-    value = fmodf(value, M_2PI);
-    if (value < 0) {
-      value += M_2PI;
+    const float TURNS = value * INV_TWO_PI;
+
+    /* 圈数过大或非有限值时退回fmodf */
+    if (!(fabsf(TURNS) < 8388608.0f)) {
+      value = fmodf(value, TWO_PI);
+      return value < 0.0f ? value + TWO_PI : value;
     }
-    return value;
+
+    int32_t turns = static_cast<int32_t>(TURNS);
+    turns -= TURNS < static_cast<float>(turns);
+    /* 2PI拆成高低两部分相减，减小大角度时的舍入误差 */
+    value -= static_cast<float>(turns) * TWO_PI_HI;
+    value -= static_cast<float>(turns) * TWO_PI_LO;
+
+    return Wrap(value);
+  }
+
+  /* 将[-2PI, 4PI)范围内的值映射到[0, 2PI) */
+  static float Wrap(float value) {
+    value = value < 0.0f ? value + TWO_PI : value;
+    return value >= TWO_PI ? value - TWO_PI : value;
+  }
+
+  /* 将(-3PI, 3PI)范围内的差值映射到[-PI, PI) */
+  static float WrapDiff(float value) {
+    value = value >= PI ? value - TWO_PI : value;
+    return value < -PI ? value + TWO_PI : value;
   }
 
   CycleValue(const float& value) : value_(Calculate(value)) {}
@@ -40,15 +66,7 @@ class CycleValue {
   CycleValue(const double& value)
       : value_(Calculate(static_cast<float>(value))) {}
 
-  CycleValue(const CycleValue& value) : value_(value.value_) {
-    while (value_ >= M_2PI) {
-      value_ -= M_2PI;
-    }
-
-    while (value_ < 0) {
-      value_ += M_2PI;
-    }
-  }
+  CycleValue(const CycleValue& value) : value_(value.value_) {}
 
   CycleValue() : value_(0.0f) {}
 
@@ -77,59 +95,21 @@ class CycleValue {
   }
 
   CycleValue operator+=(const CycleValue& value) {
-    float ans = value.value_ + value_;
-    while (ans >= M_2PI) {
-      ans -= M_2PI;
-    }
-
-    while (ans < 0) {
-      ans += M_2PI;
-    }
-
-    value_ = ans;
+    value_ = Wrap(value.value_ + value_);
 
     return *this;
   }
 
   float operator-(const float& raw_value) {
-    float value = Calculate(raw_value);
-    float ans = value_ - value;
-    while (ans >= M_PI) {
-      ans -= M_2PI;
-    }
-
-    while (ans < -M_PI) {
-      ans += M_2PI;
-    }
-
-    return ans;
+    return WrapDiff(value_ - Calculate(raw_value));
   }
 
   float operator-(const double& raw_value) {
-    float value = Calculate(static_cast<float>(raw_value));
-    float ans = value_ - value;
-    while (ans >= M_PI) {
-      ans -= M_2PI;
-    }
-
-    while (ans < -M_PI) {
-      ans += M_2PI;
-    }
-
-    return ans;
+    return WrapDiff(value_ - Calculate(static_cast<float>(raw_value)));
   }
 
   float operator-(const CycleValue& value) {
-    float ans = value_ - value.value_;
-    while (ans >= M_PI) {
-      ans -= M_2PI;
-    }
-
-    while (ans < -M_PI) {
-      ans += M_2PI;
-    }
-
-    return ans;
+    return WrapDiff(value_ - value.value_);
   }
 
   CycleValue operator-=(const float& value) {
@@ -145,21 +125,12 @@ class CycleValue {
   }
 
   CycleValue operator-=(const CycleValue& value) {
-    float ans = value_ - value.value_;
-    while (ans >= M_2PI) {
-      ans -= M_2PI;
-    }
-
-    while (ans < 0) {
-      ans += M_2PI;
-    }
-
-    value_ = ans;
+    value_ = Wrap(value_ - value.value_);
 
     return *this;
   }
 
-  CycleValue operator-() { return CycleValue(M_2PI - value_); }
+  CycleValue operator-() { return CycleValue(TWO_PI - value_); }
 
   operator float() { return this->value_; }
 
@@ -169,13 +140,20 @@ class CycleValue {
   }
 
   CycleValue& operator=(const double& value) {
-    value_ = static_cast<float>(value);
+    value_ = Calculate(static_cast<float>(value));
     return *this;
   }
 
   float Value() { return value_; }
 
  private:
+  /* 单精度常量，避免与double型M_PI比较 */
+  static constexpr float PI = M_PI;
+  static constexpr float TWO_PI = M_2PI;
+  static constexpr float INV_TWO_PI = 1.0f / M_2PI;
+  static constexpr float TWO_PI_HI = 6.28125f;
+  static constexpr float TWO_PI_LO = TWO_PI - TWO_PI_HI; /* 精确值 */
+
   float value_;
 };
 /* 欧拉角（Euler angle） */
@@ -229,7 +207,7 @@ class Position2 {
     return sqrtf(this->x_ * this->x_ + this->y_ * this->y_);
   }
 
-  inline float GetAngle() { return atan2f(this->y_, this->x_); }
+  inline float GetAngle() { return FastMath::Atan2(this->y_, this->x_); }
 
   const Position2 operator+(const Position2& pos) {
     return Position2(pos.x_ + this->x_, pos.y_ + this->y_);
@@ -243,8 +221,9 @@ class Position2 {
 class Polar2 {
  public:
   operator Position2() {
-    return Position2(this->distance_ * cosf(this->angle_),
-                     this->distance_ * sinf(this->angle_));
+    float s = 0.0f, c = 0.0f;
+    FastMath::SinCos(this->angle_, &s, &c);
+    return Position2(this->distance_ * c, this->distance_ * s);
   }
 
   Polar2() = default;
@@ -301,7 +280,7 @@ class Line {
     float dy = this->end_.y_ - this->start_.y_;
     float dx = this->end_.x_ - this->start_.x_;
 
-    return atan2f(dy, dx);
+    return FastMath::Atan2(dy, dx);
   }
 
   Position2 start_, end_;
@@ -0,0 +1,422 @@
+/*
+  操作手UI场景。
+*/
+
+#include "comp_ui_scene.hpp"
+
+using namespace Component;
+
+/* 每级图层优先级相当于多等待的时间，等待越久越优先，低优先级图层不会饿死 */
+#define UI_SCENE_LAYER_WEIGHT (100)
+/* 客户端上缺失或需要删除的图形优先于修改 */
+#define UI_SCENE_ADD_WEIGHT (500)
+
+/* 与操作手射击判断直接相关的图层优先 */
+static const uint8_t UI_LAYER_RANK[] = {
+    0, /* UI_GRAPHIC_LAYER_CONST */
+    5, /* UI_GRAPHIC_LAYER_AUTOAIM */
+    2, /* UI_GRAPHIC_LAYER_CHASSIS */
+    1, /* UI_GRAPHIC_LAYER_CAP */
+    3, /* UI_GRAPHIC_LAYER_GIMBAL */
+    4, /* UI_GRAPHIC_LAYER_LAUNCHER */
+    6, /* UI_GRAPHIC_LAYER_CMD */
+};
+
+/* 可用的图形帧长度 */
+static const uint8_t UI_FRAME_ELE_NUM[] = {1, 2, 5, UI_MAX_GRAPHIC_NUM};
+
+static UI::Ele &Graphic(UI::Ele &ele) { return ele; }
+static UI::Ele &Graphic(UI::Str &str) { return str.graphic; }
+static const UI::Ele &Graphic(const UI::Ele &ele) { return ele; }
+static const UI::Ele &Graphic(const UI::Str &str) { return str.graphic; }
+
+/* 比较时忽略操作类型 */
+static bool Same(const UI::Ele &a, const UI::Ele &b) {
+  UI::Ele tmp = b;
+  tmp.op = a.op;
+  return memcmp(&a, &tmp, sizeof(UI::Ele)) == 0;
+}
+
+static bool Same(const UI::Str &a, const UI::Str &b) {
+  return Same(a.graphic, b.graphic) && memcmp(a.str, b.str, sizeof(a.str)) == 0;
+}
+
+UIScene::UIScene(size_t ele_num, size_t str_num, uint32_t refresh_ms)
+    : ele_num_(ele_num),
+      str_num_(str_num),
+      refresh_ms_(refresh_ms),
+      ele_(new Node<UI::Ele>[ele_num]()),
+      str_(new Node<UI::Str>[str_num]()) {}
+
+template <typename T>
+bool UIScene::Store(Node<T> *nodes, size_t num, const T &data, uint32_t now) {
+  const UI::Ele &graphic = Graphic(data);
+
+  Node<T> *node = nullptr, *free_node = nullptr;
+  for (size_t i = 0; i < num; i++) {
+    if (nodes[i].state == NODE_FREE) {
+      if (free_node == nullptr) {
+        free_node = &nodes[i];
+      }
+    } else if (memcmp(Graphic(nodes[i].data).name, graphic.name,
+                      sizeof(graphic.name)) == 0) {
+      node = &nodes[i];
+      break;
+    }
+  }
+
+  if (graphic.op == UI::UI_GRAPHIC_OP_DEL) {
+    if (node != nullptr && node->state != NODE_REMOVE) {
+      node->state = NODE_REMOVE;
+      node->dirty_time = now;
+    }
+    return true;
+  }
+
+  if (node == nullptr) {
+    if (free_node == nullptr) {
+      this->stats_.dropped++;
+      return false;
+    }
+
+    free_node->data = data;
+    free_node->state = NODE_ADD;
+    free_node->dirty_time = now;
+    free_node->sent_time = now;
+    return true;
+  }
+
+  if (node->state != NODE_REMOVE && Same(node->data, data)) {
+    this->stats_.unchanged++;
+    return true;
+  }
+
+  switch (node->state) {
+    case NODE_CLEAN:
+      node->state = NODE_MODIFY;
+      node->dirty_time = now;
+      break;
+    case NODE_REMOVE:
+      /* 删除尚未发出，客户端上仍是旧内容 */
+      node->state = NODE_MODIFY;
+      break;
+    default:
+      this->stats_.merged++;
+      break;
+  }
+
+  node->data = data;
+
+  return true;
+}
+
+bool UIScene::Update(const UI::Ele &ele, uint32_t now) {
+  return this->Store(this->ele_, this->ele_num_, ele, now);
+}
+
+bool UIScene::Update(const UI::Str &str, uint32_t now) {
+  return this->Store(this->str_, this->str_num_, str, now);
+}
+
+bool UIScene::Delete(const UI::Del &del) {
+  /* 客户端上对应图层随之清空，场景中也不再保留 */
+  for (size_t i = 0; i < this->ele_num_; i++) {
+    if (del.op == UI::UI_DEL_OP_DEL_ALL ||
+        this->ele_[i].data.layer == del.layer) {
+      this->ele_[i].state = NODE_FREE;
+    }
+  }
+
+  for (size_t i = 0; i < this->str_num_; i++) {
+    if (del.op == UI::UI_DEL_OP_DEL_ALL ||
+        this->str_[i].data.graphic.layer == del.layer) {
+      this->str_[i].state = NODE_FREE;
+    }
+  }
+
+  if (this->del_num_ >= UI_MAX_DEL_NUM) {
+    this->stats_.dropped++;
+    return false;
+  }
+
+  this->del_[this->del_num_++] = del;
+
+  return true;
+}
+
+void UIScene::Invalidate() {
+  for (size_t i = 0; i < this->ele_num_; i++) {
+    if (this->ele_[i].state == NODE_CLEAN ||
+        this->ele_[i].state == NODE_MODIFY) {
+      this->ele_[i].state = NODE_ADD;
+    }
+  }
+
+  for (size_t i = 0; i < this->str_num_; i++) {
+    if (this->str_[i].state == NODE_CLEAN ||
+        this->str_[i].state == NODE_MODIFY) {
+      this->str_[i].state = NODE_ADD;
+    }
+  }
+}
+
+uint32_t UIScene::Backlog(uint32_t now) {
+  uint32_t backlog = 0;
+
+  for (size_t i = 0; i < this->ele_num_; i++) {
+    const Node<UI::Ele> &node = this->ele_[i];
+    if (node.state != NODE_FREE && node.state != NODE_CLEAN &&
+        now - node.dirty_time > backlog) {
+      backlog = now - node.dirty_time;
+    }
+  }
+
+  for (size_t i = 0; i < this->str_num_; i++) {
+    const Node<UI::Str> &node = this->str_[i];
+    if (node.state != NODE_FREE && node.state != NODE_CLEAN &&
+        now - node.dirty_time > backlog) {
+      backlog = now - node.dirty_time;
+    }
+  }
+
+  return backlog;
+}
+
+size_t UIScene::EleCount() {
+  size_t count = 0;
+  for (size_t i = 0; i < this->ele_num_; i++) {
+    if (this->ele_[i].state != NODE_FREE) {
+      count++;
+    }
+  }
+  return count;
+}
+
+size_t UIScene::StrCount() {
+  size_t count = 0;
+  for (size_t i = 0; i < this->str_num_; i++) {
+    if (this->str_[i].state != NODE_FREE) {
+      count++;
+    }
+  }
+  return count;
+}
+
+size_t UIScene::Insert(Candidate *out, size_t count, size_t max,
+                       uint32_t index, uint32_t score) {
+  size_t pos = count < max ? count++ : max;
+  while (pos > 0 && out[pos - 1].score < score) {
+    if (pos < max) {
+      out[pos] = out[pos - 1];
+    }
+    pos--;
+  }
+  if (pos < max) {
+    out[pos] = {index, score};
+  }
+
+  return count;
+}
+
+template <typename T>
+size_t UIScene::CollectDirty(Node<T> *nodes, size_t num, uint32_t now,
+                             Candidate *out, size_t max) {
+  size_t count = 0;
+
+  for (size_t i = 0; i < num; i++) {
+    const Node<T> &node = nodes[i];
+    if (node.state == NODE_FREE || node.state == NODE_CLEAN) {
+      continue;
+    }
+
+    const uint8_t LAYER = Graphic(node.data).layer;
+    uint32_t score = now - node.dirty_time;
+    if (LAYER < sizeof(UI_LAYER_RANK)) {
+      score += UI_LAYER_RANK[LAYER] * UI_SCENE_LAYER_WEIGHT;
+    }
+    if (node.state != NODE_MODIFY) {
+      score += UI_SCENE_ADD_WEIGHT;
+    }
+
+    count = Insert(out, count, max, i, score);
+  }
+
+  return count;
+}
+
+template <typename T>
+size_t UIScene::CollectClean(Node<T> *nodes, size_t num, uint32_t now,
+                             uint32_t min_age, Candidate *out, size_t max) {
+  size_t count = 0;
+
+  for (size_t i = 0; i < num; i++) {
+    const Node<T> &node = nodes[i];
+    const uint32_t AGE = now - node.sent_time;
+    if (node.state != NODE_CLEAN || AGE < min_age) {
+      continue;
+    }
+
+    count = Insert(out, count, max, i, AGE);
+  }
+
+  return count;
+}
+
+uint8_t UIScene::NodeOperation(uint8_t state) {
+  switch (state) {
+    case NODE_MODIFY:
+      return UI::UI_GRAPHIC_OP_REWRITE;
+    case NODE_REMOVE:
+      return UI::UI_GRAPHIC_OP_DEL;
+    default:
+      return UI::UI_GRAPHIC_OP_ADD;
+  }
+}
+
+bool UIScene::PackEle(Frame &frame, Candidate *cand, size_t num, uint32_t now,
+                      size_t budget, bool refresh) {
+  /* 选择能装下所有图形的最短帧，带宽不足时退而使用更短的帧 */
+  size_t size_index = 0;
+  while (size_index < sizeof(UI_FRAME_ELE_NUM) - 1 &&
+         UI_FRAME_ELE_NUM[size_index] < num) {
+    size_index++;
+  }
+
+  while (UI_FRAME_ELE_NUM[size_index] * sizeof(UI::Ele) > budget) {
+    if (size_index == 0) {
+      this->stats_.throttled++;
+      return false;
+    }
+    size_index--;
+  }
+
+  const size_t FRAME_ELE_NUM = UI_FRAME_ELE_NUM[size_index];
+  if (num > FRAME_ELE_NUM) {
+    num = FRAME_ELE_NUM;
+  }
+
+  for (size_t i = 0; i < num; i++) {
+    Node<UI::Ele> &node = this->ele_[cand[i].index];
+
+    frame.ele[i] = node.data;
+    frame.ele[i].op = NodeOperation(node.state);
+
+    node.state = node.state == NODE_REMOVE ? NODE_FREE : NODE_CLEAN;
+    node.sent_time = now;
+  }
+
+  if (refresh) {
+    this->stats_.refresh += num;
+  } else {
+    this->stats_.sent += num;
+  }
+
+  /* 空余位置顺带重发最久未发送的图形，仍不足时以空操作补齐 */
+  if (num < FRAME_ELE_NUM) {
+    Candidate pad[UI_MAX_GRAPHIC_NUM];
+    const size_t PAD_NUM = this->CollectClean(this->ele_, this->ele_num_, now,
+                                              1, pad, FRAME_ELE_NUM - num);
+
+    for (size_t i = 0; i < PAD_NUM; i++) {
+      Node<UI::Ele> &node = this->ele_[pad[i].index];
+      frame.ele[num] = node.data;
+      frame.ele[num].op = UI::UI_GRAPHIC_OP_ADD;
+      node.sent_time = now;
+      num++;
+    }
+    this->stats_.refresh += PAD_NUM;
+
+    for (; num < FRAME_ELE_NUM; num++) {
+      memset(&frame.ele[num], 0, sizeof(UI::Ele));
+    }
+  }
+
+  frame.type = FRAME_ELE;
+  frame.ele_num = FRAME_ELE_NUM;
+  this->stats_.frame++;
+
+  return true;
+}
+
+bool UIScene::PackStr(Frame &frame, const Candidate &cand, uint32_t now,
+                      size_t budget, bool refresh) {
+  if (sizeof(UI::Str) > budget) {
+    this->stats_.throttled++;
+    return false;
+  }
+
+  Node<UI::Str> &node = this->str_[cand.index];
+
+  frame.str = node.data;
+  frame.str.graphic.op = NodeOperation(node.state);
+
+  node.state = node.state == NODE_REMOVE ? NODE_FREE : NODE_CLEAN;
+  node.sent_time = now;
+
+  if (refresh) {
+    this->stats_.refresh++;
+  } else {
+    this->stats_.sent++;
+  }
+
+  frame.type = FRAME_STR;
+  frame.ele_num = 0;
+  this->stats_.frame++;
+
+  return true;
+}
+
+bool UIScene::Next(Frame &frame, uint32_t now, size_t budget) {
+  frame.type = FRAME_NONE;
+
+  /* 删除必须先于之后在同一图层上的新增 */
+  if (this->del_num_ > 0) {
+    if (sizeof(UI::Del) > budget) {
+      this->stats_.throttled++;
+      return false;
+    }
+
+    frame.type = FRAME_DEL;
+    frame.ele_num = 0;
+    frame.del = this->del_[0];
+
+    this->del_num_--;
+    memmove(&this->del_[0], &this->del_[1],
+            this->del_num_ * sizeof(this->del_[0]));
+
+    this->stats_.del++;
+    this->stats_.frame++;
+    return true;
+  }
+
+  /* 先发送有变化的内容，没有时再重发超过刷新周期未发送的内容 */
+  for (int refresh = 0; refresh < 2; refresh++) {
+    Candidate ele[UI_MAX_GRAPHIC_NUM];
+    Candidate str;
+    size_t ele_num = 0, str_num = 0;
+
+    if (refresh) {
+      ele_num = this->CollectClean(this->ele_, this->ele_num_, now,
+                                   this->refresh_ms_, ele, UI_MAX_GRAPHIC_NUM);
+      str_num = this->CollectClean(this->str_, this->str_num_, now,
+                                   this->refresh_ms_, &str, 1);
+    } else {
+      ele_num = this->CollectDirty(this->ele_, this->ele_num_, now, ele,
+                                   UI_MAX_GRAPHIC_NUM);
+      str_num = this->CollectDirty(this->str_, this->str_num_, now, &str, 1);
+    }
+
+    if (ele_num == 0 && str_num == 0) {
+      continue;
+    }
+
+    /* 字符串每帧只能发送一个，与最急迫的图形比较 */
+    if (str_num > 0 && (ele_num == 0 || str.score >= ele[0].score)) {
+      return this->PackStr(frame, str, now, budget, refresh);
+    }
+
+    return this->PackEle(frame, ele, ele_num, now, budget, refresh);
+  }
+
+  return false;
+}
@@ -0,0 +1,127 @@
+/*
+  操作手UI场景。
+  以图形名为键保存每个图形的最新内容，与已发给客户端的内容比较，
+  只发送新增、修改与删除的部分，并按图层优先级与等待时间组帧。
+  空闲带宽与帧内空余位置用于重发最久未发送的图形，客户端重连后可自行恢复。
+*/
+
+#pragma once
+
+#include <component.hpp>
+
+#include "comp_ui.hpp"
+
+namespace Component {
+class UIScene {
+ public:
+  typedef enum {
+    FRAME_NONE,
+    FRAME_ELE,
+    FRAME_STR,
+    FRAME_DEL,
+  } FrameType;
+
+  typedef struct {
+    FrameType type;
+    uint8_t ele_num; /* 1/2/5/7，不足时以空操作补齐 */
+    union {
+      UI::Ele ele[UI_MAX_GRAPHIC_NUM];
+      UI::Str str;
+      UI::Del del;
+    };
+  } Frame;
+
+  typedef struct {
+    uint32_t sent;      /* 新增、修改或删除后发出的图形与字符串 */
+    uint32_t refresh;   /* 借空闲带宽重发的图形与字符串 */
+    uint32_t unchanged; /* 内容未变而省去的绘制 */
+    uint32_t merged;    /* 发送前被新内容覆盖的绘制 */
+    uint32_t dropped;   /* 场景已满或删除队列已满而丢弃的绘制 */
+    uint32_t del;       /* 发出的图层删除 */
+    uint32_t frame;     /* 生成的帧数 */
+    uint32_t throttled; /* 因带宽不足推迟发送的次数 */
+  } Stats;
+
+  /* refresh_ms为客户端上图形的最长重发间隔 */
+  UIScene(size_t ele_num, size_t str_num, uint32_t refresh_ms);
+
+  /* op为UI_GRAPHIC_OP_DEL时删除该图形，其余操作由场景根据客户端状态决定 */
+  bool Update(const UI::Ele &ele, uint32_t now);
+  bool Update(const UI::Str &str, uint32_t now);
+
+  bool Delete(const UI::Del &del);
+
+  /* 生成下一帧，budget为可用于数据段的字节数，没有可发送的内容时返回false */
+  bool Next(Frame &frame, uint32_t now, size_t budget);
+
+  /* 客户端重启后调用，所有图形重新以新增方式发送 */
+  void Invalidate();
+
+  /* 最早一个尚未发出的变化已等待的时间，单位ms */
+  uint32_t Backlog(uint32_t now);
+
+  size_t EleCount();
+  size_t StrCount();
+
+  const Stats &GetStats() { return this->stats_; }
+
+  void ResetStats() { memset(&this->stats_, 0, sizeof(this->stats_)); }
+
+ private:
+  typedef enum {
+    NODE_FREE,
+    NODE_CLEAN,  /* 客户端已是最新内容 */
+    NODE_ADD,    /* 客户端上可能没有该图形 */
+    NODE_MODIFY, /* 客户端上是旧内容 */
+    NODE_REMOVE, /* 等待从客户端删除 */
+  } NodeState;
+
+  template <typename T>
+  struct Node {
+    T data;
+    uint8_t state;
+    uint32_t dirty_time;
+    uint32_t sent_time;
+  };
+
+  typedef struct {
+    uint32_t index;
+    uint32_t score;
+  } Candidate;
+
+  /* 按分数从高到低插入，只保留前max个 */
+  static size_t Insert(Candidate *out, size_t count, size_t max,
+                       uint32_t index, uint32_t score);
+
+  static uint8_t NodeOperation(uint8_t state);
+
+  template <typename T>
+  bool Store(Node<T> *nodes, size_t num, const T &data, uint32_t now);
+
+  template <typename T>
+  size_t CollectDirty(Node<T> *nodes, size_t num, uint32_t now, Candidate *out,
+                      size_t max);
+
+  template <typename T>
+  size_t CollectClean(Node<T> *nodes, size_t num, uint32_t now,
+                      uint32_t min_age, Candidate *out, size_t max);
+
+  bool PackEle(Frame &frame, Candidate *cand, size_t num, uint32_t now,
+               size_t budget, bool refresh);
+
+  bool PackStr(Frame &frame, const Candidate &cand, uint32_t now,
+               size_t budget, bool refresh);
+
+  size_t ele_num_;
+  size_t str_num_;
+  uint32_t refresh_ms_;
+
+  Node<UI::Ele> *ele_;
+  Node<UI::Str> *str_;
+
+  UI::Del del_[UI_MAX_DEL_NUM];
+  size_t del_num_ = 0;
+
+  Stats stats_{};
+};
+}  // namespace Component
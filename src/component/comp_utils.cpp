@@ -100,20 +100,3 @@ float bullet_speed_to_fric_rpm(float bullet_speed, float fric_radius,
   /* 不为裁判系统设定值时,计算转速 */
   return 60.0f * bullet_speed / (M_2PI * fric_radius);
 }
-
-int float_to_uint(float x, float x_min, float x_max, int bits) {
-  /// Converts a float to an unsigned int, given range and number of bits ///
-  float span = x_max - x_min;
-  float offset = x_min;
-  return static_cast<int>((x - offset) * (static_cast<float>((1 << bits) - 1)) /
-                          span);
-}
-
-float uint_to_float(int x_int, float x_min, float x_max, int bits) {
-  /// converts unsigned int to float, given range and number of bits ///
-  float span = x_max - x_min;
-  float offset = x_min;
-  return (static_cast<float>(x_int)) * span /
-             (static_cast<float>((1 << bits) - 1)) +
-         offset;
-}
@@ -99,6 +99,16 @@ float signf(float x);
 float bullet_speed_to_fric_rpm(float bullet_speed, float fric_radius,
                                bool is17mm);
 
-int float_to_uint(float x, float x_min, float x_max, int bits);
-
-float uint_to_float(int x_int, float x_min, float x_max, int bits);
+/* 内联后范围和位数为常量时比例系数在编译期算出，运行时只剩一次乘法 */
+static inline int float_to_uint(float x, float x_min, float x_max, int bits) {
+  /// Converts a float to an unsigned int, given range and number of bits ///
+  const float SCALE = static_cast<float>((1 << bits) - 1) / (x_max - x_min);
+  return static_cast<int>((x - x_min) * SCALE);
+}
+
+static inline float uint_to_float(int x_int, float x_min, float x_max,
+                                  int bits) {
+  /// converts unsigned int to float, given range and number of bits ///
+  const float SCALE = (x_max - x_min) / static_cast<float>((1 << bits) - 1);
+  return static_cast<float>(x_int) * SCALE + x_min;
+}
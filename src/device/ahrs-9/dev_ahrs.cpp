@@ -21,10 +21,15 @@ AHRS::AHRS()
   this->quat_.q2 = 0.0f;
   this->quat_.q3 = 0.0f;
 
+  Component::TopicRegistry<Component::TopicHash("imu_quat")>::Register(
+      this->quat_tp_);
+  Component::TopicRegistry<Component::TopicHash("imu_eulr")>::Register(
+      this->eulr_tp_);
+
   auto ahrs_thread = [](AHRS *ahrs) {
-    Message::Subscriber<Component::Type::Vector3> accl_sub("imu_accl");
-    Message::Subscriber<Component::Type::Vector3> gyro_sub("imu_gyro");
-    Message::Subscriber<Component::Type::Vector3> magn_sub("magn");
+    Component::StaticSubscriber<Component::TopicHash("imu_accl")> accl_sub;
+    Component::StaticSubscriber<Component::TopicHash("imu_gyro")> gyro_sub;
+    Component::StaticSubscriber<Component::TopicHash("magn")> magn_sub;
 
     System::Thread::Sleep(10);
 
@@ -36,9 +41,8 @@ AHRS::AHRS()
       return true;
     };
 
-    (Message::Topic<Component::Type::Vector3>(
-         Message::Topic<Component::Type::Vector3>::Find("imu_gyro")))
-        .RegisterCallback(gyro_cb, ahrs);
+    Component::TopicRegistry<
+        Component::TopicHash("imu_gyro")>::RegisterCallback(gyro_cb, ahrs);
 
     float yaw = -atan2f(ahrs->magn_.y, ahrs->magn_.x);
 
@@ -22,62 +22,58 @@ AHRS::AHRS()
   this->quat_.q2 = 0.0f;
   this->quat_.q3 = 0.0f;
 
-  auto ahrs_thread = [](AHRS *ahrs) {
-    Message::Subscriber<Component::Type::Vector3> accl_sub("imu_accl");
-    Message::Subscriber<Component::Type::Vector3> gyro_sub("imu_gyro");
-
-    auto accl_cb = [](Component::Type::Vector3 &accl, AHRS *ahrs) {
-      static_cast<void>(accl);
-
-      ahrs->ready_.Post();
+  Component::TopicRegistry<Component::TopicHash("imu_quat")>::Register(
+      this->quat_tp_);
+  Component::TopicRegistry<Component::TopicHash("imu_eulr")>::Register(
+      this->eulr_tp_);
 
-      ahrs->accl_ready_.Post();
+  auto accl_cb = [](Component::Type::Vector3 &accl, AHRS *ahrs) {
+    static_cast<void>(accl);
 
-      return true;
-    };
+    ahrs->ready_.Post();
 
-    auto gyro_cb = [](Component::Type::Vector3 &gyro, AHRS *ahrs) {
-      static_cast<void>(gyro);
+    ahrs->accl_ready_.Post();
 
-      ahrs->ready_.Post();
+    return true;
+  };
 
-      ahrs->gyro_ready_.Post();
+  auto gyro_cb = [](Component::Type::Vector3 &gyro, AHRS *ahrs) {
+    static_cast<void>(gyro);
 
-      return true;
-    };
+    ahrs->ready_.Post();
 
-    (Message::Topic<Component::Type::Vector3>(
-         Message::Topic<Component::Type::Vector3>::Find("imu_accl")))
-        .RegisterCallback(accl_cb, ahrs);
+    ahrs->gyro_ready_.Post();
 
-    (Message::Topic<Component::Type::Vector3>(
-         Message::Topic<Component::Type::Vector3>::Find("imu_gyro")))
-        .RegisterCallback(gyro_cb, ahrs);
+    return true;
+  };
 
-    System::Thread::Sleep(10);
+  /* IMU尚未构造时回调会在其登记话题后挂上 */
+  Component::TopicRegistry<Component::TopicHash("imu_accl")>::RegisterCallback(
+      accl_cb, this);
 
-    while (1) {
-      ahrs->ready_.Wait(UINT32_MAX);
+  Component::TopicRegistry<Component::TopicHash("imu_gyro")>::RegisterCallback(
+      gyro_cb, this);
 
-      if (ahrs->accl_ready_.Wait(0)) {
-        accl_sub.DumpData(ahrs->accl_);
-      }
-      if (ahrs->gyro_ready_.Wait(0)) {
-        gyro_sub.DumpData(ahrs->gyro_);
-      }
+  auto ahrs_thread = [](AHRS *ahrs) {
+    if (ahrs->accl_ready_.Wait(0)) {
+      ahrs->accl_sub_.DumpData(ahrs->accl_);
+    }
+    if (ahrs->gyro_ready_.Wait(0)) {
+      ahrs->gyro_sub_.DumpData(ahrs->gyro_);
+    }
 
-      ahrs->Update();
+    ahrs->Update();
 
-      /* 根据解析出来的四元数计算欧拉角 */
-      ahrs->GetEulr();
-      /* 发布数据 */
-      ahrs->quat_tp_.Publish(ahrs->quat_);
-      ahrs->eulr_tp_.Publish(ahrs->eulr_);
-    }
+    /* 根据解析出来的四元数计算欧拉角 */
+    ahrs->GetEulr();
+    /* 发布数据 */
+    ahrs->quat_tp_.Publish(ahrs->quat_);
+    ahrs->eulr_tp_.Publish(ahrs->eulr_);
   };
 
-  this->thread_.Create(ahrs_thread, this, "ahrs_thread",
-                       DEVICE_AHRS_TASK_STACK_DEPTH, System::Thread::HIGH);
+  this->thread_.CreateEvent(ahrs_thread, this, "ahrs_thread",
+                            DEVICE_AHRS_TASK_STACK_DEPTH, System::Thread::HIGH,
+                            this->ready_);
 }
 
 int AHRS::ShowCMD(AHRS *ahrs, int argc, char **argv) {
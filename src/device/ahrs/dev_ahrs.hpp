@@ -40,5 +40,8 @@ class AHRS {
   System::Semaphore accl_ready_;
   System::Semaphore gyro_ready_;
   System::Semaphore ready_;
+
+  Component::StaticSubscriber<Component::TopicHash("imu_accl")> accl_sub_;
+  Component::StaticSubscriber<Component::TopicHash("imu_gyro")> gyro_sub_;
 };
 }  // namespace Device
@@ -7,73 +7,172 @@
 
 #define AI_CMD_LIMIT (0.08f)
 #define AI_CTRL_SENSE (1.0f / 90.0f)
+#define AI_SCANF_STEP_MS (2.0f) /* scanf_yaw_rate为每2ms的增量 */
+#define AI_SCANF_MAX_DT_MS (50.0f)
+#define AI_RX_RESTART_TIMEOUT (20)
+#if DEVICE_AI_TIME_SYNC
+#define AI_LEN_RX_BUFF (sizeof(Protocol_DownPackage_t) + sizeof(AI::HostSync))
+#define AI_LEN_SYNC (sizeof(AI::MCUSync))
+#else
 #define AI_LEN_RX_BUFF (sizeof(Protocol_DownPackage_t))
+#define AI_LEN_SYNC (0)
+#endif
+#if DEVICE_AI_TLV_UPLINK
+#define AI_TX_TIMEOUT (10) /* 发送完成中断丢失时解除占用 */
 #define AI_LEN_TX_BUFF \
-  (sizeof(Protocol_UpPackageMCU_t) + sizeof(Protocol_UpPackageReferee_t))
+  (Component::TLVFrame::MaxEncodedSize(AI::UPLINK_FRAME_SIZE))
+#else
+/* 发送缓冲区包含数据包的id */
+#define AI_LEN_TX_BUFF \
+  (sizeof(AI::MCUPckage) + sizeof(AI::RefereePckage) + AI_LEN_SYNC)
+#endif
+
+using namespace Device;
 
 static uint8_t rxbuf[AI_LEN_RX_BUFF];
 static uint8_t txbuf[AI_LEN_TX_BUFF];
 
-using namespace Device;
+#if DEVICE_AI_TIME_SYNC
+/* 上行时间戳只有低32位，按当前时间还原 */
+static uint64_t ai_unwrap_time(uint32_t time) {
+  const uint64_t NOW = bsp_time_get();
+  return NOW - static_cast<uint32_t>(static_cast<uint32_t>(NOW) - time);
+}
+#endif
 
 AI::AI(bool autoscan_enable)
     : autoscan_enable_(autoscan_enable),
       event_(Message::Event::FindEvent("cmd_event")),
       cmd_tp_("cmd_ai"),
-      data_ready_(false) {
+      data_ready_(false),
+      ctrl_lock_(true),
+      term_cmd_(this, AI::ShowCMD, "AI", System::Term::DevDir()) {
   auto rx_cplt_callback = [](void *arg) {
     AI *ai = static_cast<AI *>(arg);
+    ai->rx_time_ = bsp_time_get();
     ai->data_ready_.Post();
   };
 
   bsp_uart_register_callback(BSP_UART_AI, BSP_UART_RX_CPLT_CB, rx_cplt_callback,
                              this);
 
+#if DEVICE_AI_TLV_UPLINK
+  auto tx_cplt_callback = [](void *arg) {
+    AI *ai = static_cast<AI *>(arg);
+    ai->tx_busy_ = false;
+  };
+
+  bsp_uart_register_callback(BSP_UART_AI, BSP_UART_TX_CPLT_CB, tx_cplt_callback,
+                             this);
+#endif
+
   Component::CMD::RegisterController(this->cmd_tp_);
 
-  auto ai_thread = [](AI *ai) {
-    auto quat_sub =
-        Message::Subscriber<Component::Type::Quaternion>("imu_quat");
-    auto ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
-    auto yaw_sub = Message::Subscriber<float>("chassis_yaw");
+  /* 上位机指令经CMD转发到云台时记录延迟 */
+  auto gimbal_cmd_callback = [](Component::CMD::GimbalCMD &cmd, AI *ai) {
+    XB_UNUSED(cmd);
 
-    auto eulr_sub = Message::Subscriber<Component::Type::Eulr>("imu_eulr");
+    if (ai->latency_pending_) {
+      ai->latency_pending_ = false;
+      ai->RecordLatency();
+    }
 
-    while (1) {
-      /* 接收云台数据 */
-      yaw_sub.DumpData(ai->chassis_yaw_offset_);
-      eulr_sub.DumpData(ai->eulr_); /* imu */
+    return true;
+  };
 
-      /* 接收裁判系统数据 */
-      if (ref_sub.DumpData(ai->raw_ref_)) {
-        ai->PraseRef();
-        ai->PackRef();
-      }
-      /* 接收上位机数据 */
-      ai->StartRecv();
-      if (ai->data_ready_.Wait(0)) {
-        ai->PraseHost();
-      } else {
-        ai->Offline();
-      }
+  Component::TopicRegistry<Component::TopicHash("cmd_gimbal")>::
+      RegisterCallback(gimbal_cmd_callback, this);
+
+  /* 上行姿态按发布时刻打时间戳，与姿态历史使用同一时基 */
+  auto quat_callback = [](Component::Type::Quaternion &quat, AI *ai) {
+    ai->quat_snapshot_.Publish({static_cast<uint32_t>(bsp_time_get()), quat});
+    return true;
+  };
+
+  Component::TopicRegistry<Component::TopicHash("imu_quat")>::RegisterCallback(
+      quat_callback, this);
+
+#if DEVICE_AI_POSE_COMPENSATE
+  /* 在姿态发布时记录，时间戳与采样时刻相差一个解算周期以内 */
+  auto eulr_callback = [](Component::Type::Eulr &eulr, AI *ai) {
+    ai->pose_history_.Push(bsp_time_get(), eulr);
+    return true;
+  };
+
+  Component::TopicRegistry<Component::TopicHash("imu_eulr")>::RegisterCallback(
+      eulr_callback, this);
+#endif
+
+  /* 接收完成后立即校验并发布控制指令 */
+  auto rx_thread = [](AI *ai) {
+    ai->ctrl_lock_.Wait(UINT32_MAX);
+
+    bool online = ai->PraseHost();
+    ai->StartRecv();
+
+    if (online) {
+      ai->yaw_sub_.DumpData(ai->chassis_yaw_offset_);
+      ai->eulr_sub_.DumpData(ai->eulr_); /* imu */
 
-      /* 决策与命令发布 */
       ai->DecideAction();
+      ai->latency_pending_ = true;
       ai->PackCMD();
-      ai->ai_tp_.Publish(ai->cmd_for_ref_);
+      ai->latency_pending_ = false;
 
-      /* 发送数据到上位机 */
-      quat_sub.DumpData(ai->quat_);
-      ai->PackMCU();
+      ai->host_updated_ = true;
+    }
+
+    ai->ctrl_lock_.Post();
+  };
+
+  this->rx_thread_.CreateEvent(rx_thread, this, "ai_rx_thread",
+                               DEVICE_AI_TASK_STACK_DEPTH,
+                               System::Thread::REALTIME, this->data_ready_);
+
+  /* 按上行周期发送数据，上位机没有新数据时维持离线判断与扫描 */
+  auto tx_thread = [](AI *ai) {
+    ai->ctrl_lock_.Wait(UINT32_MAX);
 
-      ai->StartTrans();
+    /* 接收云台数据 */
+    ai->yaw_sub_.DumpData(ai->chassis_yaw_offset_);
+    ai->eulr_sub_.DumpData(ai->eulr_); /* imu */
+
+    /* 接收裁判系统数据 */
+    if (ai->raw_ref_.Update()) {
+      ai->PraseRef();
+      ai->PackRef();
+    }
+
+    /* 一段时间没有收到有效数据时重新开始接收 */
+    if (bsp_time_get_ms() - ai->last_online_time_ > AI_RX_RESTART_TIMEOUT) {
+      ai->StartRecv();
+    }
 
-      System::Thread::Sleep(2);
+    /* 决策与命令发布 */
+    if (!ai->host_updated_) {
+      ai->Offline();
+      ai->DecideAction();
+      ai->PackCMD();
     }
+    ai->host_updated_ = false;
+
+    ai->ai_tp_.Publish(ai->cmd_for_ref_);
+
+    /* 发送数据到上位机 */
+    StampedQuat pose;
+    ai->quat_snapshot_.Read(pose);
+    ai->quat_ = pose.quat;
+    ai->quat_time_ = pose.time;
+    ai->PackMCU();
+
+    ai->StartTrans();
+
+    ai->ctrl_lock_.Post();
   };
 
-  this->thread_.Create(ai_thread, this, "ai_thread", DEVICE_AI_TASK_STACK_DEPTH,
-                       System::Thread::REALTIME);
+  this->tx_thread_.CreatePeriodic(
+      tx_thread, this, "ai_tx_thread", DEVICE_AI_TASK_STACK_DEPTH,
+      System::Thread::REALTIME, DEVICE_AI_UPLINK_CYCLE);
 }
 
 bool AI::StartRecv() {
@@ -85,12 +184,91 @@ bool AI::PraseHost() {
     this->cmd_.online = true;
     this->last_online_time_ = bsp_time_get_ms();
     memcpy(&(this->from_host_), rxbuf, sizeof(this->from_host_));
+#if DEVICE_AI_TIME_SYNC
+    this->PraseSync();
+#endif
     memset(rxbuf, 0, AI_LEN_RX_BUFF);
+    this->stats_.rx_count++;
     return true;
   }
+  this->stats_.crc_err_count++;
   return false;
 }
 
+#if DEVICE_AI_TLV_UPLINK
+bool AI::QueueUplink(UplinkMessage &msg, const void *data) {
+  const uint32_t NOW = bsp_time_get_ms();
+
+  if (msg.keepalive != 0 && msg.sent &&
+      memcmp(msg.last, data, msg.len) == 0 &&
+      NOW - msg.last_time < msg.keepalive) {
+    return false;
+  }
+
+  if (!this->frame_.Append(msg.type, data, msg.len)) {
+    return false;
+  }
+
+  memcpy(msg.last, data, msg.len);
+  msg.last_time = NOW;
+  msg.sent = true;
+
+  return true;
+}
+
+bool AI::StartTrans() {
+  /* 上一帧仍在发送时保留待发消息，下个周期一并发出 */
+  if (this->tx_busy_ &&
+      bsp_time_get_ms() - this->tx_start_time_ < AI_TX_TIMEOUT) {
+    this->stats_.tx_busy_count++;
+    return false;
+  }
+
+  this->frame_.Reset(this->tx_seq_);
+
+#if DEVICE_AI_TIME_SYNC
+  const UplinkSync SYNC = {static_cast<uint32_t>(bsp_time_get()),
+                           this->quat_time_};
+  this->QueueUplink(this->sync_msg_, &SYNC);
+#endif
+
+  /* 姿态每个周期都发送，其余消息只在变化或到期时发送 */
+  this->QueueUplink(this->quat_msg_, &this->quat_);
+  this->QueueUplink(this->notice_msg_, &this->notice_for_ai_);
+
+  const float BALL_SPEED = static_cast<float>(this->ref_.ball_speed);
+  this->QueueUplink(this->ball_speed_msg_, &BALL_SPEED);
+
+  UplinkReferee referee;
+  referee.arm = this->ref_.robot_id;
+  referee.rfid = this->ref_.robot_buff;
+  referee.team = this->ref_.team;
+  referee.race = this->ref_.game_type;
+  this->QueueUplink(this->referee_msg_, &referee);
+
+  if (this->frame_.Empty()) {
+    return true;
+  }
+
+  const size_t LEN = this->frame_.Encode(txbuf, sizeof(txbuf));
+  if (LEN == 0) {
+    return false;
+  }
+
+  this->tx_seq_++;
+  this->tx_busy_ = true;
+  this->tx_start_time_ = bsp_time_get_ms();
+  this->stats_.uplink_count++;
+  this->stats_.tx_bytes += LEN;
+
+  if (bsp_uart_transmit(BSP_UART_AI, txbuf, LEN, false) != BSP_OK) {
+    this->tx_busy_ = false;
+    return false;
+  }
+
+  return true;
+}
+#else
 bool AI::StartTrans() {
   size_t len = sizeof(this->to_host_.mcu);
   void *src = NULL;
@@ -103,8 +281,22 @@ bool AI::StartTrans() {
   this->ref_updated_ = false;
 
   memcpy(txbuf, src, len);
+
+#if DEVICE_AI_TIME_SYNC
+  MCUSync sync;
+  sync.time = static_cast<uint32_t>(bsp_time_get());
+  sync.pose_time = this->quat_time_;
+  sync.crc16 = Component::CRC16::Calculate(
+      reinterpret_cast<const uint8_t *>(&sync), sizeof(sync) - sizeof(uint16_t),
+      CRC16_INIT);
+  memcpy(txbuf + len, &sync, sizeof(sync));
+  len += sizeof(sync);
+#endif
+  this->stats_.uplink_count++;
+  this->stats_.tx_bytes += len;
   return bsp_uart_transmit(BSP_UART_AI, txbuf, len, false) == BSP_OK;
 }
+#endif
 
 bool AI::Offline() {
   /* 离线移交控制权 */
@@ -164,12 +356,15 @@ void AI::DecideAction() {
   memcpy(&(this->last_auto_aim_eulr_), &(this->cmd_.gimbal.eulr),
          sizeof(this->cmd_.gimbal.eulr));
 
+  /* 是否更新按上位机原始角度判断，判断后再加补偿 */
+  this->SetGimbalFromHost();
+
   /* 判定是否受击打，一定时间内第一次受击打方向优先级最高 */
-  if (this->raw_ref_.robot_damage.damage_type == 0x0 &&
-      (this->raw_ref_.robot_damage.damage_type != damage_.type_) &&
+  if (this->raw_ref_->robot_damage.damage_type == 0x0 &&
+      (this->raw_ref_->robot_damage.damage_type != damage_.type_) &&
       (damage_.is_damaged_ == false)) {
     this->damage_.is_damaged_ = true;
-    this->damage_.id_ = this->raw_ref_.robot_damage.armor_id;
+    this->damage_.id_ = this->raw_ref_->robot_damage.armor_id;
     this->damage_.yaw_offset_ = this->chassis_yaw_offset_;
     this->damage_.gimbal_yaw_ = this->eulr_.yaw;
     this->damage_.time_ = bsp_time_get_ms();
@@ -261,8 +456,7 @@ bool AI::PackCMD() {
 
       switch (this->action_.ai_gimbal) {
         case AUTO_AIM:
-          memcpy(&(this->cmd_.gimbal.eulr), &(this->from_host_.data.gimbal),
-                 sizeof(this->cmd_.gimbal.eulr));
+          this->SetGimbalFromHost();
           break;
         case AFFECTED:
           this->cmd_.gimbal.eulr.yaw = this->damage_.gimbal_yaw_ +
@@ -273,8 +467,17 @@ bool AI::PackCMD() {
               this->eulr_.yaw;            /* 更新yaw扫描的起始位置 */
           this->target_scan_angle_ = 0.0; /* 置零yaw扫描的位置增量 */
           break;
-        case SCANF:
-          this->target_scan_angle_ += this->scanf_mode_.scanf_yaw_rate;
+        case SCANF: {
+          /* 按经过的时间扫描，与指令发布的频率无关 */
+          const uint64_t NOW = bsp_time_get();
+          float dt = static_cast<float>(NOW - this->scan_time_) / 1000.0f;
+          this->scan_time_ = NOW;
+          if (dt > AI_SCANF_MAX_DT_MS) {
+            dt = AI_SCANF_STEP_MS;
+          }
+
+          this->target_scan_angle_ +=
+              this->scanf_mode_.scanf_yaw_rate * dt / AI_SCANF_STEP_MS;
           this->cmd_.gimbal.eulr.yaw =
               this->target_scan_angle_ + this->gimbal_scan_start_angle_;
           this->cmd_.gimbal.eulr.pit =
@@ -283,6 +486,7 @@ bool AI::PackCMD() {
                   sinf(this->scanf_mode_.scanf_pit_omega *
                        static_cast<float>(bsp_time_get_ms()) / 1000.0f);
           break;
+        }
       }
 
       switch (this->action_.ai_launcher) {
@@ -328,8 +532,7 @@ bool AI::PackCMD() {
     }
     /* OP控制模式，用于鼠标右键自瞄 */
     else if (Component::CMD::GetCtrlMode() == Component::CMD::CMD_OP_CTRL) {
-      memcpy(&(this->cmd_.gimbal.eulr), &(this->from_host_.data.gimbal),
-             sizeof(this->cmd_.gimbal.eulr));
+      this->SetGimbalFromHost();
 
       memcpy(&(this->cmd_.ext.extern_channel),
              &(this->from_host_.data.extern_channel),
@@ -362,26 +565,26 @@ void AI::PraseRef() {
 #endif
 
                           this->ref_.max_hp =
-      this->raw_ref_.robot_status.max_hp;
+      this->raw_ref_->robot_status.max_hp;
 
-  this->ref_.hp = this->raw_ref_.robot_status.remain_hp;
+  this->ref_.hp = this->raw_ref_->robot_status.remain_hp;
 
-  if (this->raw_ref_.robot_status.robot_id < Referee::REF_BOT_BLU_HERO) {
+  if (this->raw_ref_->robot_status.robot_id < Referee::REF_BOT_BLU_HERO) {
     this->ref_.team = AI_TEAM_RED;
   } else {
     this->ref_.team = AI_TEAM_BLUE;
   }
-  this->ref_.status = this->raw_ref_.status;
+  this->ref_.status = this->raw_ref_->status;
 
-  if (this->raw_ref_.rfid.own_highland_annular == 1 ||
-      this->raw_ref_.rfid.enemy_highland_annular == 1) {
+  if (this->raw_ref_->rfid.own_highland_annular == 1 ||
+      this->raw_ref_->rfid.enemy_highland_annular == 1) {
     this->ref_.robot_buff |= AI_RFID_SNIP;
-  } else if (this->raw_ref_.rfid.own_energy_mech_activation == 1) {
+  } else if (this->raw_ref_->rfid.own_energy_mech_activation == 1) {
     this->ref_.robot_buff |= AI_RFID_BUFF;
   } else {
     this->ref_.robot_buff = 0;
   }
-  switch (this->raw_ref_.game_status.game_type) {
+  switch (this->raw_ref_->game_status.game_type) {
     case Referee::REF_GAME_TYPE_RMUC:
       this->ref_.game_type = AI_RACE_RMUC;
       break;
@@ -398,7 +601,7 @@ void AI::PraseRef() {
       return;
   }
 
-  switch (this->raw_ref_.robot_status.robot_id % 100) {
+  switch (this->raw_ref_->robot_status.robot_id % 100) {
     case Referee::REF_BOT_RED_HERO:
       this->ref_.robot_id = AI_ARM_HERO;
       break;
@@ -418,28 +621,155 @@ void AI::PraseRef() {
       this->ref_.robot_id = AI_ARM_INFANTRY;
   }
 
-  this->ref_.game_progress = this->raw_ref_.game_status.game_progress;
+  this->ref_.game_progress = this->raw_ref_->game_status.game_progress;
 
-  if (this->raw_ref_.robot_status.robot_id < 100) {
-    this->ref_.base_hp = this->raw_ref_.game_robot_hp.red_base;
-    this->ref_.outpost_hp = this->raw_ref_.game_robot_hp.red_outpose;
+  if (this->raw_ref_->robot_status.robot_id < 100) {
+    this->ref_.base_hp = this->raw_ref_->game_robot_hp.red_base;
+    this->ref_.outpost_hp = this->raw_ref_->game_robot_hp.red_outpose;
     this->ref_.own_virtual_shield_value =
-        this->raw_ref_.field_event.virtual_shield_value;
+        this->raw_ref_->field_event.virtual_shield_value;
   } else {
-    this->ref_.base_hp = this->raw_ref_.game_robot_hp.blue_base;
-    this->ref_.outpost_hp = this->raw_ref_.game_robot_hp.blue_outpose;
+    this->ref_.base_hp = this->raw_ref_->game_robot_hp.blue_base;
+    this->ref_.outpost_hp = this->raw_ref_->game_robot_hp.blue_outpose;
     this->ref_.own_virtual_shield_value =
-        this->raw_ref_.field_event.virtual_shield_value;
+        this->raw_ref_->field_event.virtual_shield_value;
   }
-  this->ref_.coin_num = this->raw_ref_.bullet_remain.coin_remain;
-  this->ref_.pos_x = this->raw_ref_.robot_pos.x;
-  this->ref_.pos_y = this->raw_ref_.robot_pos.y;
-  this->ref_.pos_angle = this->raw_ref_.robot_pos.angle;
+  this->ref_.coin_num = this->raw_ref_->bullet_remain.coin_remain;
+  this->ref_.pos_x = this->raw_ref_->robot_pos.x;
+  this->ref_.pos_y = this->raw_ref_->robot_pos.y;
+  this->ref_.pos_angle = this->raw_ref_->robot_pos.angle;
+
+  this->ref_.target_pos_x = this->raw_ref_->client_map.position_x;
+  this->ref_.target_pos_y = this->raw_ref_->client_map.position_y;
 
-  this->ref_.target_pos_x = this->raw_ref_.client_map.position_x;
-  this->ref_.target_pos_y = this->raw_ref_.client_map.position_y;
+  if (this->raw_ref_->robot_damage.damage_type == 0) {
+    this->ref_.damaged_armor_id = this->raw_ref_->robot_damage.armor_id;
+  }
+}
 
-  if (this->raw_ref_.robot_damage.damage_type == 0) {
-    this->ref_.damaged_armor_id = this->raw_ref_.robot_damage.armor_id;
+bool AI::PraseSync() {
+#if DEVICE_AI_POSE_COMPENSATE
+  this->pose_delta_[0] = 0.0f;
+  this->pose_delta_[1] = 0.0f;
+#endif
+
+#if DEVICE_AI_TIME_SYNC
+  HostSync sync;
+  memcpy(&sync, rxbuf + sizeof(this->from_host_), sizeof(sync));
+
+  if (!Component::CRC16::Verify(reinterpret_cast<const uint8_t *>(&sync),
+                                sizeof(sync))) {
+    this->stats_.sync_err_count++;
+    return false;
   }
+
+  memcpy(&this->host_sync_, &sync, sizeof(sync));
+
+  /* 上位机尚未收到上行数据时没有可用的往返样本 */
+  if (sync.origin_time != 0) {
+    this->clock_sync_.Update(ai_unwrap_time(sync.origin_time),
+                             sync.receive_time, sync.transmit_time,
+                             this->rx_time_);
+  }
+
+#if DEVICE_AI_POSE_COMPENSATE
+  if (this->Compensate()) {
+    this->stats_.compensate_count++;
+  } else {
+    this->stats_.compensate_miss++;
+  }
+#endif
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool AI::Compensate() {
+#if DEVICE_AI_POSE_COMPENSATE
+  const HostSync &sync = this->host_sync_;
+
+  const uint64_t POSE_TIME = ai_unwrap_time(sync.pose_time);
+  const uint64_t FRAME_TIME = this->rx_time_ - sync.frame_delay;
+
+  Component::PoseHistory<DEVICE_AI_POSE_HISTORY_NUM>::Pose used, actual;
+  if (!this->pose_history_.Lookup(POSE_TIME, used) ||
+      !this->pose_history_.Lookup(FRAME_TIME, actual)) {
+    return false;
+  }
+
+  /* 上位机按解算时的姿态给出绝对角度，补上曝光时刻与之的差值 */
+  this->pose_delta_[0] =
+      Component::Type::CycleValue::WrapDiff(actual.yaw - used.yaw);
+  this->pose_delta_[1] =
+      Component::Type::CycleValue::WrapDiff(actual.pit - used.pit);
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AI::SetGimbalFromHost() {
+  memcpy(&(this->cmd_.gimbal.eulr), &(this->from_host_.data.gimbal),
+         sizeof(this->cmd_.gimbal.eulr));
+
+#if DEVICE_AI_POSE_COMPENSATE
+  this->cmd_.gimbal.eulr.yaw += this->pose_delta_[0];
+  this->cmd_.gimbal.eulr.pit += this->pose_delta_[1];
+#endif
+}
+
+void AI::RecordLatency() {
+  const uint32_t LATENCY =
+      static_cast<uint32_t>(bsp_time_get() - this->rx_time_);
+
+  this->stats_.latency_count++;
+  this->stats_.latency_last = LATENCY;
+  this->stats_.latency_sum += LATENCY;
+  if (LATENCY > this->stats_.latency_max) {
+    this->stats_.latency_max = LATENCY;
+  }
+}
+
+int AI::ShowCMD(AI *ai, int argc, char **argv) {
+  if (argc == 1) {
+    printf("[stats] 打印收发计数与上位机到云台指令的延迟\r\n");
+    printf("[reset] 清零统计\r\n");
+#if DEVICE_AI_TIME_SYNC
+    printf("[sync]  打印与上位机的时钟偏差、往返时间与抖动\r\n");
+#endif
+  } else if (argc == 2) {
+    if (strcmp(argv[1], "stats") == 0) {
+      printf("rx:%lu crc_err:%lu uplink:%lu bytes:%lu busy:%lu\r\n",
+             static_cast<unsigned long>(ai->stats_.rx_count),
+             static_cast<unsigned long>(ai->stats_.crc_err_count),
+             static_cast<unsigned long>(ai->stats_.uplink_count),
+             static_cast<unsigned long>(ai->stats_.tx_bytes),
+             static_cast<unsigned long>(ai->stats_.tx_busy_count));
+
+      const uint32_t COUNT = ai->stats_.latency_count;
+      printf("latency(us) count:%lu last:%lu avg:%lu max:%lu\r\n",
+             static_cast<unsigned long>(COUNT),
+             static_cast<unsigned long>(ai->stats_.latency_last),
+             static_cast<unsigned long>(
+                 COUNT > 0 ? ai->stats_.latency_sum / COUNT : 0),
+             static_cast<unsigned long>(ai->stats_.latency_max));
+#if DEVICE_AI_TIME_SYNC
+      printf("sync_err:%lu compensate:%lu miss:%lu\r\n",
+             static_cast<unsigned long>(ai->stats_.sync_err_count),
+             static_cast<unsigned long>(ai->stats_.compensate_count),
+             static_cast<unsigned long>(ai->stats_.compensate_miss));
+#endif
+    } else if (strcmp(argv[1], "reset") == 0) {
+      memset(&ai->stats_, 0, sizeof(ai->stats_));
+#if DEVICE_AI_TIME_SYNC
+    } else if (strcmp(argv[1], "sync") == 0) {
+      ai->clock_sync_.PrintInfo();
+#endif
+    }
+  }
+
+  return 0;
 }
@@ -2,11 +2,19 @@
 
 #include <device.hpp>
 
+#include "comp_clock_sync.hpp"
 #include "comp_cmd.hpp"
+#include "comp_pose_history.hpp"
+#include "comp_snapshot.hpp"
+#include "comp_tlv.hpp"
 #include "dev_ahrs.hpp"
 #include "dev_referee.hpp"
 #include "protocol.h"
 
+#ifndef DEVICE_AI_POSE_HISTORY_NUM
+#define DEVICE_AI_POSE_HISTORY_NUM (256)
+#endif
+
 namespace Device {
 class AI {
  public:
@@ -20,6 +28,57 @@ class AI {
     Protocol_UpPackageMCU_t package;
   } MCUPckage;
 
+  /* 附在上行数据之后，发送时刻用于时钟同步，采样时刻用于补偿姿态 */
+  typedef struct __attribute__((packed)) {
+    uint32_t time;      /* 发送时刻(us) */
+    uint32_t pose_time; /* 所带姿态的采样时刻(us) */
+    uint16_t crc16;
+  } MCUSync;
+
+  /* 附在下行数据之后，用于时钟同步与补偿上位机处理期间的姿态变化 */
+  typedef struct __attribute__((packed)) {
+    uint32_t origin_time;   /* 最近收到的MCUSync.time */
+    uint64_t receive_time;  /* 上位机收到该MCUSync的时刻(上位机时钟) */
+    uint64_t transmit_time; /* 上位机发送本包的时刻(上位机时钟) */
+    uint32_t pose_time;     /* 解算时使用的姿态，回传MCUSync.pose_time */
+    uint32_t frame_delay;   /* 图像曝光到指令发出经过的时间(us) */
+    uint16_t crc16;
+  } HostSync;
+
+  /* TLV上行的消息类型 */
+  typedef enum : uint8_t {
+    UPLINK_QUAT = 0x01,
+    UPLINK_NOTICE = 0x02,
+    UPLINK_BALL_SPEED = 0x03,
+    UPLINK_REFEREE = 0x04,
+    UPLINK_SYNC = 0x05, /* UplinkSync */
+  } UplinkType;
+
+  typedef struct __attribute__((packed)) {
+    uint32_t time;      /* 本帧的发送时刻(us) */
+    uint32_t pose_time; /* 本帧姿态的采样时刻(us) */
+  } UplinkSync;
+
+  typedef struct __attribute__((packed)) {
+    uint8_t arm;
+    uint8_t rfid;
+    uint8_t team;
+    uint8_t race;
+  } UplinkReferee;
+
+  /* 编码前的上行帧长度 */
+  static constexpr size_t UPLINK_FRAME_SIZE = 64;
+
+  /* 内容变化时立即发送，否则按keepalive周期重发 */
+  typedef struct {
+    uint8_t type;
+    uint8_t len;
+    uint16_t keepalive; /* ms，0表示每个上行周期都发送 */
+    uint32_t last_time;
+    bool sent;
+    uint8_t last[16];
+  } UplinkMessage;
+
   typedef struct {
     uint8_t game_type;
     Device::Referee::Status status;
@@ -111,6 +170,10 @@ class AI {
 
   bool StartTrans();
 
+#if DEVICE_AI_TLV_UPLINK
+  bool QueueUplink(UplinkMessage &msg, const void *data);
+#endif
+
   bool Offline();
 
   bool PackMCU();
@@ -123,6 +186,18 @@ class AI {
 
   void DecideAction();
 
+  void RecordLatency();
+
+  bool PraseSync();
+
+  /* 计算补偿量，不修改上位机原始数据 */
+  bool Compensate();
+
+  /* 上位机给出的云台角度加上补偿量后写入指令 */
+  void SetGimbalFromHost();
+
+  static int ShowCMD(AI *ai, int argc, char **argv);
+
  private:
   /* function */
   bool autoscan_enable_ = true; /* AI自动扫描，不启用则默认AI全程在线 */
@@ -135,12 +210,34 @@ class AI {
   /* time record */
   uint32_t last_online_time_ = 0;
   uint32_t aim_time_;
+  uint64_t scan_time_ = 0;
+  uint64_t rx_time_ = 0; /* 接收完成中断的时刻 */
+
+  /* link status */
+  bool host_updated_ = false;    /* 上行周期内收到过上位机数据 */
+  bool latency_pending_ = false; /* 等待云台指令发布以统计延迟 */
+
+  struct {
+    uint32_t rx_count;
+    uint32_t crc_err_count;
+    uint32_t uplink_count;
+    uint32_t latency_count;
+    uint32_t latency_last;
+    uint32_t latency_max;
+    uint64_t latency_sum;
+    uint32_t sync_err_count;
+    uint32_t compensate_count;
+    uint32_t compensate_miss;
+    uint32_t tx_busy_count;
+    uint32_t tx_bytes;
+  } stats_{};
 
   /* angle record */
   float chassis_yaw_offset_ = 0;
   float gimbal_scan_start_angle_;
   Component::Type::Eulr eulr_;
   Component::Type::Quaternion quat_;
+  uint32_t quat_time_ = 0; /* quat_的采样时刻(us) */
   Component::Type::CycleValue target_scan_angle_ = 0.0;
   struct {
     float yaw; /* 偏航角（Yaw angle） */
@@ -165,6 +262,31 @@ class AI {
   /* Data */
   Protocol_DownPackage_t from_host_{};
 
+#if DEVICE_AI_TIME_SYNC
+  HostSync host_sync_{};
+
+  Component::ClockSync clock_sync_;
+#endif
+
+#if DEVICE_AI_POSE_COMPENSATE
+  Component::PoseHistory<DEVICE_AI_POSE_HISTORY_NUM> pose_history_;
+  float pose_delta_[2] = {}; /* 本次下行角度的补偿量，yaw与pit */
+#endif
+
+#if DEVICE_AI_TLV_UPLINK
+  uint8_t frame_buff_[UPLINK_FRAME_SIZE];
+  Component::TLVFrame frame_{this->frame_buff_, sizeof(this->frame_buff_)};
+  uint8_t tx_seq_ = 0;
+  volatile bool tx_busy_ = false; /* 由发送完成中断清除 */
+  uint32_t tx_start_time_ = 0;
+
+  UplinkMessage quat_msg_{UPLINK_QUAT, sizeof(Component::Type::Quaternion), 0};
+  UplinkMessage notice_msg_{UPLINK_NOTICE, sizeof(uint8_t), 100};
+  UplinkMessage ball_speed_msg_{UPLINK_BALL_SPEED, sizeof(float), 1000};
+  UplinkMessage referee_msg_{UPLINK_REFEREE, sizeof(UplinkReferee), 1000};
+  UplinkMessage sync_msg_{UPLINK_SYNC, sizeof(UplinkSync), 0};
+#endif
+
   struct {
     RefereePckage ref{};
     MCUPckage mcu{};
@@ -194,11 +316,29 @@ class AI {
   Message::Topic<SentryDecisionData> ai_tp_ =
       Message::Topic<SentryDecisionData>("sentry_cmd_for_ref");
 
-  Device::Referee::Data raw_ref_{};
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
+
+  /* 姿态与发布时刻一起保存，上行时两者来自同一次发布 */
+  typedef struct {
+    uint32_t time;
+    Component::Type::Quaternion quat;
+  } StampedQuat;
+
+  Component::Snapshot<StampedQuat> quat_snapshot_ =
+      Component::Snapshot<StampedQuat>("ai_quat");
+
+  Component::StaticSubscriber<Component::TopicHash("chassis_yaw")> yaw_sub_;
+  Component::StaticSubscriber<Component::TopicHash("imu_eulr")> eulr_sub_;
 
   /* Task Control */
-  System::Thread thread_;
+  System::Thread rx_thread_;
+  System::Thread tx_thread_;
 
   System::Semaphore data_ready_;
+
+  System::Semaphore ctrl_lock_;
+
+  System::Term::Command<AI *> term_cmd_;
 };
 }  // namespace Device
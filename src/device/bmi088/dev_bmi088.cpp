@@ -135,6 +135,11 @@ BMI088::BMI088(BMI088::Rotation &rot)
       accl_tp_("imu_accl"),
       gyro_tp_("imu_gyro"),
       cmd_(this, this->CaliCMD, "bmi088") {
+  Component::TopicRegistry<Component::TopicHash("imu_accl")>::Register(
+      this->accl_tp_);
+  Component::TopicRegistry<Component::TopicHash("imu_gyro")>::Register(
+      this->gyro_tp_);
+
   auto recv_cplt_callback = [](void *arg) {
     BMI088 *bmi088 = static_cast<BMI088 *>(arg);
 
@@ -1,11 +1,18 @@
 #include "dev_can.hpp"
 
 #include "bsp_can.h"
+#include "bsp_time.h"
 
 using namespace Device;
 
 std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> Can::can_tp_;
 
+std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> Can::can_deferred_tp_;
+
+std::array<Can::DeferredQueue*, BSP_CAN_NUM> Can::deferred_queue_;
+
+std::array<uint32_t, BSP_CAN_NUM> Can::deferred_num_;
+
 std::array<System::Semaphore*, BSP_CAN_NUM> Can::can_sem_;
 
 static std::array<Can::Pack, BSP_CAN_NUM> pack;
@@ -17,14 +24,33 @@ Can::Can() {
     can_sem_[i] = new System::Semaphore(true);
   }
 
+  auto deferred_cb = [](Pack& pack, void* arg) {
+    static_cast<Message::Topic<Can::Pack>*>(arg)->Publish(pack);
+  };
+
+  for (int i = 0; i < BSP_CAN_NUM; i++) {
+    std::string name = "dev_can_deferred_" + std::to_string(i);
+    can_deferred_tp_[i] = new Message::Topic<Can::Pack>(name.c_str());
+    deferred_queue_[i] =
+        new DeferredQueue(name.c_str(), deferred_cb, can_deferred_tp_[i]);
+  }
+
   auto rx_callback = [](bsp_can_t can, uint32_t id, uint8_t* data, void* arg) {
     XB_UNUSED(arg);
 
+    const uint64_t START = bsp_time_get();
+
     pack[can].index = id;
 
     memcpy(pack[can].data, data, sizeof(pack[can].data));
 
     can_tp_[can]->Publish(pack[can]);
+
+    if (deferred_num_[can] > 0) {
+      deferred_queue_[can]->Push(pack[can]);
+    }
+
+    deferred_queue_[can]->RecordIsr(START);
   };
 
   for (int i = 0; i < BSP_CAN_NUM; i++) {
@@ -75,10 +101,19 @@ bool Can::SendExtRemotePack(bsp_can_t can, Pack& pack) {
 }
 
 bool Can::Subscribe(Message::Topic<Can::Pack>& tp, bsp_can_t can,
-                    uint32_t index, uint32_t num) {
+                    uint32_t index, uint32_t num,
+                    Component::Deferred::Policy policy) {
   XB_ASSERT(num > 0);
 
-  can_tp_[can]->RangeDivide(tp, sizeof(Pack), offsetof(Pack, index),
-                            om_member_size_of(Pack, index), index, num);
+  auto source = can_tp_[can];
+
+  if (Component::Deferred::Resolve(policy) ==
+      Component::Deferred::RUN_DEFERRED) {
+    source = can_deferred_tp_[can];
+    deferred_num_[can]++;
+  }
+
+  source->RangeDivide(tp, sizeof(Pack), offsetof(Pack, index),
+                      om_member_size_of(Pack, index), index, num);
   return true;
 }
@@ -3,6 +3,11 @@
 #include <device.hpp>
 
 #include "bsp_can.h"
+#include "comp_deferred.hpp"
+
+#ifndef DEVICE_CAN_DEFERRED_QUEUE_LEN
+#define DEVICE_CAN_DEFERRED_QUEUE_LEN (32)
+#endif
 
 namespace Device {
 class Can {
@@ -12,6 +17,9 @@ class Can {
     uint8_t data[8];
   } Pack;
 
+  typedef Component::DeferredQueue<Pack, DEVICE_CAN_DEFERRED_QUEUE_LEN>
+      DeferredQueue;
+
   Can();
 
   static bool SendPack(bsp_can_t can, bsp_can_format_t format, Pack& pack);
@@ -24,10 +32,16 @@ class Can {
 
   static bool SendExtRemotePack(bsp_can_t can, Pack& pack);
 
-  static bool Subscribe(Message::Topic<Can::Pack>& tp, bsp_can_t can,
-                        uint32_t index, uint32_t num);
+  /* 默认在中断中执行订阅者回调，回调较重时使用RUN_DEFERRED交给分发线程 */
+  static bool Subscribe(
+      Message::Topic<Can::Pack>& tp, bsp_can_t can, uint32_t index,
+      uint32_t num,
+      Component::Deferred::Policy policy = Component::Deferred::RUN_IN_ISR);
 
   static std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> can_tp_;
+  static std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> can_deferred_tp_;
+  static std::array<DeferredQueue*, BSP_CAN_NUM> deferred_queue_;
+  static std::array<uint32_t, BSP_CAN_NUM> deferred_num_;
   static std::array<System::Semaphore*, BSP_CAN_NUM> can_sem_;
 };
 }  // namespace Device
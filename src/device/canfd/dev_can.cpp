@@ -1,6 +1,7 @@
 #include "dev_can.hpp"
 
 #include "bsp_can.h"
+#include "bsp_time.h"
 
 using namespace Device;
 
@@ -8,6 +9,18 @@ std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> Can::can_tp_;
 
 std::array<Message::Topic<Can::FDPack>*, BSP_CAN_NUM> Can::canfd_tp_;
 
+std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> Can::can_deferred_tp_;
+
+std::array<Message::Topic<Can::FDPack>*, BSP_CAN_NUM> Can::canfd_deferred_tp_;
+
+std::array<Can::DeferredQueue*, BSP_CAN_NUM> Can::deferred_queue_;
+
+std::array<Can::DeferredFDQueue*, BSP_CAN_NUM> Can::deferred_fd_queue_;
+
+std::array<uint32_t, BSP_CAN_NUM> Can::deferred_num_;
+
+std::array<uint32_t, BSP_CAN_NUM> Can::deferred_fd_num_;
+
 std::array<System::Semaphore*, BSP_CAN_NUM> Can::can_sem_;
 
 static std::array<Can::Pack, BSP_CAN_NUM> pack;
@@ -28,30 +41,66 @@ Can::Can() : cmd_(this, CMD, "can"), print_sem_(0), queue_(32) {
     can_sem_[i] = new System::Semaphore(true);
   }
 
+  auto deferred_cb = [](Pack& pack, void* arg) {
+    static_cast<Message::Topic<Can::Pack>*>(arg)->Publish(pack);
+  };
+
+  auto deferred_fd_cb = [](FDPack& pack, void* arg) {
+    static_cast<Message::Topic<Can::FDPack>*>(arg)->Publish(pack);
+  };
+
+  for (int i = 0; i < BSP_CAN_NUM; i++) {
+    std::string name = "dev_can_deferred_" + std::to_string(i);
+    can_deferred_tp_[i] = new Message::Topic<Can::Pack>(name.c_str());
+    deferred_queue_[i] =
+        new DeferredQueue(name.c_str(), deferred_cb, can_deferred_tp_[i]);
+
+    name = "dev_canfd_deferred_" + std::to_string(i);
+    canfd_deferred_tp_[i] = new Message::Topic<Can::FDPack>(name.c_str());
+    deferred_fd_queue_[i] = new DeferredFDQueue(name.c_str(), deferred_fd_cb,
+                                                canfd_deferred_tp_[i]);
+  }
+
   auto rx_callback = [](bsp_can_t can, uint32_t id, uint8_t* data, void* arg) {
     XB_UNUSED(arg);
 
+    const uint64_t START = bsp_time_get();
+
     pack[can].index = id;
 
     memcpy(pack[can].data, data, sizeof(pack[can].data));
 
     can_tp_[can]->Publish(pack[can]);
 
+    if (deferred_num_[can] > 0) {
+      deferred_queue_[can]->Push(pack[can]);
+    }
+
     if (print_can_pack) {
       self_->queue_.Send(pack[can]);
       self_->print_sem_.Post();
     }
+
+    deferred_queue_[can]->RecordIsr(START);
   };
 
   auto fd_rx_callback = [](bsp_can_t can, uint32_t id, uint8_t* data,
                            void* arg) {
     XB_UNUSED(arg);
 
+    const uint64_t START = bsp_time_get();
+
     fd_pack[can].index = id;
 
     memcpy(&fd_pack[can].info, data, sizeof(bsp_canfd_data_t));
 
     canfd_tp_[can]->Publish(fd_pack[can]);
+
+    if (deferred_fd_num_[can] > 0) {
+      deferred_fd_queue_[can]->Push(fd_pack[can]);
+    }
+
+    deferred_fd_queue_[can]->RecordIsr(START);
   };
 
   for (int i = 0; i < BSP_CAN_NUM; i++) {
@@ -114,20 +163,38 @@ bool Can::SendFDExtPack(bsp_can_t can, uint32_t id, uint8_t* data,
 }
 
 bool Can::Subscribe(Message::Topic<Can::Pack>& tp, bsp_can_t can,
-                    uint32_t index, uint32_t num) {
+                    uint32_t index, uint32_t num,
+                    Component::Deferred::Policy policy) {
   XB_ASSERT(num > 0);
 
-  can_tp_[can]->RangeDivide(tp, sizeof(Pack), offsetof(Pack, index),
-                            om_member_size_of(Pack, index), index, num);
+  auto source = can_tp_[can];
+
+  if (Component::Deferred::Resolve(policy) ==
+      Component::Deferred::RUN_DEFERRED) {
+    source = can_deferred_tp_[can];
+    deferred_num_[can]++;
+  }
+
+  source->RangeDivide(tp, sizeof(Pack), offsetof(Pack, index),
+                      om_member_size_of(Pack, index), index, num);
   return true;
 }
 
 bool Can::SubscribeFD(Message::Topic<Can::FDPack>& tp, bsp_can_t can,
-                      uint32_t index, uint32_t num) {
+                      uint32_t index, uint32_t num,
+                      Component::Deferred::Policy policy) {
   XB_ASSERT(num > 0);
 
-  canfd_tp_[can]->RangeDivide(tp, sizeof(FDPack), offsetof(FDPack, index),
-                              om_member_size_of(Pack, index), index, num);
+  auto source = canfd_tp_[can];
+
+  if (Component::Deferred::Resolve(policy) ==
+      Component::Deferred::RUN_DEFERRED) {
+    source = canfd_deferred_tp_[can];
+    deferred_fd_num_[can]++;
+  }
+
+  source->RangeDivide(tp, sizeof(FDPack), offsetof(FDPack, index),
+                      om_member_size_of(Pack, index), index, num);
   return true;
 }
 
@@ -3,6 +3,15 @@
 #include <device.hpp>
 
 #include "bsp_can.h"
+#include "comp_deferred.hpp"
+
+#ifndef DEVICE_CAN_DEFERRED_QUEUE_LEN
+#define DEVICE_CAN_DEFERRED_QUEUE_LEN (32)
+#endif
+
+#ifndef DEVICE_CANFD_DEFERRED_QUEUE_LEN
+#define DEVICE_CANFD_DEFERRED_QUEUE_LEN (8)
+#endif
 
 namespace Device {
 class Can {
@@ -17,6 +26,12 @@ class Can {
     bsp_canfd_data_t info;
   } FDPack;
 
+  typedef Component::DeferredQueue<Pack, DEVICE_CAN_DEFERRED_QUEUE_LEN>
+      DeferredQueue;
+
+  typedef Component::DeferredQueue<FDPack, DEVICE_CANFD_DEFERRED_QUEUE_LEN>
+      DeferredFDQueue;
+
   Can();
 
   static bool SendPack(bsp_can_t can, bsp_can_format_t format, Pack& pack);
@@ -34,13 +49,25 @@ class Can {
   static bool SendFDExtPack(bsp_can_t can, uint32_t id, uint8_t* data,
                             size_t size);
 
-  static bool Subscribe(Message::Topic<Can::Pack>& tp, bsp_can_t can,
-                        uint32_t index, uint32_t num);
-  static bool SubscribeFD(Message::Topic<Can::FDPack>& tp, bsp_can_t can,
-                          uint32_t index, uint32_t num);
+  /* 默认在中断中执行订阅者回调，回调较重时使用RUN_DEFERRED交给分发线程 */
+  static bool Subscribe(
+      Message::Topic<Can::Pack>& tp, bsp_can_t can, uint32_t index,
+      uint32_t num,
+      Component::Deferred::Policy policy = Component::Deferred::RUN_IN_ISR);
+  static bool SubscribeFD(
+      Message::Topic<Can::FDPack>& tp, bsp_can_t can, uint32_t index,
+      uint32_t num,
+      Component::Deferred::Policy policy = Component::Deferred::RUN_IN_ISR);
 
   static std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> can_tp_;
   static std::array<Message::Topic<Can::FDPack>*, BSP_CAN_NUM> canfd_tp_;
+  static std::array<Message::Topic<Can::Pack>*, BSP_CAN_NUM> can_deferred_tp_;
+  static std::array<Message::Topic<Can::FDPack>*, BSP_CAN_NUM>
+      canfd_deferred_tp_;
+  static std::array<DeferredQueue*, BSP_CAN_NUM> deferred_queue_;
+  static std::array<DeferredFDQueue*, BSP_CAN_NUM> deferred_fd_queue_;
+  static std::array<uint32_t, BSP_CAN_NUM> deferred_num_;
+  static std::array<uint32_t, BSP_CAN_NUM> deferred_fd_num_;
   static std::array<System::Semaphore*, BSP_CAN_NUM> can_sem_;
 
   static int CMD(Can* can, int argc, char** argv);
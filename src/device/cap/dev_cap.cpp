@@ -9,6 +9,9 @@
 using namespace Device;
 
 Cap::Cap(Cap::Param &param) : param_(param), info_tp_("cap_info") {
+  Component::TopicRegistry<Component::TopicHash("cap_info")>::Register(
+      this->info_tp_);
+
   out_.power_limit_ = 40.0f;
 
   auto rx_callback = [](Can::Pack &rx, Cap *cap) {
@@ -43,9 +46,8 @@ Cap::Cap(Cap::Param &param) : param_(param), info_tp_("cap_info") {
     return true;
   };
 
-  Message::Topic<Device::Referee::Data>(
-      Message::Topic<Device::Referee::Data>::Find("referee"))
-      .RegisterCallback(ref_cb, this);
+  Component::TopicRegistry<Component::TopicHash("referee")>::RegisterCallback(
+      ref_cb, this);
 
   auto cap_thread = [](Cap *cap) {
     while (1) {
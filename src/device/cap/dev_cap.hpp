@@ -117,3 +117,5 @@ class Cap {
   Component::UI::Arc arc_{};
 };
 }  // namespace Device
+
+COMP_TOPIC_DECLARE("cap_info", Device::Cap::Info);
@@ -18,6 +18,7 @@
 #include <thread.hpp>
 #include <timer.hpp>
 
+#include "comp_topic.hpp"
 #include "comp_type.hpp"
 #include "comp_utils.hpp"
 #include "om.hpp"
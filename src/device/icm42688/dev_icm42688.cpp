@@ -55,6 +55,11 @@ ICM42688::ICM42688(ICM42688::Rotation &rot, DataRate date_rate)
       gyro_tp_("imu_gyro"),
       cmd_(this, this->CaliCMD, "icm42688"),
       imu_temp_ctrl_pid_(imu_temp_ctrl_pid_param, 1000.0f) {
+  Component::TopicRegistry<Component::TopicHash("imu_accl")>::Register(
+      this->accl_tp_);
+  Component::TopicRegistry<Component::TopicHash("imu_gyro")>::Register(
+      this->gyro_tp_);
+
   auto recv_cplt_callback = [](void *arg) {
     ICM42688 *icm42688 = static_cast<ICM42688 *>(arg);
     icm42688->Unselect();
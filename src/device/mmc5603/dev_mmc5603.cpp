@@ -24,6 +24,9 @@ MMC5603::MMC5603(MMC5603::Rotation &rot, float max_offset, DataRate data_rate)
       cmd_(this, CaliCMD, "mmc5603"),
       cali_data_("mmc5603_cali", default_cali),
       raw_(0) {
+  Component::TopicRegistry<Component::TopicHash("magn")>::Register(
+      this->magn_tp_);
+
   auto recv_cplt_callback = [](void *arg) {
     MMC5603 *mmc5603 = static_cast<MMC5603 *>(arg);
     mmc5603->raw_.Post();
@@ -46,8 +46,9 @@ MitMotor::MitMotor(const Param &param, const char *name)
         (std::string("mit_motor_can") + std::to_string(this->param_.can))
             .c_str());
 
+    /* 同一总线的全部MIT电机共用一个话题，逐个回调较重，不在中断中执行 */
     Can::Subscribe(*MitMotor::mit_tp_[this->param_.can], this->param_.can, 0,
-                   1);
+                   1, Component::Deferred::RUN_DEFERRED);
 
     initd[this->param_.can] = true;
   }
@@ -11,7 +11,15 @@
 
 #define REF_HEADER_SOF (0xA5)
 #define REF_LEN_RX_BUFF (0xFF)
-#define REF_LEN_TX_BUFF (0xFF)
+
+/* 0x0301各子命令共享REF_TX_FREQ的上限，再按类别限频，避免单一来源占满 */
+#define REF_DECISION_INTERVAL (100)
+#define REF_DECISION_REPEAT (1000) /* 决策未变化时的重发间隔 */
+#define REF_INTERACTION_INTERVAL (100)
+/* DMA发送超过此时间未完成认为丢失了完成中断 */
+#define REF_TX_TIMEOUT (50)
+/* UI中最早的变化等待超过此时间时AddUI返回false */
+#define REF_UI_BACKLOG (500)
 
 #define REF_UI_BOX_UP_OFFSET (4)
 #define REF_UI_BOX_BOT_OFFSET (-14)
@@ -34,16 +42,106 @@
 
 using namespace Device;
 
+typedef struct {
+  uint16_t cmd_id;
+  uint16_t offset;
+  uint16_t size;
+  bool variable;
+} RefMessageInfo;
+
+static constexpr RefMessageInfo REF_MESSAGE_INFO[] = {
+#define REF_MESSAGE_INFO_ITEM(cmd, type, name, variable)          \
+  {Referee::REF_CMD_ID_##cmd, offsetof(Referee::Data, name), \
+   sizeof(Referee::type), variable},
+    REF_MESSAGE_TABLE(REF_MESSAGE_INFO_ITEM)
+#undef REF_MESSAGE_INFO_ITEM
+};
+
+/* 定长消息按长度严格校验，结构体必须与协议中的数据段长度一致 */
+static_assert(sizeof(Referee::GameStatus) == 11, "0x0001 is 11 bytes.");
+static_assert(sizeof(Referee::GameResult) == 1, "0x0002 is 1 byte.");
+static_assert(sizeof(Referee::RobotHP) == 32, "0x0003 is 32 bytes.");
+static_assert(sizeof(Referee::FieldEvents) == 4, "0x0101 is 4 bytes.");
+static_assert(sizeof(Referee::SupplyAction) == 4, "0x0102 is 4 bytes.");
+static_assert(sizeof(Referee::Warning) == 3, "0x0104 is 3 bytes.");
+static_assert(sizeof(Referee::DartCountdown) == 3, "0x0105 is 3 bytes.");
+static_assert(sizeof(Referee::RobotStatus) == 13, "0x0201 is 13 bytes.");
+static_assert(sizeof(Referee::PowerHeat) == 16, "0x0202 is 16 bytes.");
+static_assert(sizeof(Referee::RobotPOS) == 12, "0x0203 is 12 bytes.");
+static_assert(sizeof(Referee::RobotBuff) == 6, "0x0204 is 6 bytes.");
+static_assert(sizeof(Referee::DroneEnergy) == 2, "0x0205 is 2 bytes.");
+static_assert(sizeof(Referee::RobotDamage) == 1, "0x0206 is 1 byte.");
+static_assert(sizeof(Referee::LauncherData) == 7, "0x0207 is 7 bytes.");
+static_assert(sizeof(Referee::BulletRemain) == 6, "0x0208 is 6 bytes.");
+static_assert(sizeof(Referee::RFID) == 4, "0x0209 is 4 bytes.");
+static_assert(sizeof(Referee::DartClient) == 6, "0x020A is 6 bytes.");
+static_assert(sizeof(Referee::RobotPosForSentry) == 40, "0x020B is 40 bytes.");
+static_assert(sizeof(Referee::RadarMarkProgress) == 6, "0x020C is 6 bytes.");
+static_assert(sizeof(Referee::SentryInfo) == 4, "0x020D is 4 bytes.");
+static_assert(sizeof(Referee::RadarInfo) == 1, "0x020E is 1 byte.");
+static_assert(sizeof(Referee::ClientMap) == 12, "0x0303 is 12 bytes.");
+static_assert(sizeof(Referee::KeyboardMouse) == 12, "0x0304 is 12 bytes.");
+static_assert(sizeof(Referee::MapRobotData) == 10, "0x0305 is 10 bytes.");
+static_assert(sizeof(Referee::CustomKeyMouseData) == 8, "0x0306 is 8 bytes.");
+static_assert(sizeof(Referee::SentryPosition) == 105, "0x0307 is 105 bytes.");
+static_assert(sizeof(Referee::RobotPosition) == 34, "0x0308 is 34 bytes.");
+
+/* 命令码高字节与低字节直接作为二维下标，查找为O(1) */
+#define REF_CMD_INDEX_ROW (4)
+#define REF_CMD_INDEX_COL (16)
+
+typedef struct {
+  int8_t index[REF_CMD_INDEX_ROW][REF_CMD_INDEX_COL];
+} RefMessageIndex;
+
+static constexpr bool ref_message_table_valid() {
+  for (size_t i = 0; i < Referee::MESSAGE_NUM; i++) {
+    const uint16_t CMD = REF_MESSAGE_INFO[i].cmd_id;
+    if ((CMD >> 8) >= REF_CMD_INDEX_ROW || (CMD & 0xFF) >= REF_CMD_INDEX_COL) {
+      return false;
+    }
+    for (size_t j = 0; j < i; j++) {
+      if (REF_MESSAGE_INFO[j].cmd_id == CMD) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(ref_message_table_valid(),
+              "REF_MESSAGE_TABLE has a duplicated or out-of-range cmd_id.");
+
+static constexpr RefMessageIndex ref_message_index_build() {
+  RefMessageIndex table{};
+  for (auto &row : table.index) {
+    for (auto &item : row) {
+      item = -1;
+    }
+  }
+  for (size_t i = 0; i < Referee::MESSAGE_NUM; i++) {
+    const uint16_t CMD = REF_MESSAGE_INFO[i].cmd_id;
+    table.index[CMD >> 8][CMD & 0xFF] = static_cast<int8_t>(i);
+  }
+  return table;
+}
+
+static constexpr RefMessageIndex REF_MESSAGE_INDEX = ref_message_index_build();
+
 static uint8_t rxbuf[REF_LEN_RX_BUFF];
 
-Referee::UIPack Referee::ui_pack_;
-Referee::SentryPack Referee::sentry_pack_;
+Referee::TxBuffer Referee::tx_buff_[2];
 
 Referee *Referee::self_;
 
-Referee::Referee() : event_(Message::Event::FindEvent("cmd_event")) {
+Referee::Referee()
+    : event_(Message::Event::FindEvent("cmd_event")),
+      cmd_(this, Referee::ShowCMD, "referee", System::Term::DevDir()) {
   self_ = this;
 
+  Component::TopicRegistry<Component::TopicHash("referee")>::Register(
+      this->ref_data_tp_);
+
   auto rx_cplt_callback = [](void *arg) {
     Referee *ref = static_cast<Referee *>(arg);
     ref->raw_ready_.Post();
@@ -51,7 +149,19 @@ Referee::Referee() : event_(Message::Event::FindEvent("cmd_event")) {
 
   auto tx_cplt_callback = [](void *arg) {
     Referee *ref = static_cast<Referee *>(arg);
-    ref->packet_sent_.Post();
+    /* 超时后计数已被清零 */
+    if (ref->tx_inflight_.load() == 0) {
+      return;
+    }
+    /* 另一块缓冲区已组好帧时立即接着发送 */
+    if (ref->tx_inflight_.fetch_sub(1) > 1) {
+      const uint8_t NEXT = ref->tx_next_;
+      ref->tx_start_time_ = bsp_time_get_ms();
+      if (bsp_uart_transmit(BSP_UART_REF, tx_buff_[NEXT].raw,
+                            ref->tx_len_[NEXT], false) != BSP_OK) {
+        ref->tx_inflight_.fetch_sub(1);
+      }
+    }
   };
 
   auto idle_line_callback = [](void *arg) {
@@ -93,6 +203,7 @@ Referee::Referee() : event_(Message::Event::FindEvent("cmd_event")) {
 
       /* 发布裁判系统数据 */
       ref->ref_data_tp_.Publish(ref->ref_data_);
+      ref->ref_snapshot_.Publish(ref->ref_data_);
     }
   };
 
@@ -104,9 +215,12 @@ Referee::Referee() : event_(Message::Event::FindEvent("cmd_event")) {
     uint32_t last_online_time = bsp_time_get_ms();
     auto ai_sub = Message::Subscriber<SentryDecisionData>("sentry_cmd_for_ref");
     while (1) {
-      ai_sub.DumpData(ref->data_from_sentry_);
-      ref->Update(); /* 更新UI */
-      ref->trans_thread_.SleepUntil(40, last_online_time);
+      if (ai_sub.DumpData(ref->data_from_sentry_)) {
+        ref->decision_valid_ = true;
+      }
+      ref->Update(); /* 按优先级发送一帧 */
+      ref->trans_thread_.SleepUntil((1000 + REF_TX_FREQ - 1) / REF_TX_FREQ,
+                                    last_online_time);
     }
   };
   this->trans_thread_.Create(ref_trans_thread, this, "ref_trans_thread",
@@ -124,181 +238,52 @@ bool Referee::StartRecv() {
 void Referee::Prase() {
   this->ref_data_.status = RUNNING;
   const size_t data_length = bsp_uart_get_count(BSP_UART_REF);
+  const uint32_t NOW = bsp_time_get_ms();
 
   const uint8_t *index = rxbuf; /* const 保护原始rxbuf不被修改 */
   const uint8_t *const RXBUF_END = rxbuf + data_length;
 
   while (index < RXBUF_END) {
-    /* 1.处理帧头 */
-    /* 1.1遍历所有找到SOF */
-    while ((*index != REF_HEADER_SOF) && (index < RXBUF_END)) {
+    /* 1.查找SOF */
+    if (*index != REF_HEADER_SOF) {
       index++;
+      continue;
     }
-    /* 1.2将剩余数据当做帧头部 */
+
+    /* 2.验证帧头，剩余数据不足一帧时等待下次接收 */
+    if (static_cast<size_t>(RXBUF_END - index) < sizeof(Referee::Header)) {
+      break;
+    }
+
     const Referee::Header *header =
         reinterpret_cast<const Referee::Header *>(index);
 
-    /* 1.3验证完整性 */
-    if (!Component::CRC8::Verify(reinterpret_cast<const uint8_t *>(header),
-                                 sizeof(*header))) {
+    if (!Component::CRC8::Verify(index, sizeof(*header))) {
+      this->rx_stats_.crc8_err++;
       index++;
       continue;
     }
-    index += sizeof(*header);
-
-    /* 2.处理CMD ID */
-    /* 2.1将剩余数据当做CMD ID处理 */
-    const Referee::CMDID *cmd_id =
-        reinterpret_cast<const Referee::CMDID *>(index);
-    index += sizeof(*cmd_id);
-
-    /* 3.处理数据段 */
-    const void *source = index;
-    void *destination = NULL;
-    size_t size = 0;
-
-    switch (static_cast<int>(*cmd_id)) {
-      case REF_CMD_ID_GAME_STATUS:
-        destination = &(this->ref_data_.game_status);
-        size = sizeof(this->ref_data_.game_status);
-        break;
-      case REF_CMD_ID_GAME_RESULT:
-        destination = &(this->ref_data_.game_result);
-        size = sizeof(this->ref_data_.game_result);
-        break;
-      case REF_CMD_ID_GAME_ROBOT_HP:
-        destination = &(this->ref_data_.game_robot_hp);
-        size = sizeof(this->ref_data_.game_robot_hp);
-        break;
-      case REF_CMD_ID_FIELD_EVENTS:
-        destination = &(this->ref_data_.field_event);
-        size = sizeof(this->ref_data_.field_event);
-        break;
-      case REF_CMD_ID_SUPPLY_ACTION:
-        destination = &(this->ref_data_.supply_action);
-        size = sizeof(this->ref_data_.supply_action);
-        break;
-      case REF_CMD_ID_WARNING:
-        destination = &(this->ref_data_.warning);
-        size = sizeof(this->ref_data_.warning);
-        break;
-      case REF_CMD_ID_DART_COUNTDOWN:
-        destination = &(this->ref_data_.dart_countdown);
-        size = sizeof(this->ref_data_.dart_countdown);
-        break;
-      case REF_CMD_ID_ROBOT_STATUS:
-        destination = &(this->ref_data_.robot_status);
-        size = sizeof(this->ref_data_.robot_status);
-        break;
-      case REF_CMD_ID_POWER_HEAT_DATA:
-        destination = &(this->ref_data_.power_heat);
-        size = sizeof(this->ref_data_.power_heat);
-        break;
-      case REF_CMD_ID_ROBOT_POS:
-        destination = &(this->ref_data_.robot_pos);
-        size = sizeof(this->ref_data_.robot_pos);
-        break;
-      case REF_CMD_ID_ROBOT_BUFF:
-        destination = &(this->ref_data_.robot_buff);
-        size = sizeof(this->ref_data_.robot_buff);
-        break;
-      case REF_CMD_ID_DRONE_ENERGY:
-        destination = &(this->ref_data_.drone_energy);
-        size = sizeof(this->ref_data_.drone_energy);
-        break;
-      case REF_CMD_ID_ROBOT_DMG:
-        destination = &(this->ref_data_.robot_damage);
-        size = sizeof(this->ref_data_.robot_damage);
-        break;
-      case REF_CMD_ID_LAUNCHER_DATA:
-        destination = &(this->ref_data_.launcher_data);
-        size = sizeof(this->ref_data_.launcher_data);
-        break;
-      case REF_CMD_ID_BULLET_REMAINING:
-        destination = &(this->ref_data_.bullet_remain);
-        size = sizeof(this->ref_data_.bullet_remain);
-        break;
-      case REF_CMD_ID_RFID:
-        destination = &(this->ref_data_.rfid);
-        size = sizeof(this->ref_data_.rfid);
-        break;
-      case REF_CMD_ID_DART_CLIENT:
-        destination = &(this->ref_data_.dart_client);
-        size = sizeof(this->ref_data_.dart_client);
-        break;
-      case REF_CMD_ID_ROBOT_POS_TO_SENTRY:
-        destination = &(this->ref_data_.robot_pos_for_snetry);
-        size = sizeof(this->ref_data_.robot_pos_for_snetry);
-        break;
-      case REF_CMD_ID_RADAR_MARK:
-        destination = &(this->ref_data_.radar_mark_progress);
-        size = sizeof(this->ref_data_.radar_mark_progress);
-        break;
-      case REF_CMD_ID_SENTRY_DECISION:
-        destination = &(this->ref_data_.sentry_decision);
-        size = sizeof(this->ref_data_.sentry_decision);
-        break;
-      case REF_CMD_ID_RADAR_DECISION:
-        destination = &(this->ref_data_.radar_decision);
-        size = sizeof(this->ref_data_.radar_decision);
-        break;
-      case REF_CMD_ID_INTER_STUDENT:
-        destination = &(this->ref_data_.robot_ineraction_data);
-        size = sizeof(this->ref_data_.robot_ineraction_data);
-        break;
-      case REF_CMD_ID_INTER_STUDENT_CUSTOM:
-        destination = &(this->ref_data_.custom_controller);
-        size = sizeof(this->ref_data_.custom_controller);
-        break;
-      case REF_CMD_ID_CLIENT_MAP:
-        destination = &(this->ref_data_.client_map);
-        size = sizeof(this->ref_data_.client_map);
-        break;
-      case REF_CMD_ID_KEYBOARD_MOUSE:
-        destination = &(this->ref_data_.keyboard_mouse);
-        size = sizeof(this->ref_data_.keyboard_mouse);
-        break;
-      case REF_CMD_ID_MAP_ROBOT_DATA:
-        destination = &(this->ref_data_.map_robot_data);
-        size = sizeof(this->ref_data_.map_robot_data);
-        break;
-      case REF_CMD_ID_CUSTOM_KEYBOARD_MOUSE:
-        destination = &(this->ref_data_.custom_key_mouse_data);
-        size = sizeof(this->ref_data_.custom_key_mouse_data);
-        break;
-      case REF_CMD_ID_SENTRY_POS_DATA:
-        destination = &(this->ref_data_.sentry_postion);
-        size = sizeof(this->ref_data_.sentry_postion);
-        break;
-      case REF_CMD_ID_ROBOT_POS_DATA:
-        destination = &(this->ref_data_.robot_position);
-        size = sizeof(this->ref_data_.robot_position);
-        break;
-
-      default:
-        return;
-    }
-    index += size;
-
-    /* 4.处理帧尾 */
-    index += sizeof(Referee::Tail);
 
-    /* 验证无误则接受数据 */
-    if (Component::CRC16::Verify(
-            reinterpret_cast<const uint8_t *>((header)),
-            static_cast<uint8_t>(
-                index - reinterpret_cast<const uint8_t *>((header))))) {
-      memcpy(destination, source, size);
-    }
-    if (ref_data_.robot_damage.damage_type == 0x0 &&
-        !last_data_.robot_damage.damage_type) {
-      this->event_.Active(REF_ATTACKED);
+    const size_t FRAME_LEN = sizeof(Referee::Header) + sizeof(uint16_t) +
+                             header->data_length + sizeof(Referee::Tail);
+    if (static_cast<size_t>(RXBUF_END - index) < FRAME_LEN) {
+      break;
     }
-    if (ref_data_.game_status.game_progress == 4 &&
-        !last_data_.game_status.game_progress) {
-      this->event_.Active(REF_GAME_START);
+
+    /* 3.验证整帧，长度以帧头中的data_length为准 */
+    if (!Component::CRC16::Verify(index, FRAME_LEN)) {
+      this->rx_stats_.crc16_err++;
+      index++;
+      continue;
     }
-    memcpy(&(this->last_data_), &(destination), sizeof(Data));
+
+    uint16_t cmd_id = 0;
+    memcpy(&cmd_id, index + sizeof(Referee::Header), sizeof(cmd_id));
+
+    this->Decode(cmd_id, index + sizeof(Referee::Header) + sizeof(cmd_id),
+                 header->data_length, NOW);
+
+    index += FRAME_LEN;
   }
 #if REF_VIRTUAL
 #if REF_FORCE_ONLINE
@@ -313,217 +298,397 @@ void Referee::Prase() {
   memset(rxbuf, 0, data_length);
 }
 
-bool Referee::Update() {
-  this->packet_sent_.Wait(UINT32_MAX);
+bool Referee::Decode(uint16_t cmd_id, const uint8_t *data, size_t len,
+                     uint32_t now) {
+  const int INDEX = MessageIndex(cmd_id);
+  if (INDEX < 0) {
+    this->rx_stats_.unknown_cmd++;
+    return false;
+  }
 
-  this->ui_lock_.Wait(UINT32_MAX);
+  /* 定长消息必须与结构体一致，变长消息不超过结构体 */
+  const RefMessageInfo &INFO = REF_MESSAGE_INFO[INDEX];
+  if (INFO.variable ? len > INFO.size : len != INFO.size) {
+    this->rx_stats_.length_err++;
+    return false;
+  }
 
-  bool done = false;
-  uint32_t ele_counter = 0;
-  uint32_t pack_size = 0;
-  CMDID cmd_id = REF_STDNT_CMD_ID_UI_DEL;
+  uint8_t *destination =
+      reinterpret_cast<uint8_t *>(&this->ref_data_) + INFO.offset;
+  memcpy(destination, data, len);
+  memset(destination + len, 0, INFO.size - len);
 
-  Component::UI::GraphicOperation op = Component::UI::UI_GRAPHIC_OP_NOTHING;
+  MessageStamp &stamp = this->ref_data_.stamp[INDEX];
+  stamp.seq++;
+  stamp.time = now;
 
-  if (!done && this->static_del_data_.Size() > 0) {
-    cmd_id = REF_STDNT_CMD_ID_UI_DEL;
-    pack_size = sizeof(UIDelPack);
-    done = true;
-    op = Component::UI::UI_GRAPHIC_OP_ADD;
+  this->rx_stats_.frame++;
+
+  switch (cmd_id) {
+    case REF_CMD_ID_ROBOT_DMG:
+      /* 装甲模块被弹丸击中 */
+      if (this->ref_data_.robot_damage.damage_type == 0x0) {
+        this->event_.Active(REF_ATTACKED);
+      }
+      break;
+    case REF_CMD_ID_GAME_STATUS:
+      if (this->ref_data_.game_status.game_progress == 4 &&
+          this->last_game_progress_ != 4) {
+        this->event_.Active(REF_GAME_START);
+      }
+      this->last_game_progress_ = this->ref_data_.game_status.game_progress;
+      break;
+    default:
+      break;
   }
 
-  if (bsp_time_get_ms() % 6000 > 3000) {
-    if (!done && this->static_string_data_.Size() > 0) {
-      cmd_id = REF_STDNT_CMD_ID_UI_STR;
-      pack_size = sizeof(UIStringPack);
-      done = true;
-      op = Component::UI::UI_GRAPHIC_OP_ADD;
-    }
+  return true;
+}
 
-    static_ele_data_.Reset();
-  } else {
-    if (!done && this->static_ele_data_.Size() > 0) {
-      switch (this->static_ele_data_.Size()) {
-        case 0:
-          break;
-        case 1:
-          cmd_id = REF_STDNT_CMD_ID_UI_DRAW1;
-          done = true;
-          op = Component::UI::UI_GRAPHIC_OP_ADD;
-          ele_counter = 1;
-          pack_size = sizeof(UIElePack_1);
-          break;
-        case 2:
-        case 3:
-        case 4:
-          cmd_id = REF_STDNT_CMD_ID_UI_DRAW2;
-          done = true;
-          op = Component::UI::UI_GRAPHIC_OP_ADD;
-          ele_counter = 2;
-          pack_size = sizeof(UIElePack_2);
-          break;
-        case 5:
-        case 6:
-          cmd_id = REF_STDNT_CMD_ID_UI_DRAW5;
-          done = true;
-          op = Component::UI::UI_GRAPHIC_OP_ADD;
-          ele_counter = 5;
-          pack_size = sizeof(UIElePack_5);
-          break;
-        default:
-          cmd_id = REF_STDNT_CMD_ID_UI_DRAW7;
-          done = true;
-          op = Component::UI::UI_GRAPHIC_OP_ADD;
-          ele_counter = 7;
-          pack_size = sizeof(UIElePack_7);
-          break;
-      }
+int Referee::MessageIndex(uint16_t cmd_id) {
+  if ((cmd_id >> 8) >= REF_CMD_INDEX_ROW ||
+      (cmd_id & 0xFF) >= REF_CMD_INDEX_COL) {
+    return -1;
+  }
+  return REF_MESSAGE_INDEX.index[cmd_id >> 8][cmd_id & 0xFF];
+}
+
+const Referee::MessageStamp &Referee::Stamp(const Data &data,
+                                            CommandID cmd_id) {
+  static const MessageStamp NONE = {};
+  const int INDEX = MessageIndex(cmd_id);
+  return INDEX < 0 ? NONE : data.stamp[INDEX];
+}
+
+bool Referee::Update() {
+  const uint32_t NOW = bsp_time_get_ms();
+
+  /* 两块缓冲区都在等待发送 */
+  if (this->tx_inflight_.load() >= 2) {
+    if (NOW - this->tx_start_time_ < REF_TX_TIMEOUT) {
+      return false;
     }
+    this->tx_inflight_ = 0;
+    this->tx_timeout_count_++;
+  }
+
+  TxBuffer &buff = tx_buff_[this->tx_fill_];
 
-    static_string_data_.Reset();
+  /* 高优先级通道没有待发送的数据或受频率限制时才轮到下一通道 */
+  TxLane lane = TX_LANE_DECISION;
+  size_t len = this->PackDecision(buff, NOW);
+
+  if (len == 0) {
+    lane = TX_LANE_INTERACTION;
+    len = this->PackInteraction(buff, NOW);
   }
 
-  if (!done && this->del_data_.Size() > 0) {
-    cmd_id = REF_STDNT_CMD_ID_UI_DEL;
-    pack_size = sizeof(UIDelPack);
-    done = true;
-    op = Component::UI::UI_GRAPHIC_OP_REWRITE;
+  if (len == 0) {
+    lane = TX_LANE_UI;
+    len = this->PackUI(buff, NOW);
   }
 
-  if (!done && this->string_data_.Size() > 0) {
-    cmd_id = REF_STDNT_CMD_ID_UI_STR;
-    pack_size = sizeof(UIStringPack);
-    done = true;
-    op = Component::UI::UI_GRAPHIC_OP_REWRITE;
+  if (len == 0) {
+    return false;
   }
 
-  if (!done && this->ele_data_.Size() > 0) {
-    switch (this->ele_data_.Size()) {
-      case 0:
-        break;
-      case 1:
-        cmd_id = REF_STDNT_CMD_ID_UI_DRAW1;
-        done = true;
-        op = Component::UI::UI_GRAPHIC_OP_REWRITE;
-        ele_counter = 1;
-        pack_size = sizeof(UIElePack_1);
-        break;
-      case 2:
-      case 3:
-      case 4:
-        cmd_id = REF_STDNT_CMD_ID_UI_DRAW2;
-        done = true;
-        op = Component::UI::UI_GRAPHIC_OP_REWRITE;
-        ele_counter = 2;
-        pack_size = sizeof(UIElePack_2);
-        break;
-      case 5:
-      case 6:
-        cmd_id = REF_STDNT_CMD_ID_UI_DRAW5;
-        done = true;
-        op = Component::UI::UI_GRAPHIC_OP_REWRITE;
-        ele_counter = 5;
-        pack_size = sizeof(UIElePack_5);
-        break;
-      default:
-        cmd_id = REF_STDNT_CMD_ID_UI_DRAW7;
-        done = true;
-        ele_counter = 7;
-        op = Component::UI::UI_GRAPHIC_OP_REWRITE;
-        pack_size = sizeof(UIElePack_7);
-        break;
+  this->tx_lane_time_[lane] = NOW;
+  this->tx_stats_[lane].sent++;
+  this->tx_stats_[lane].bytes += len;
+
+  buff.ui.raw.cmd_id = REF_CMD_ID_INTER_STUDENT; /* 0x0301 */
+
+  SetPacketHeader(buff.ui.raw.frame_header, len - 9);
+
+  /* CRC位于数据段之后，帧长度不同时位置不同 */
+  const uint16_t CRC = Component::CRC16::Calculate(
+      buff.raw, len - sizeof(uint16_t), CRC16_INIT);
+  memcpy(buff.raw + len - sizeof(uint16_t), &CRC, sizeof(CRC));
+
+  return this->StartTrans(len);
+}
+
+bool Referee::StartTrans(size_t len) {
+  const uint8_t FILL = this->tx_fill_;
+
+  this->tx_len_[FILL] = len;
+  this->tx_next_ = FILL;
+  this->tx_fill_ = FILL ^ 1;
+
+  /* DMA空闲时直接发送，否则由发送完成中断接着发送 */
+  if (this->tx_inflight_.fetch_add(1) == 0) {
+    this->tx_start_time_ = bsp_time_get_ms();
+    if (bsp_uart_transmit(BSP_UART_REF, tx_buff_[FILL].raw, len, false) !=
+        BSP_OK) {
+      this->tx_inflight_.fetch_sub(1);
+      return false;
     }
   }
 
-  if (!done) {
-    this->ui_lock_.Post();
-    this->packet_sent_.Post();
-    return false;
+  return true;
+}
+
+size_t Referee::PackDecision(TxBuffer &buff, uint32_t now) {
+  const RobotID ROBOT_ID =
+      static_cast<RobotID>(this->ref_data_.robot_status.robot_id);
+
+  /* 只有哨兵可以发送自主决策 */
+  if (!this->decision_valid_ ||
+      (ROBOT_ID != REF_BOT_RED_SENTRY && ROBOT_ID != REF_BOT_BLU_SENTRY)) {
+    return 0;
   }
 
-  this->ui_pack_.raw.cmd_id = REF_CMD_ID_INTER_STUDENT; /* 0x0301 */
+  const bool CHANGED =
+      memcmp(&this->data_from_sentry_, &this->decision_sent_,
+             sizeof(this->decision_sent_)) != 0;
+  const uint32_t ELAPSED = now - this->tx_lane_time_[TX_LANE_DECISION];
 
-  SetUIHeader(this->ui_pack_.raw.student_header, cmd_id,
-              static_cast<RobotID>(this->ref_data_.robot_status.robot_id));
+  if (!CHANGED && ELAPSED < REF_DECISION_REPEAT) {
+    return 0;
+  }
 
-  SetPacketHeader(this->ui_pack_.raw.frame_header, pack_size - 9);
+  if (ELAPSED < REF_DECISION_INTERVAL) {
+    this->tx_stats_[TX_LANE_DECISION].limited++;
+    return 0;
+  }
 
-  if (ele_counter) {
-    for (uint32_t i = 0; i < ele_counter; i++) {
-      if (op == Component::UI::UI_GRAPHIC_OP_REWRITE) {
-        this->ele_data_.Receive(this->ui_pack_.ele_7.ele_data[i]);
-      } else {
-        this->static_ele_data_.Receive(this->ui_pack_.ele_7.ele_data[i]);
-      }
-    }
+  SetSentryHeader(buff.sentry.student_header, REF_STDNT_CMD_ID_SENTRY_CMD,
+                  ROBOT_ID);
+  memcpy(&buff.sentry.data_cmd, &this->data_from_sentry_,
+         sizeof(buff.sentry.data_cmd));
+  this->decision_sent_ = this->data_from_sentry_;
 
-    uint16_t *crc_addr = reinterpret_cast<uint16_t *>(
-        &this->ui_pack_.ele_7.ele_data[ele_counter]);
+  return sizeof(SentryPack);
+}
 
-    *crc_addr = Component::CRC16::Calculate(
-        reinterpret_cast<const uint8_t *>(&this->ui_pack_),
-        pack_size - sizeof(uint16_t), CRC16_INIT);
-  } else if (cmd_id == REF_STDNT_CMD_ID_UI_DEL) {
-    if (op == Component::UI::UI_GRAPHIC_OP_REWRITE) {
-      this->del_data_.Receive(this->ui_pack_.del.del_data);
-    } else {
-      this->static_del_data_.Receive(this->ui_pack_.del.del_data);
+size_t Referee::PackInteraction(TxBuffer &buff, uint32_t now) {
+  if (!this->interaction_ready_) {
+    this->interaction_ready_ =
+        this->interaction_data_.Receive(this->interaction_pending_);
+    if (!this->interaction_ready_) {
+      return 0;
     }
-    this->ui_pack_.del.crc16 = Component::CRC16::Calculate(
-        reinterpret_cast<const uint8_t *>(&this->ui_pack_),
-        pack_size - sizeof(uint16_t), CRC16_INIT);
+  }
 
-  } else if (cmd_id == REF_STDNT_CMD_ID_UI_STR) {
-    if (op == Component::UI::UI_GRAPHIC_OP_REWRITE) {
-      this->string_data_.Receive(this->ui_pack_.str.str_data);
-    } else {
-      this->static_string_data_.Receive(this->ui_pack_.str.str_data);
-    }
-    this->ui_pack_.str.crc16 = Component::CRC16::Calculate(
-        reinterpret_cast<const uint8_t *>(&this->ui_pack_),
-        pack_size - sizeof(uint16_t), CRC16_INIT);
+  if (now - this->tx_lane_time_[TX_LANE_INTERACTION] <
+      REF_INTERACTION_INTERVAL) {
+    this->tx_stats_[TX_LANE_INTERACTION].limited++;
+    return 0;
   }
 
-  bsp_uart_transmit(BSP_UART_REF, reinterpret_cast<uint8_t *>(&this->ui_pack_),
-                    pack_size, false);
+  const InteractionData &data = this->interaction_pending_;
+
+  buff.interaction.student_header.cmd_id = static_cast<CMDID>(data.cmd_id);
+  buff.interaction.student_header.id_sender =
+      this->ref_data_.robot_status.robot_id;
+  buff.interaction.student_header.id_receiver = data.receiver;
+  memcpy(buff.interaction.data, data.data, data.len);
+
+  this->interaction_ready_ = false;
 
+  return sizeof(InteractionPack) - sizeof(buff.interaction.data) + data.len +
+         sizeof(uint16_t);
+}
+
+size_t Referee::PackUI(TxBuffer &buff, uint32_t now) {
+  /* 按上行带宽积累可发送的字节数，最多攒够两个最长的帧 */
+  this->ui_budget_ += static_cast<float>(now - this->ui_budget_time_) *
+                      UI_BANDWIDTH / 1000.0f;
+  this->ui_budget_time_ = now;
+  if (this->ui_budget_ > 2.0f * sizeof(UIElePack_7)) {
+    this->ui_budget_ = 2.0f * sizeof(UIElePack_7);
+  }
+
+  /* 每帧除数据段以外的帧头、子命令头与CRC */
+  const size_t OVERHEAD = sizeof(UIDelPack) - sizeof(Component::UI::Del);
+  const size_t BUDGET = this->ui_budget_ > OVERHEAD
+                            ? static_cast<size_t>(this->ui_budget_) - OVERHEAD
+                            : 0;
+
+  Component::UIScene::Frame frame;
+
+  this->ui_lock_.Wait(UINT32_MAX);
+  const bool READY = this->ui_scene_.Next(frame, now, BUDGET);
   this->ui_lock_.Post();
 
-  return true;
+  if (!READY) {
+    return 0;
+  }
+
+  CMDID cmd_id = REF_STDNT_CMD_ID_UI_DEL;
+  size_t pack_size = 0;
+
+  switch (frame.type) {
+    case Component::UIScene::FRAME_DEL:
+      cmd_id = REF_STDNT_CMD_ID_UI_DEL;
+      pack_size = sizeof(UIDelPack);
+      buff.ui.del.del_data = frame.del;
+      break;
+    case Component::UIScene::FRAME_STR:
+      cmd_id = REF_STDNT_CMD_ID_UI_STR;
+      pack_size = sizeof(UIStringPack);
+      buff.ui.str.str_data = frame.str;
+      break;
+    default:
+      switch (frame.ele_num) {
+        case 1:
+          cmd_id = REF_STDNT_CMD_ID_UI_DRAW1;
+          pack_size = sizeof(UIElePack_1);
+          break;
+        case 2:
+          cmd_id = REF_STDNT_CMD_ID_UI_DRAW2;
+          pack_size = sizeof(UIElePack_2);
+          break;
+        case 5:
+          cmd_id = REF_STDNT_CMD_ID_UI_DRAW5;
+          pack_size = sizeof(UIElePack_5);
+          break;
+        default:
+          cmd_id = REF_STDNT_CMD_ID_UI_DRAW7;
+          pack_size = sizeof(UIElePack_7);
+          break;
+      }
+      memcpy(buff.ui.ele_7.ele_data.data(), frame.ele,
+             frame.ele_num * sizeof(Component::UI::Ele));
+      break;
+  }
+
+  SetUIHeader(buff.ui.raw.student_header, cmd_id,
+              static_cast<RobotID>(this->ref_data_.robot_status.robot_id));
+
+  this->ui_budget_ -= static_cast<float>(pack_size);
+
+  return pack_size;
 }
 
 bool Referee::AddUI(Component::UI::Ele ui_data) {
+  const uint32_t NOW = bsp_time_get_ms();
+
   self_->ui_lock_.Wait(UINT32_MAX);
-  if (ui_data.op == Component::UI::UI_GRAPHIC_OP_ADD) {
-    self_->static_ele_data_.Send(ui_data);
-  } else {
-    self_->ele_data_.Send(ui_data);
-  }
+  bool ans = self_->ui_scene_.Update(ui_data, NOW) &&
+             self_->ui_scene_.Backlog(NOW) < REF_UI_BACKLOG;
   self_->ui_lock_.Post();
 
-  return true;
+  return ans;
 }
 
 bool Referee::AddUI(Component::UI::Del ui_data) {
   self_->ui_lock_.Wait(UINT32_MAX);
-  self_->del_data_.Send(ui_data);
+  bool ans = self_->ui_scene_.Delete(ui_data);
   self_->ui_lock_.Post();
 
-  return true;
+  return ans;
 }
 
 bool Referee::AddUI(Component::UI::Str ui_data) {
+  const uint32_t NOW = bsp_time_get_ms();
+
   self_->ui_lock_.Wait(UINT32_MAX);
-  if (ui_data.graphic.op == Component::UI::UI_GRAPHIC_OP_ADD) {
-    self_->static_string_data_.Send(ui_data);
-  } else {
-    self_->string_data_.Send(ui_data);
-  }
+  bool ans = self_->ui_scene_.Update(ui_data, NOW) &&
+             self_->ui_scene_.Backlog(NOW) < REF_UI_BACKLOG;
   self_->ui_lock_.Post();
 
+  return ans;
+}
+
+bool Referee::SendInteraction(uint16_t cmd_id, uint16_t receiver,
+                              const void *data, size_t len) {
+  if (len > INTERACTION_MAX_LEN) {
+    return false;
+  }
+
+  InteractionData interaction;
+  interaction.cmd_id = cmd_id;
+  interaction.receiver = receiver;
+  interaction.len = static_cast<uint8_t>(len);
+  memcpy(interaction.data, data, len);
+
+  if (!self_->interaction_data_.Send(interaction)) {
+    self_->tx_stats_[TX_LANE_INTERACTION].dropped++;
+    return false;
+  }
+
   return true;
 }
 
+int Referee::ShowCMD(Referee *ref, int argc, char **argv) {
+  if (argc == 1) {
+    printf("[rx]     打印各消息的接收统计\r\n");
+    printf("[tx]     打印各发送通道的统计\r\n");
+    printf("[ui]     打印操作手UI的发送统计\r\n");
+    printf("[reset]  清零统计\r\n");
+    printf("[redraw] 客户端重启后重新发送全部图形\r\n");
+  } else if (argc == 2) {
+    ref->ui_lock_.Wait(UINT32_MAX);
+
+    if (strcmp(argv[1], "rx") == 0) {
+      const uint32_t NOW = bsp_time_get_ms();
+      printf("frame:%lu crc8:%lu crc16:%lu length:%lu unknown:%lu\r\n",
+             static_cast<unsigned long>(ref->rx_stats_.frame),
+             static_cast<unsigned long>(ref->rx_stats_.crc8_err),
+             static_cast<unsigned long>(ref->rx_stats_.crc16_err),
+             static_cast<unsigned long>(ref->rx_stats_.length_err),
+             static_cast<unsigned long>(ref->rx_stats_.unknown_cmd));
+      printf("%-8s %8s %10s\r\n", "cmd", "seq", "age(ms)");
+      for (size_t i = 0; i < MESSAGE_NUM; i++) {
+        const MessageStamp &stamp = ref->ref_data_.stamp[i];
+        if (stamp.seq == 0) {
+          continue;
+        }
+        printf("0x%04x   %8lu %10lu\r\n", REF_MESSAGE_INFO[i].cmd_id,
+               static_cast<unsigned long>(stamp.seq),
+               static_cast<unsigned long>(NOW - stamp.time));
+      }
+    } else if (strcmp(argv[1], "tx") == 0) {
+      static const char *const LANE_NAME[] = {"decision", "interaction",
+                                              "ui"};
+      printf("%-12s %8s %10s %8s %8s\r\n", "lane", "sent", "bytes",
+             "limited", "dropped");
+      for (int i = 0; i < TX_LANE_NUM; i++) {
+        printf("%-12s %8lu %10lu %8lu %8lu\r\n", LANE_NAME[i],
+               static_cast<unsigned long>(ref->tx_stats_[i].sent),
+               static_cast<unsigned long>(ref->tx_stats_[i].bytes),
+               static_cast<unsigned long>(ref->tx_stats_[i].limited),
+               static_cast<unsigned long>(ref->tx_stats_[i].dropped));
+      }
+      printf("inflight:%u timeout:%lu\r\n",
+             static_cast<unsigned int>(ref->tx_inflight_.load()),
+             static_cast<unsigned long>(ref->tx_timeout_count_));
+    } else if (strcmp(argv[1], "ui") == 0) {
+      const Component::UIScene::Stats &stats = ref->ui_scene_.GetStats();
+      printf("graphic:%u/%d string:%u/%d\r\n",
+             static_cast<unsigned int>(ref->ui_scene_.EleCount()),
+             UI_SCENE_ELE_NUM,
+             static_cast<unsigned int>(ref->ui_scene_.StrCount()),
+             UI_SCENE_STR_NUM);
+      printf("sent:%lu refresh:%lu unchanged:%lu merged:%lu dropped:%lu\r\n",
+             static_cast<unsigned long>(stats.sent),
+             static_cast<unsigned long>(stats.refresh),
+             static_cast<unsigned long>(stats.unchanged),
+             static_cast<unsigned long>(stats.merged),
+             static_cast<unsigned long>(stats.dropped));
+      printf("del:%lu frame:%lu throttled:%lu bytes:%lu\r\n",
+             static_cast<unsigned long>(stats.del),
+             static_cast<unsigned long>(stats.frame),
+             static_cast<unsigned long>(stats.throttled),
+             static_cast<unsigned long>(ref->tx_stats_[TX_LANE_UI].bytes));
+    } else if (strcmp(argv[1], "reset") == 0) {
+      ref->ui_scene_.ResetStats();
+      memset(&ref->rx_stats_, 0, sizeof(ref->rx_stats_));
+      memset(ref->tx_stats_, 0, sizeof(ref->tx_stats_));
+      ref->tx_timeout_count_ = 0;
+    } else if (strcmp(argv[1], "redraw") == 0) {
+      ref->ui_scene_.Invalidate();
+    } else {
+      printf("参数错误\r\n");
+    }
+
+    ref->ui_lock_.Post();
+  }
+
+  return 0;
+}
+
 void Referee::SetUIHeader(Referee::InterStudentHeader &header,
                           const Referee::CMDID CMD_ID,
                           Referee::RobotID robot_id) {
@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <device.hpp>
 
+#include "comp_snapshot.hpp"
 #include "comp_ui.hpp"
+#include "comp_ui_scene.hpp"
 
 #define GAME_HEAT_INCREASE_42MM (100.0f) /* 每发射一颗42mm弹丸增加100热量 */
 #define GAME_HEAT_INCREASE_17MM (10.0f) /* 每发射一颗17mm弹丸增加10热量 */
@@ -304,7 +307,7 @@ class Referee {
     float position_y;
     uint8_t commd_keyboard;
     uint8_t robot_id;
-    uint8_t cmd_source;
+    uint16_t cmd_source;
   } ClientMap; /* 0x0303 */
 
   typedef struct __attribute__((packed)) {
@@ -406,39 +409,67 @@ class Referee {
     uint16_t id_receiver;
   } InterStudentHeader;
 
+  /*
+    下行消息表：命令码(省略REF_CMD_ID_前缀)、数据类型、Data中的成员、长度是否可变。
+    Data的成员与解析表均由此生成，新增消息只需在此添加一行。
+  */
+#define REF_MESSAGE_TABLE(X)                                                   \
+  X(GAME_STATUS, GameStatus, game_status, false)                               \
+  X(GAME_RESULT, GameResult, game_result, false)                               \
+  X(GAME_ROBOT_HP, RobotHP, game_robot_hp, false)                              \
+  X(FIELD_EVENTS, FieldEvents, field_event, false)                             \
+  X(SUPPLY_ACTION, SupplyAction, supply_action, false)                         \
+  X(WARNING, Warning, warning, false)                                          \
+  X(DART_COUNTDOWN, DartCountdown, dart_countdown, false)                      \
+  X(ROBOT_STATUS, RobotStatus, robot_status, false)                            \
+  X(POWER_HEAT_DATA, PowerHeat, power_heat, false)                             \
+  X(ROBOT_POS, RobotPOS, robot_pos, false)                                     \
+  X(ROBOT_BUFF, RobotBuff, robot_buff, false)                                  \
+  X(DRONE_ENERGY, DroneEnergy, drone_energy, false)                            \
+  X(ROBOT_DMG, RobotDamage, robot_damage, false)                               \
+  X(LAUNCHER_DATA, LauncherData, launcher_data, false)                         \
+  X(BULLET_REMAINING, BulletRemain, bullet_remain, false)                      \
+  X(RFID, RFID, rfid, false)                                                   \
+  X(DART_CLIENT, DartClient, dart_client, false)                               \
+  X(CLIENT_MAP, ClientMap, client_map, false)                                  \
+  X(KEYBOARD_MOUSE, KeyboardMouse, keyboard_mouse, false)                      \
+  X(SENTRY_POS_DATA, SentryPosition, sentry_postion, false)                    \
+  X(ROBOT_POS_DATA, RobotPosition, robot_position, false)                      \
+  X(INTER_STUDENT_CUSTOM, CustomController, custom_controller, true)           \
+  X(ROBOT_POS_TO_SENTRY, RobotPosForSentry, robot_pos_for_snetry, false)       \
+  X(RADAR_MARK, RadarMarkProgress, radar_mark_progress, false)                 \
+  X(SENTRY_DECISION, SentryInfo, sentry_decision, false)                       \
+  X(RADAR_DECISION, RadarInfo, radar_decision, false)                          \
+  X(INTER_STUDENT, RobotInteractionData, robot_ineraction_data, true)          \
+  X(MAP_ROBOT_DATA, MapRobotData, map_robot_data, false)                       \
+  X(CUSTOM_KEYBOARD_MOUSE, CustomKeyMouseData, custom_key_mouse_data, false)
+
+#define REF_MESSAGE_COUNT(cmd, type, name, variable) +1
+  static constexpr size_t MESSAGE_NUM = 0 REF_MESSAGE_TABLE(REF_MESSAGE_COUNT);
+#undef REF_MESSAGE_COUNT
+
+  typedef struct {
+    uint32_t seq;  /* 收到的次数，0表示尚未收到 */
+    uint32_t time; /* 最近一次收到的时间，单位ms */
+  } MessageStamp;
+
   typedef struct {
     Status status;
-    GameStatus game_status;                     /* 0x0001 */
-    GameResult game_result;                     /* 0x0002 */
-    RobotHP game_robot_hp;                      /* 0x0003 */
-    FieldEvents field_event;                    /* 0x0101 */
-    SupplyAction supply_action;                 /* 0x0102 */
-    Warning warning;                            /* 0x0104 */
-    DartCountdown dart_countdown;               /* 0x0105 */
-    RobotStatus robot_status;                   /* 0x0201 */
-    PowerHeat power_heat;                       /* 0x0202 */
-    RobotPOS robot_pos;                         /* 0x0203 */
-    RobotBuff robot_buff;                       /* 0x0204 */
-    DroneEnergy drone_energy;                   /* 0x0205 */
-    RobotDamage robot_damage;                   /* 0x0206 */
-    LauncherData launcher_data;                 /* 0x0207 */
-    BulletRemain bullet_remain;                 /* 0x0208 */
-    RFID rfid;                                  /* 0x0209 */
-    DartClient dart_client;                     /* 0x020A */
-    ClientMap client_map;                       /* 0x0303 */
-    KeyboardMouse keyboard_mouse;               /* 0x0304 */
-    SentryPosition sentry_postion;              /* 0x0307 */
-    RobotPosition robot_position;               /* 0x0308 */
-    CustomController custom_controller;         /* 0x0302 */
-    RobotPosForSentry robot_pos_for_snetry;     /* 0x020B */
-    RadarMarkProgress radar_mark_progress;      /* 0x020C */
-    SentryInfo sentry_decision;                 /* 0x020D */
-    RadarInfo radar_decision;                   /* 0x020E */
-    RobotInteractionData robot_ineraction_data; /* 0x0301 */
-    MapRobotData map_robot_data;                /* 0x0305 */
-    CustomKeyMouseData custom_key_mouse_data;   /* 0x0306 */
+#define REF_DATA_MEMBER(cmd, type, name, variable) type name;
+    REF_MESSAGE_TABLE(REF_DATA_MEMBER)
+#undef REF_DATA_MEMBER
+    /* 与REF_MESSAGE_TABLE顺序一致，订阅者比较序号判断各子结构是否更新 */
+    MessageStamp stamp[MESSAGE_NUM];
   } Data;
 
+  typedef struct {
+    uint32_t frame;       /* 解析成功的消息数 */
+    uint32_t crc8_err;    /* 帧头校验失败 */
+    uint32_t crc16_err;   /* 整帧校验失败 */
+    uint32_t length_err;  /* 数据段长度与消息表不符 */
+    uint32_t unknown_cmd; /* 消息表中没有的命令码 */
+  } RxStats;
+
   typedef struct __attribute__((packed)) {
     Header frame_header;
     uint16_t cmd_id;
@@ -523,6 +554,45 @@ class Referee {
     uint16_t crc16;
   } RadarPack;
 
+  /* 机器人间交互数据段的最大长度 */
+  static constexpr size_t INTERACTION_MAX_LEN = 112;
+
+  typedef struct __attribute__((packed)) {
+    Header frame_header;
+    uint16_t cmd_id;
+    Referee::InterStudentHeader student_header;
+    uint8_t data[INTERACTION_MAX_LEN + sizeof(uint16_t)]; /* 数据段后紧跟CRC */
+  } InteractionPack;
+
+  typedef struct {
+    uint16_t cmd_id; /* 0x0200~0x02FF */
+    uint16_t receiver;
+    uint8_t len;
+    uint8_t data[INTERACTION_MAX_LEN];
+  } InteractionData;
+
+  /* 发送通道，按优先级排列 */
+  typedef enum {
+    TX_LANE_DECISION,    /* 哨兵自主决策 */
+    TX_LANE_INTERACTION, /* 机器人间交互 */
+    TX_LANE_UI,          /* 操作手UI */
+    TX_LANE_NUM,
+  } TxLane;
+
+  typedef struct {
+    uint32_t sent;
+    uint32_t bytes;
+    uint32_t limited; /* 因频率限制推迟的次数 */
+    uint32_t dropped; /* 队列已满丢弃 */
+  } TxLaneStats;
+
+  union TxBuffer {
+    UIPack ui;
+    SentryPack sentry;
+    InteractionPack interaction;
+    uint8_t raw[sizeof(InteractionPack)];
+  };
+
   Referee();
 
   bool UIStackEmpty();
@@ -533,18 +603,35 @@ class Referee {
 
   void Prase();
 
+  /* 按消息表拷贝数据段，长度不符或命令码未知时返回false */
+  bool Decode(uint16_t cmd_id, const uint8_t *data, size_t len, uint32_t now);
+
+  /* 消息在REF_MESSAGE_TABLE中的位置，未知命令码返回-1 */
+  static int MessageIndex(uint16_t cmd_id);
+
+  static const MessageStamp &Stamp(const Data &data, CommandID cmd_id);
+
   bool Update();
 
+  /* 返回false表示场景已满或UI通道积压，调用者可降低刷新频率 */
   static bool AddUI(Component::UI::Ele ui_data);
   static bool AddUI(Component::UI::Del ui_data);
   static bool AddUI(Component::UI::Str ui_data);
 
+  /* 队列已满时返回false */
+  static bool SendInteraction(uint16_t cmd_id, uint16_t receiver,
+                              const void *data, size_t len);
+
   static float UIGetHeight() { return 1080.0f; }
   static float UIGetWidth() { return 1920.0f; }
 
-  bool PackUI();
+  size_t PackDecision(TxBuffer &buff, uint32_t now);
+
+  size_t PackInteraction(TxBuffer &buff, uint32_t now);
 
-  bool StartTrans();
+  size_t PackUI(TxBuffer &buff, uint32_t now);
+
+  bool StartTrans(size_t len);
 
   void SetUIHeader(InterStudentHeader &header, const CMDID CMD_ID,
                    RobotID robot_id);
@@ -553,51 +640,64 @@ class Referee {
 
   void SetPacketHeader(Referee::Header &header, uint16_t data_length);
 
+  static int ShowCMD(Referee *ref, int argc, char **argv);
+
  private:
   System::Semaphore raw_ready_ = System::Semaphore(false);
-  System::Semaphore packet_sent_ = System::Semaphore(true);
 
   System::Thread recv_thread_;
   System::Thread trans_thread_;
 
   Message::Topic<Data> ref_data_tp_ = Message::Topic<Data>("referee");
 
-  System::Queue<Component::UI::Ele> ele_data_ =
-      System::Queue<Component::UI::Ele>(10);
+  /* 供控制线程原地读取，每帧只拷贝一次 */
+  Component::Snapshot<Data> ref_snapshot_ =
+      Component::Snapshot<Data>("referee");
 
-  System::Queue<Component::UI::Str> string_data_ =
-      System::Queue<Component::UI::Str>(10);
+  /* 操作手UI，由ui_lock_保护 */
+  Component::UIScene ui_scene_ = Component::UIScene(
+      UI_SCENE_ELE_NUM, UI_SCENE_STR_NUM, UI_STATIC_CYCLE);
 
-  System::Queue<Component::UI::Del> del_data_ =
-      System::Queue<Component::UI::Del>(10);
+  /* 上行带宽令牌桶，单位字节 */
+  float ui_budget_ = 0.0f;
+  uint32_t ui_budget_time_ = 0;
 
-  System::Queue<Component::UI::Ele> static_ele_data_ =
-      System::Queue<Component::UI::Ele>(10);
-
-  System::Queue<Component::UI::Str> static_string_data_ =
-      System::Queue<Component::UI::Str>(10);
+  System::Semaphore ui_lock_ = System::Semaphore(true);
 
-  System::Queue<Component::UI::Del> static_del_data_ =
-      System::Queue<Component::UI::Del>(10);
+  System::Queue<InteractionData> interaction_data_ =
+      System::Queue<InteractionData>(4);
 
-  System::Queue<SentryDecisionData> sentry_data_ =
-      System::Queue<SentryDecisionData>(10);
+  /* 已从队列取出、等待频率限制的交互数据 */
+  InteractionData interaction_pending_;
+  bool interaction_ready_ = false;
 
-  System::Semaphore ui_lock_ = System::Semaphore(true);
+  /* 双缓冲发送，一块由DMA发送时在另一块中组帧 */
+  static TxBuffer tx_buff_[2];
+  uint16_t tx_len_[2] = {};
+  uint8_t tx_fill_ = 0;
+  volatile uint8_t tx_next_ = 0;
+  std::atomic<uint8_t> tx_inflight_{0};
+  uint32_t tx_start_time_ = 0;
+  uint32_t tx_timeout_count_ = 0;
 
-  System::Semaphore sentry_lock_ = System::Semaphore(true);
+  uint32_t tx_lane_time_[TX_LANE_NUM] = {};
+  TxLaneStats tx_stats_[TX_LANE_NUM] = {};
 
   Data ref_data_;
 
-  Data last_data_;
-
-  Message::Event event_;
+  RxStats rx_stats_{};
 
-  static UIPack ui_pack_;
+  uint8_t last_game_progress_ = 0;
 
-  static SentryPack sentry_pack_;
+  Message::Event event_;
 
   static Referee *self_;
   SentryDecisionData data_from_sentry_;
+  SentryDecisionData decision_sent_;
+  bool decision_valid_ = false;
+
+  System::Term::Command<Referee *> cmd_;
 };
 }  // namespace Device
+
+COMP_TOPIC_DECLARE("referee", Device::Referee::Data);
@@ -1,9 +1,16 @@
 #include "dev_camera.hpp"
 
+#ifndef USE_HEADLESS
 #include "webots/camera.h"
+#endif
 
 using namespace Device;
 
+/* 无Webots时没有图像 */
+#ifdef USE_HEADLESS
+Camera::Camera() {}
+#else
 Camera::Camera() : handle_(wb_robot_get_device("camera")) {
   wb_camera_enable(this->handle_, 10);
 }
+#endif
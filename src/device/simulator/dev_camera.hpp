@@ -1,6 +1,8 @@
 #include <device.hpp>
 
+#ifndef USE_HEADLESS
 #include "webots/robot.h"
+#endif
 
 namespace Device {
 class Camera {
@@ -8,6 +10,8 @@ class Camera {
   Camera();
 
  private:
+#ifndef USE_HEADLESS
   WbDeviceTag handle_;
+#endif
 };
 }  // namespace Device
@@ -9,10 +9,14 @@ using namespace Device;
 
 Cap::Cap(Cap::Param &param) : info_tp_("cap_info") {
   XB_UNUSED(param);
+
+  Component::TopicRegistry<Component::TopicHash("cap_info")>::Register(
+      this->info_tp_);
   info_ = {
       .input_volt_ = 25.0f,
       .cap_volt_ = 23.0f,
       .input_curr_ = 0.4f,
+      .output_power_ = 0.0f,
       .target_power_ = 100.0f,
       .percentage_ = 1.0f,
       .online_ = false,
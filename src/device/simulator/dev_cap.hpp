@@ -14,6 +14,7 @@ class Cap {
     float input_volt_;
     float cap_volt_;
     float input_curr_;
+    float output_power_;
     float target_power_;
     float percentage_;
     bool online_;
@@ -34,3 +35,5 @@ class Cap {
   Cap::Info info_;
 };
 }  // namespace Device
+
+COMP_TOPIC_DECLARE("cap_info", Device::Cap::Info);
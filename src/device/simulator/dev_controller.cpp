@@ -1,6 +1,10 @@
 #include "dev_controller.hpp"
 
+#include "bsp_time.h"
+
+#ifndef USE_HEADLESS
 #include <webots/keyboard.h>
+#endif
 
 using namespace Device;
 
@@ -9,6 +13,25 @@ TerminalController::TerminalController()
       cmd_tp_("cmd_rc"),
       cmd_(this, this->ControlCMD, "control", System::Term::BinDir()) {
   Component::CMD::RegisterController(this->cmd_tp_);
+
+  Component::TopicRegistry<Component::TopicHash("chassis_yaw")>::Register(
+      this->yaw_tp_);
+
+  System::Timer::Create(StopMove, this, 10);
+}
+
+void TerminalController::StopMove(TerminalController* ctrl) {
+  if (!ctrl->moving_ ||
+      static_cast<int32_t>(bsp_time_get_ms() - ctrl->stop_time_) < 0) {
+    return;
+  }
+
+  ctrl->moving_ = false;
+
+  ctrl->cmd_data_.chassis.x = 0.0f;
+  ctrl->cmd_data_.chassis.y = 0.0f;
+
+  ctrl->cmd_tp_.Publish(ctrl->cmd_data_);
 }
 
 int TerminalController::ControlCMD(TerminalController* ctrl, int argc,
@@ -23,6 +46,10 @@ int TerminalController::ControlCMD(TerminalController* ctrl, int argc,
     } else if (!strcmp(argv[1], "stop")) {
       ctrl->event_.Active(STOP_CTRL);
     } else if (!strcmp(argv[1], "keyboard")) {
+#ifdef USE_HEADLESS
+      printf("无Webots时不支持键盘控制\r\n");
+      return -1;
+#else
       printf(
           "Start keyboard control. press w/a/s/d to move, q/e to turn, and r "
           "to exit.\r\n");
@@ -90,7 +117,7 @@ int TerminalController::ControlCMD(TerminalController* ctrl, int argc,
         ctrl->cmd_data_.chassis.z = 0.0f;
         ctrl->cmd_tp_.Publish(ctrl->cmd_data_);
       }
-
+#endif
     } else {
       printf("参数错误\r\n");
       return -1;
@@ -125,12 +152,9 @@ int TerminalController::ControlCMD(TerminalController* ctrl, int argc,
 
     ctrl->cmd_tp_.Publish(ctrl->cmd_data_);
 
-    System::Thread::Sleep(time);
-
-    ctrl->cmd_data_.chassis.x = 0.0f;
-    ctrl->cmd_data_.chassis.y = 0.0f;
-
-    ctrl->cmd_tp_.Publish(ctrl->cmd_data_);
+    /* 由定时器停止，命令立即返回，移动期间其他任务照常运行 */
+    ctrl->stop_time_ = bsp_time_get_ms() + time;
+    ctrl->moving_ = true;
   } else {
     printf("参数错误\r\n");
   }
@@ -14,6 +14,9 @@ class TerminalController {
 
   static int ControlCMD(TerminalController* ctrl, int argc, char** argv);
 
+  /* 到达stop_time_后停止移动 */
+  static void StopMove(TerminalController* ctrl);
+
  private:
   Message::Event event_;
 
@@ -21,6 +24,10 @@ class TerminalController {
 
   Component::CMD::Data cmd_data_;
 
+  bool moving_ = false;
+
+  uint32_t stop_time_ = 0;
+
   System::Term::Command<TerminalController*> cmd_;
 
   Message::Topic<float> yaw_tp_ = Message::Topic<float>("chassis_yaw");
@@ -3,9 +3,14 @@
 #include <comp_utils.hpp>
 
 #include "bsp_time.h"
+
+#ifdef USE_HEADLESS
+#include "dev_sim_world.hpp"
+#else
 #include "webots/accelerometer.h"
 #include "webots/gyro.h"
 #include "webots/inertial_unit.h"
+#endif
 
 using namespace Device;
 
@@ -13,31 +18,47 @@ IMU::IMU(IMU::Param& param)
     : accl_tp_((param.tp_name_prefix + std::string("_accl")).c_str()),
       gyro_tp_((param.tp_name_prefix + std::string("_gyro")).c_str()),
       eulr_tp_((param.tp_name_prefix + std::string("_eulr")).c_str()),
-      ahrs_handle_(wb_robot_get_device("imu")),
-      gyro_handle_(wb_robot_get_device("gyro")),
-      accl_handle_(wb_robot_get_device("accl")),
       cmd_(this, IMU::ShowCMD, "imu", System::Term::DevDir()) {
+#ifndef USE_HEADLESS
+  this->ahrs_handle_ = wb_robot_get_device("imu");
+  this->gyro_handle_ = wb_robot_get_device("gyro");
+  this->accl_handle_ = wb_robot_get_device("accl");
+
   wb_inertial_unit_enable(this->ahrs_handle_, 1);
   wb_accelerometer_enable(this->accl_handle_, 1);
   wb_gyro_enable(this->gyro_handle_, 1);
+#endif
 
   auto thread_fn = [](IMU* imu) {
-    uint32_t last_online_time = bsp_time_get_ms();
-
-    while (1) {
-      imu->accl_tp_.Publish(imu->accl_);
-      imu->gyro_tp_.Publish(imu->gyro_);
-      imu->eulr_tp_.Publish(imu->eulr_);
+    imu->accl_tp_.Publish(imu->accl_);
+    imu->gyro_tp_.Publish(imu->gyro_);
+    imu->eulr_tp_.Publish(imu->eulr_);
 
-      imu->Update();
-
-      imu->thread_.SleepUntil(1, last_online_time);
-    }
+    imu->Update();
   };
 
-  this->thread_.Create(thread_fn, this, "imu", 512, System::Thread::REALTIME);
+  this->thread_.CreatePeriodic(thread_fn, this, "imu", 512,
+                               System::Thread::REALTIME, 1);
 }
 
+#ifdef USE_HEADLESS
+/* 水平地面上的理想IMU，角速度与加速度来自底盘运动学 */
+void IMU::Update() {
+  const SimWorld::Body& BODY = SimWorld::GetBody();
+
+  this->eulr_.rol = 0.0f;
+  this->eulr_.pit = 0.0f;
+  this->eulr_.yaw = BODY.yaw;
+
+  this->gyro_.x = 0.0f;
+  this->gyro_.y = 0.0f;
+  this->gyro_.z = BODY.wz;
+
+  this->accl_.x = BODY.ax;
+  this->accl_.y = BODY.ay;
+  this->accl_.z = M_1G;
+}
+#else
 void IMU::Update() {
   const double* accl_data = wb_accelerometer_get_values(this->accl_handle_);
   const double* gyro_data = wb_gyro_get_values(this->gyro_handle_);
@@ -68,6 +89,7 @@ void IMU::Update() {
   this->accl_.y = static_cast<float>(accl_data[1]);
   this->accl_.z = static_cast<float>(accl_data[2]);
 }
+#endif
 
 int IMU::ShowCMD(IMU* imu, int argc, char** argv) {
   if (argc == 1) {
@@ -1,6 +1,8 @@
 #include <device.hpp>
 
+#ifndef USE_HEADLESS
 #include "webots/robot.h"
+#endif
 
 namespace Device {
 class IMU {
@@ -20,9 +22,11 @@ class IMU {
   Message::Topic<Component::Type::Vector3> gyro_tp_;
   Message::Topic<Component::Type::Eulr> eulr_tp_;
 
+#ifndef USE_HEADLESS
   WbDeviceTag ahrs_handle_;
   WbDeviceTag gyro_handle_;
   WbDeviceTag accl_handle_;
+#endif
 
   Component::Type::Vector3 accl_;
   Component::Type::Vector3 gyro_;
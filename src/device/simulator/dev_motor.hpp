@@ -1,13 +1,16 @@
 #pragma once
 
+#ifndef USE_HEADLESS
 #include <webots/motor.h>
 #include <webots/position_sensor.h>
 #include <webots/robot.h>
+#endif
 
 #include <comp_type.hpp>
 #include <device.hpp>
 
 #include "bsp_time.h"
+#include "dev_sim_world.hpp"
 
 namespace Device {
 class BaseMotor {
@@ -20,22 +23,52 @@ class BaseMotor {
   } Feedback;
 
   BaseMotor(const char *name)
-      : handle_(wb_robot_get_device(name)),
-        cmd_(this, BaseMotor::ShowCMD, this->name_, System::Term::DevDir()) {
+      : cmd_(this, BaseMotor::ShowCMD, this->name_, System::Term::DevDir()) {
     strncpy(this->name_, name, sizeof(this->name_));
     memset(&(this->feedback_), 0, sizeof(this->feedback_));
+#ifdef USE_HEADLESS
+    this->joint_ = SimWorld::CreateJoint(this->name_);
+#else
+    this->handle_ = wb_robot_get_device(name);
     this->sensor_ =
         wb_robot_get_device((std::string(name) + "_Sensor").c_str());
     wb_motor_set_position(this->handle_, INFINITY);
     wb_motor_set_velocity(this->handle_, 0.0f);
     wb_position_sensor_enable(this->sensor_, 1);
+#endif
   }
 
   virtual void Control(float output) = 0;
 
   virtual bool Update() = 0;
 
-  void Relax() { wb_motor_set_torque(this->handle_, 0.0f); }
+  void Relax() { this->SetTorque(0.0f); }
+
+  /* 输出轴力矩 单位：N*m */
+  void SetTorque(float torque) {
+#ifdef USE_HEADLESS
+    this->joint_->SetTorque(torque);
+#else
+    wb_motor_set_torque(this->handle_, torque);
+#endif
+  }
+
+  /* 输出轴角度 单位：rad */
+  float GetPosition() {
+#ifdef USE_HEADLESS
+    return this->joint_->GetPosition();
+#else
+    return static_cast<float>(wb_position_sensor_get_value(this->sensor_));
+#endif
+  }
+
+  float GetTorqueFeedback() {
+#ifdef USE_HEADLESS
+    return this->joint_->GetTorque();
+#else
+    return static_cast<float>(wb_motor_get_torque_feedback(this->handle_));
+#endif
+  }
 
   float GetAngle() { return this->feedback_.rotor_abs_angle; }
 
@@ -83,9 +116,13 @@ class BaseMotor {
 
   uint32_t last_sensor_time_ = 0;
 
+#ifdef USE_HEADLESS
+  SimWorld::Joint *joint_;
+#else
   WbDeviceTag handle_;
 
   WbDeviceTag sensor_;
+#endif
 
   System::Term::Command<BaseMotor *> cmd_;
 };
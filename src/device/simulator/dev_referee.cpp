@@ -4,22 +4,24 @@
 
 #include "dev_referee.hpp"
 
+#include "bsp_time.h"
+
 using namespace Device;
 
 Referee::Referee() {
-  auto ref_recv_thread = [](Referee *ref) {
-    while (1) {
-      ref->Prase();
+  Component::TopicRegistry<Component::TopicHash("referee")>::Register(
+      this->ref_data_tp_);
 
-      /* 发布裁判系统数据 */
-      ref->ref_data_tp_.Publish(ref->ref_data_);
+  auto ref_recv_thread = [](Referee *ref) {
+    ref->Prase();
 
-      ref->recv_thread_.Sleep(10);
-    }
+    /* 发布裁判系统数据 */
+    ref->ref_data_tp_.Publish(ref->ref_data_);
+    ref->ref_snapshot_.Publish(ref->ref_data_);
   };
 
-  this->recv_thread_.Create(ref_recv_thread, this, "ref_recv_thread", 256,
-                            System::Thread::REALTIME);
+  this->recv_thread_.CreatePeriodic(ref_recv_thread, this, "ref_recv_thread",
+                                    256, System::Thread::REALTIME, 10);
 }
 
 void Referee::Prase() {
@@ -30,4 +32,6 @@ void Referee::Prase() {
   this->ref_data_.robot_status.launcher_42_speed_limit = REF_LAUNCH_SPEED;
   this->ref_data_.robot_status.chassis_power_limit = REF_POWER_LIMIT;
   this->ref_data_.power_heat.chassis_pwr_buff = REF_POWER_BUFF;
+  this->ref_data_.stamp.seq++;
+  this->ref_data_.stamp.time = bsp_time_get_ms();
 }
@@ -6,6 +6,7 @@
 
 #include <device.hpp>
 
+#include "comp_snapshot.hpp"
 #include "comp_ui.hpp"
 
 #define REF_UI_BOX_UP_OFFSET (4)
@@ -322,6 +323,11 @@ class Referee {
     Referee::InterStudentHeader student_header;
   } UIPacketHeader;
 
+  typedef struct {
+    uint32_t seq;
+    uint32_t time;
+  } MessageStamp;
+
   typedef struct {
     Status status;
     GameStatus game_status;
@@ -345,12 +351,18 @@ class Referee {
     DartClient dart_client;
     ClientMap client_map;
     KeyboardMouse keyboard_mouse;
+    MessageStamp stamp; /* 仿真中所有数据同时生成，共用一个序号 */
   } Data;
 
   Referee();
 
   void Prase();
 
+  static const MessageStamp &Stamp(const Data &data, CommandID cmd_id) {
+    XB_UNUSED(cmd_id);
+    return data.stamp;
+  }
+
   static bool AddUI(Component::UI::Ele ui_data) {
     XB_UNUSED(ui_data);
     return true;
@@ -374,6 +386,12 @@ class Referee {
 
   Message::Topic<Data> ref_data_tp_ = Message::Topic<Data>("referee");
 
+  /* 供控制线程原地读取，每帧只拷贝一次 */
+  Component::Snapshot<Data> ref_snapshot_ =
+      Component::Snapshot<Data>("referee");
+
   Data ref_data_;
 };
 }  // namespace Device
+
+COMP_TOPIC_DECLARE("referee", Device::Referee::Data);
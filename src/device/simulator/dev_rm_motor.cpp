@@ -7,10 +7,37 @@
 #define T_2006 (1.0f)
 #define T_6020 (1.2f)
 
+/* 无Webots时的输出轴空载转速 单位：rad/s */
+#define W_3508 (49.6f) /* 转子9000rpm，减速比19 */
+#define W_2006 (43.6f) /* 转子15000rpm，减速比36 */
+#define W_6020 (33.5f)
+
+/* 折算到输出轴的负载惯量 单位：kg*m^2 */
+#define J_3508 (0.02f) /* 底盘轮，含四分之一车体 */
+#define J_2006 (0.002f)
+#define J_6020 (0.01f)
+
 using namespace Device;
 
 RMMotor::RMMotor(const Param& param, const char* name)
-    : BaseMotor(name), param_(param) {}
+    : BaseMotor(name), param_(param) {
+#ifdef USE_HEADLESS
+  switch (this->param_.model) {
+    case MOTOR_M2006:
+      this->joint_->SetParam(T_2006, W_2006, J_2006);
+      break;
+    case MOTOR_M3508:
+      this->joint_->SetParam(T_3508, W_3508, J_3508);
+      break;
+    case MOTOR_GM6020:
+      this->joint_->SetParam(T_6020, W_6020, J_6020);
+      break;
+    default:
+      XB_ASSERT(false);
+      return;
+  }
+#endif
+}
 
 void RMMotor::Control(float output) {
   clampf(&output, -1.0f, 1.0f);
@@ -30,7 +57,7 @@ void RMMotor::Control(float output) {
       return;
   }
 
-  wb_motor_set_torque(this->handle_, output);
+  this->SetTorque(output);
 }
 
 bool RMMotor::Update() {
@@ -38,8 +65,7 @@ bool RMMotor::Update() {
     return false;
   }
 
-  Component::Type::CycleValue raw_pos =
-      static_cast<float>(wb_position_sensor_get_value(this->sensor_));
+  Component::Type::CycleValue raw_pos = this->GetPosition();
 
   this->feedback_.rotational_speed =
       (raw_pos - this->last_pos_) /
@@ -56,8 +82,7 @@ bool RMMotor::Update() {
 
   this->last_sensor_time_ = bsp_time_get_ms();
 
-  this->feedback_.torque_current =
-      static_cast<float>(wb_motor_get_torque_feedback(this->handle_));
+  this->feedback_.torque_current = this->GetTorqueFeedback();
 
   return true;
 }
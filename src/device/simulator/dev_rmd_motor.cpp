@@ -3,18 +3,28 @@
 #include <comp_type.hpp>
 #include <comp_utils.hpp>
 
+#define T_RMD (4.5f)
+
+/* 无Webots时的输出轴空载转速与负载惯量 */
+#define W_RMD (30.0f)
+#define J_RMD (0.05f)
+
 using namespace Device;
 
 RMDMotor::RMDMotor(const Param& param, const char* name)
-    : BaseMotor(name), param_(param) {}
+    : BaseMotor(name), param_(param) {
+#ifdef USE_HEADLESS
+  this->joint_->SetParam(T_RMD, W_RMD, J_RMD);
+#endif
+}
 
 void RMDMotor::Control(float output) {
   clampf(&output, -1.0f, 1.0f);
-  output *= 4.5;
+  output *= T_RMD;
   if (!param_.reverse) {
-    wb_motor_set_torque(this->handle_, output);
+    this->SetTorque(output);
   } else {
-    wb_motor_set_torque(this->handle_, -output);
+    this->SetTorque(-output);
   }
 }
 
@@ -23,8 +33,7 @@ bool RMDMotor::Update() {
     return false;
   }
 
-  Component::Type::CycleValue raw_pos =
-      static_cast<float>(wb_position_sensor_get_value(this->sensor_));
+  Component::Type::CycleValue raw_pos = this->GetPosition();
 
   this->feedback_.rotational_speed =
       (raw_pos - this->last_pos_) /
@@ -40,8 +49,7 @@ bool RMDMotor::Update() {
 
   this->last_sensor_time_ = bsp_time_get_ms();
 
-  this->feedback_.torque_current =
-      static_cast<float>(wb_motor_get_torque_feedback(this->handle_));
+  this->feedback_.torque_current = this->GetTorqueFeedback();
 
   return true;
 }
@@ -0,0 +1,151 @@
+/*
+  无Webots时的简化物理环境。
+*/
+
+#include "dev_sim_world.hpp"
+
+#include <cstdlib>
+
+/* 与Mecanum.wbt中的模型一致 */
+#define SIM_WHEEL_RADIUS (0.05f)
+#define SIM_CHASSIS_LX (0.15f) /* 轮子到车体中心的纵向距离 单位：m */
+#define SIM_CHASSIS_LY (0.20f) /* 轮子到车体中心的横向距离 单位：m */
+
+#define SIM_WORLD_CYCLE (1) /* 积分周期 单位：ms */
+
+using namespace Device;
+
+SimWorld *SimWorld::self_ = NULL;
+
+void SimWorld::Joint::SetParam(float torque_max, float speed_max,
+                               float inertia) {
+  XB_ASSERT(speed_max > 0.0f);
+  XB_ASSERT(inertia > 0.0f);
+
+  this->damping_ = torque_max / speed_max;
+  this->inertia_ = inertia;
+}
+
+void SimWorld::Joint::Step(float dt) {
+  if (this->damping_ <= 0.0f) {
+    return;
+  }
+
+  /* 力矩在周期内不变，按一阶系统的解析解积分，步长不影响稳定性 */
+  const float SPEED_SS = this->torque_ / this->damping_;
+  const float TIME_CONST = this->inertia_ / this->damping_;
+  const float DECAY = expf(-dt / TIME_CONST);
+
+  this->position_ += SPEED_SS * dt +
+                     (this->speed_ - SPEED_SS) * (1.0f - DECAY) * TIME_CONST;
+  this->speed_ = SPEED_SS + (this->speed_ - SPEED_SS) * DECAY;
+
+  if (this->position_ >= M_2PI) {
+    this->position_ -= M_2PI;
+  } else if (this->position_ < 0.0f) {
+    this->position_ += M_2PI;
+  }
+}
+
+SimWorld::SimWorld() : cmd_(this, ShowCMD, "world", System::Term::DevDir()) {
+  memset(this->wheel_, 0, sizeof(this->wheel_));
+  memset(&(this->body_), 0, sizeof(this->body_));
+
+  auto world_thread = [](SimWorld *world) {
+    world->Step(static_cast<float>(SIM_WORLD_CYCLE) / 1000.0f);
+  };
+
+  /* 优先级最高，同一时刻的设备读到的都是积分后的状态 */
+  this->thread_.CreatePeriodic(world_thread, this, "sim_world", 512,
+                               System::Thread::REALTIME, SIM_WORLD_CYCLE);
+}
+
+SimWorld::Joint *SimWorld::CreateJoint(const char *name) {
+  if (self_ == NULL) {
+    self_ = new SimWorld();
+  }
+
+  XB_ASSERT(self_->joint_num_ < JOINT_NUM);
+
+  Joint *joint = &(self_->joint_[self_->joint_num_++]);
+  memset(joint, 0, sizeof(*joint));
+  joint->name_ = name;
+
+  if (strncmp(name, "Chassis_", 8) == 0) {
+    const int INDEX = atoi(name + 8);
+    if (INDEX >= 0 && INDEX < static_cast<int>(WHEEL_NUM)) {
+      self_->wheel_[INDEX] = joint;
+    }
+  }
+
+  return joint;
+}
+
+const SimWorld::Body &SimWorld::GetBody() {
+  if (self_ == NULL) {
+    self_ = new SimWorld();
+  }
+
+  return self_->body_;
+}
+
+void SimWorld::Step(float dt) {
+  for (size_t i = 0; i < this->joint_num_; i++) {
+    this->joint_[i].Step(dt);
+  }
+
+  this->UpdateBody(dt);
+}
+
+void SimWorld::UpdateBody(float dt) {
+  for (size_t i = 0; i < WHEEL_NUM; i++) {
+    if (this->wheel_[i] == NULL) {
+      return;
+    }
+  }
+
+  const float W0 = this->wheel_[0]->speed_;
+  const float W1 = this->wheel_[1]->speed_;
+  const float W2 = this->wheel_[2]->speed_;
+  const float W3 = this->wheel_[3]->speed_;
+
+  /* Component::Mixer中麦克纳姆轮解算的逆运算 */
+  const float VX = (W0 + W1 - W2 - W3) / 4.0f * SIM_WHEEL_RADIUS;
+  const float VY = (-W0 + W1 + W2 - W3) / 4.0f * SIM_WHEEL_RADIUS;
+  const float WZ = (W0 + W1 + W2 + W3) / 4.0f * SIM_WHEEL_RADIUS /
+                   (SIM_CHASSIS_LX + SIM_CHASSIS_LY);
+
+  /* 车体坐标系随车体转动，加速度包含向心项 */
+  this->body_.ax = (VX - this->body_.vx) / dt - WZ * VY;
+  this->body_.ay = (VY - this->body_.vy) / dt + WZ * VX;
+
+  this->body_.vx = VX;
+  this->body_.vy = VY;
+  this->body_.wz = WZ;
+
+  this->body_.yaw += WZ * dt;
+  if (this->body_.yaw >= M_2PI) {
+    this->body_.yaw -= M_2PI;
+  } else if (this->body_.yaw < 0.0f) {
+    this->body_.yaw += M_2PI;
+  }
+}
+
+int SimWorld::ShowCMD(SimWorld *world, int argc, char **argv) {
+  if (argc == 1) {
+    printf("[show] 打印车体与关节状态\r\n");
+  } else if (argc == 2 && strcmp(argv[1], "show") == 0) {
+    const Body &BODY = world->body_;
+    printf("body vx:%f vy:%f wz:%f yaw:%f\r\n", BODY.vx, BODY.vy, BODY.wz,
+           BODY.yaw);
+    for (size_t i = 0; i < world->joint_num_; i++) {
+      const Joint &JOINT = world->joint_[i];
+      printf("%-12s torque:%f speed:%frad/s pos:%f\r\n", JOINT.name_,
+             JOINT.torque_, JOINT.speed_, JOINT.position_);
+    }
+  } else {
+    printf("参数错误\r\n");
+  }
+
+  return 0;
+}
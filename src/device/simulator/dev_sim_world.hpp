@@ -0,0 +1,79 @@
+/*
+  无Webots时的简化物理环境。
+  每个关节按一阶直流电机模型 J*dω/dt = τ - b*ω 积分，
+  b由最大力矩与空载转速确定，J包含分摊到该关节的负载惯量。
+  四个底盘关节按麦克纳姆轮运动学推出车体速度，供IMU模型使用。
+*/
+
+#pragma once
+
+#include <device.hpp>
+
+namespace Device {
+class SimWorld {
+ public:
+  class Joint {
+   public:
+    /* torque_max单位N*m，speed_max单位rad/s，inertia单位kg*m^2 */
+    void SetParam(float torque_max, float speed_max, float inertia);
+
+    void SetTorque(float torque) { this->torque_ = torque; }
+
+    float GetPosition() { return this->position_; }
+
+    float GetSpeed() { return this->speed_; }
+
+    float GetTorque() { return this->torque_; }
+
+   private:
+    void Step(float dt);
+
+    const char *name_;
+    float damping_;
+    float inertia_;
+    float torque_;
+    float speed_;
+    float position_;
+
+    friend class SimWorld;
+  };
+
+  typedef struct {
+    float vx, vy; /* 车体坐标系下的速度 单位：m/s */
+    float wz;     /* 偏航角速度 单位：rad/s */
+    float ax, ay; /* 车体坐标系下的加速度 单位：m/s^2 */
+    float yaw;    /* 偏航角 单位：rad */
+  } Body;
+
+  /* 首次调用时创建物理环境 */
+  static Joint *CreateJoint(const char *name);
+
+  /* 没有底盘关节时车体保持静止 */
+  static const Body &GetBody();
+
+  static int ShowCMD(SimWorld *world, int argc, char **argv);
+
+ private:
+  static constexpr size_t JOINT_NUM = 16;
+  static constexpr size_t WHEEL_NUM = 4;
+
+  SimWorld();
+
+  void Step(float dt);
+
+  void UpdateBody(float dt);
+
+  static SimWorld *self_;
+
+  Joint joint_[JOINT_NUM];
+  size_t joint_num_ = 0;
+
+  Joint *wheel_[WHEEL_NUM];
+
+  Body body_;
+
+  System::Term::Command<SimWorld *> cmd_;
+
+  System::Thread thread_;
+};
+}  // namespace Device
@@ -21,11 +21,10 @@ CanfdImu::CanfdImu()
       canfd_enable_("canfd_enable", false),
       cmd_(this, SetCMD, "set_imu") {
   auto thread_fn = [](CanfdImu *imu) {
-    auto quat_sub =
-        Message::Subscriber<Component::Type::Quaternion>("imu_quat");
-    auto gyro_sub = Message::Subscriber<Component::Type::Vector3>("imu_gyro");
-    auto accl_sub = Message::Subscriber<Component::Type::Vector3>("imu_accl");
-    auto eulr_sub = Message::Subscriber<Component::Type::Eulr>("imu_eulr");
+    Component::StaticSubscriber<Component::TopicHash("imu_quat")> quat_sub;
+    Component::StaticSubscriber<Component::TopicHash("imu_gyro")> gyro_sub;
+    Component::StaticSubscriber<Component::TopicHash("imu_accl")> accl_sub;
+    Component::StaticSubscriber<Component::TopicHash("imu_eulr")> eulr_sub;
 
     uint32_t last_wakeup = bsp_time_get_ms();
 
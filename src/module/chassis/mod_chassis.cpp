@@ -47,15 +47,16 @@ template <typename Motor, typename MotorParam>
 Chassis<Motor, MotorParam>::Chassis(Param& param, float control_freq)
     : param_(param),
       mode_(Chassis::RELAX),
+      actuator_(param.actuator_param, control_freq),
       mixer_(param.type),
       follow_pid_(param.follow_pid_param, control_freq),
-      ctrl_lock_(true) {
+      power_limiter_({param.toque_coefficient_, param.speed_2_coefficient_,
+                      param.out_2_coefficient_, param.constant_}),
+      ctrl_lock_(true),
+      power_cmd_(this, ShowPower, "chassis_power") {
   memset(&(this->cmd_), 0, sizeof(this->cmd_));
 
   for (uint8_t i = 0; i < this->mixer_.len_; i++) {
-    this->actuator_.at(i) =
-        new Component::SpeedActuator(param.actuator_param.at(i), control_freq);
-
     this->motor_.at(i) =
         new Motor(param.motor_param.at(i),
                   (std::string("Chassis_") + std::to_string(i)).c_str());
@@ -93,38 +94,26 @@ Chassis<Motor, MotorParam>::Chassis(Param& param, float control_freq)
                                                         this->param_.EVENT_MAP);
 
   auto chassis_thread = [](Chassis* chassis) {
-    auto raw_ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
-    auto cmd_sub =
-        Message::Subscriber<Component::CMD::ChassisCMD>("cmd_chassis");
-
-    auto yaw_sub = Message::Subscriber<float>("chassis_yaw");
-
-    auto cap_sub = Message::Subscriber<Device::Cap::Info>("cap_info");
-
-    uint32_t last_online_time = bsp_time_get_ms();
-
-    while (1) {
-      /* 读取控制指令、电容、裁判系统、电机反馈 */
-      cmd_sub.DumpData(chassis->cmd_);
-      raw_ref_sub.DumpData(chassis->raw_ref_);
-      yaw_sub.DumpData(chassis->yaw_);
-      cap_sub.DumpData(chassis->cap_);
-
-      /* 更新反馈值 */
+    /* 读取控制指令、电容、裁判系统、电机反馈 */
+    chassis->cmd_sub_.DumpData(chassis->cmd_);
+    chassis->yaw_sub_.DumpData(chassis->yaw_);
+    chassis->cap_sub_.DumpData(chassis->cap_);
+
+    /* 更新反馈值 */
+    /* 裁判系统数据只在更新时解析 */
+    if (chassis->raw_ref_.Update()) {
       chassis->PraseRef();
-
-      chassis->ctrl_lock_.Wait(UINT32_MAX);
-      chassis->UpdateFeedback();
-      chassis->Control();
-      chassis->ctrl_lock_.Post();
-
-      /* 运行结束，等待下一次唤醒 */
-      chassis->thread_.SleepUntil(2, last_online_time);
     }
+
+    chassis->ctrl_lock_.Wait(UINT32_MAX);
+    chassis->UpdateFeedback();
+    chassis->Control();
+    chassis->ctrl_lock_.Post();
   };
 
-  this->thread_.Create(chassis_thread, this, "chassis_thread",
-                       MODULE_CHASSIS_TASK_STACK_DEPTH, System::Thread::MEDIUM);
+  this->thread_.CreatePeriodic(chassis_thread, this, "chassis_thread",
+                               MODULE_CHASSIS_TASK_STACK_DEPTH,
+                               System::Thread::MEDIUM, 2);
 
   System::Timer::Create(this->DrawUIStatic, this, 2100);
 
@@ -152,28 +141,42 @@ template <typename Motor, typename MotorParam>
 bool Chassis<Motor, MotorParam>::LimitChassisOutPower(float power_limit,
                                                       float* motor_out,
                                                       float* speed_rpm,
+                                                      const float* error,
                                                       uint32_t len) {
   if (power_limit < 0.0f) {
     return 0;
   }
-  float sum_motor_power = 0.0f;
-  float motor_power[4];
-  for (size_t i = 0; i < len; i++) {
-    motor_power[i] =
-        this->param_.toque_coefficient_ * fabsf(motor_out[i]) *
-            fabsf(speed_rpm[i]) +
-        this->param_.speed_2_coefficient_ * speed_rpm[i] * speed_rpm[i] +
-        this->param_.out_2_coefficient_ * motor_out[i] * motor_out[i];
-    sum_motor_power += motor_power[i];
-  }
-  sum_motor_power += this->param_.constant_;
-  if (sum_motor_power > power_limit) {
-    for (size_t i = 0; i < len; i++) {
-      motor_out[i] *= power_limit / sum_motor_power;
+  return this->power_limiter_.Allocate(power_limit, motor_out, speed_rpm,
+                                       error, len);
+}
+
+template <typename Motor, typename MotorParam>
+void Chassis<Motor, MotorParam>::FitPowerModel() {
+  /* 测得的功率为新数据时，与上个周期的输出对应 */
+  float power = 0.0f;
+  if (this->cap_.online_) {
+    if (this->cap_.output_power_ == this->last_cap_power_) {
+      return;
     }
+    this->last_cap_power_ = this->cap_.output_power_;
+    power = this->cap_.output_power_;
+  } else if (this->ref_.status == Device::Referee::RUNNING &&
+             this->power_sample_) {
+    this->power_sample_ = false;
+    power = this->ref_.chassis_watt;
+  } else {
+    return;
   }
-  return true;
+
+  /* 底盘静止时也有静态功耗，读数为0说明没有测量 */
+  if (power <= 0.0f) {
+    return;
+  }
+
+  this->power_limiter_.Fit(this->last_out_, this->motor_feedback_,
+                           this->mixer_.len_, power);
 }
+
 template <typename Motor, typename MotorParam>
 void Chassis<Motor, MotorParam>::Control() {
   this->now_ = bsp_time_get();
@@ -202,8 +205,8 @@ void Chassis<Motor, MotorParam>::Control() {
                                   */
     case Chassis::ROTOR: {
       float beta = this->yaw_;
-      float cos_beta = cosf(beta);
-      float sin_beta = sinf(beta);
+      float cos_beta = 0.0f, sin_beta = 0.0f;
+      Component::FastMath::SinCos(beta, &sin_beta, &cos_beta);
       this->move_vec_.vx = cos_beta * this->cmd_.x - sin_beta * this->cmd_.y;
       this->move_vec_.vy = sin_beta * this->cmd_.x + cos_beta * this->cmd_.y;
       break;
@@ -265,23 +268,25 @@ void Chassis<Motor, MotorParam>::Control() {
       float max_power_limit =
           ref_.chassis_power_limit +
           ref_.chassis_power_limit * 0.2 * this->cap_.percentage_;
+      this->FitPowerModel();
+
+      float setpoint[4] = {}, feedback[4] = {}, error[4] = {};
       for (unsigned i = 0; i < this->mixer_.len_; i++) {
-        out_.motor_out[i] = this->actuator_[i]->Calculate(
-            this->setpoint_.motor_rotational_speed[i] *
-                max_motor_rotational_speed_,
-            this->motor_[i]->GetSpeed(), this->dt_);
+        setpoint[i] = this->setpoint_.motor_rotational_speed[i] *
+                      max_motor_rotational_speed_;
+        feedback[i] = this->motor_[i]->GetSpeed();
+        error[i] = setpoint[i] - feedback[i];
       }
-      for (unsigned i = 0; i < this->mixer_.len_; i++) {
-        if (cap_.online_) {
-          LimitChassisOutPower(max_power_limit, out_.motor_out, motor_feedback_,
-                               this->mixer_.len_);
-          this->motor_[i]->Control(out_.motor_out[i]);
+      this->actuator_.Calculate(setpoint, feedback, this->dt_, out_.motor_out);
 
-        } else {
-          LimitChassisOutPower(ref_.chassis_power_limit, out_.motor_out,
-                               motor_feedback_, this->mixer_.len_);
-          this->motor_[i]->Control(out_.motor_out[i]);
-        }
+      /* 整车只限制一次，再分别输出 */
+      LimitChassisOutPower(
+          cap_.online_ ? max_power_limit : ref_.chassis_power_limit,
+          out_.motor_out, motor_feedback_, error, this->mixer_.len_);
+
+      for (unsigned i = 0; i < this->mixer_.len_; i++) {
+        this->motor_[i]->Control(out_.motor_out[i]);
+        this->last_out_[i] = out_.motor_out[i];
       }
 
       break;
@@ -300,10 +305,18 @@ void Chassis<Motor, MotorParam>::Control() {
 template <typename Motor, typename MotorParam>
 void Chassis<Motor, MotorParam>::PraseRef() {
   this->ref_.chassis_power_limit =
-      this->raw_ref_.robot_status.chassis_power_limit;
-  this->ref_.chassis_pwr_buff = this->raw_ref_.power_heat.chassis_pwr_buff;
-  this->ref_.chassis_watt = this->raw_ref_.power_heat.chassis_watt;
-  this->ref_.status = this->raw_ref_.status;
+      this->raw_ref_->robot_status.chassis_power_limit;
+  this->ref_.chassis_pwr_buff = this->raw_ref_->power_heat.chassis_pwr_buff;
+  this->ref_.chassis_watt = this->raw_ref_->power_heat.chassis_watt;
+  this->ref_.status = this->raw_ref_->status;
+
+  /* 其他消息到达时功率值不变，不作为新样本 */
+  const Device::Referee::MessageStamp& STAMP = Device::Referee::Stamp(
+      *this->raw_ref_, Device::Referee::REF_CMD_ID_POWER_HEAT_DATA);
+  if (STAMP.seq != this->power_seq_) {
+    this->power_seq_ = STAMP.seq;
+    this->power_sample_ = true;
+  }
 }
 
 template <typename Motor, typename MotorParam>
@@ -313,6 +326,33 @@ float Chassis<Motor, MotorParam>::CalcWz(const float LO, const float HI) {
   return wz_vary;
 }
 
+template <typename Motor, typename MotorParam>
+int Chassis<Motor, MotorParam>::ShowPower(Chassis<Motor, MotorParam>* chassis,
+                                          int argc, char** argv) {
+  if (argc == 1) {
+    printf("[show]   打印功率模型与拟合残差\r\n");
+    printf("[reset]  恢复初始功率模型\r\n");
+  } else if (argc == 2) {
+    chassis->ctrl_lock_.Wait(UINT32_MAX);
+
+    if (strcmp(argv[1], "show") == 0) {
+      chassis->power_limiter_.PrintInfo();
+      printf("estimate:%.1f W\r\n",
+             static_cast<double>(chassis->power_limiter_.Estimate(
+                 chassis->last_out_, chassis->motor_feedback_,
+                 chassis->mixer_.len_)));
+    } else if (strcmp(argv[1], "reset") == 0) {
+      chassis->power_limiter_.Reset();
+    } else {
+      printf("参数错误\r\n");
+    }
+
+    chassis->ctrl_lock_.Post();
+  }
+
+  return 0;
+}
+
 template <typename Motor, typename MotorParam>
 void Chassis<Motor, MotorParam>::SetMode(Chassis::Mode mode) {
   if (mode == this->mode_) {
@@ -324,9 +364,7 @@ void Chassis<Motor, MotorParam>::SetMode(Chassis::Mode mode) {
     this->wz_dir_mult_ = (std::rand() % 2) ? -1 : 1;
   }
   /* 切换模式后重置PID和滤波器 */
-  for (size_t i = 0; i < this->mixer_.len_; i++) {
-    this->actuator_[i]->Reset();
-  }
+  this->actuator_.Reset();
   this->mode_ = mode;
 }
 
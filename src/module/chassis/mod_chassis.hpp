@@ -18,6 +18,7 @@
 #include "comp_filter.hpp"
 #include "comp_mixer.hpp"
 #include "comp_pid.hpp"
+#include "comp_power_limit.hpp"
 #include "dev_cap.hpp"
 #include "dev_motor.hpp"
 #include "dev_referee.hpp"
@@ -79,7 +80,9 @@ class Chassis {
   void SetMode(Mode mode);
 
   bool LimitChassisOutPower(float power_limit, float *motor_out, float *speed,
-                            uint32_t len);
+                            const float *error, uint32_t len);
+
+  void FitPowerModel();
   uint16_t MAXSPEEDGET(float power_limit);
 
   void PraseRef();
@@ -90,6 +93,9 @@ class Chassis {
 
   float CalcWz(const float LO, const float HI);
 
+  static int ShowPower(Chassis<Motor, MotorParam> *chassis, int argc,
+                       char **argv);
+
  private:
   Param param_;
 
@@ -109,7 +115,7 @@ class Chassis {
 
   Device::Cap::Info cap_;
 
-  std::array<Component::SpeedActuator *, 4> actuator_;
+  Component::ActuatorBank<4> actuator_;
 
   std::array<Device::BaseMotor *, 4> motor_;
 
@@ -133,12 +139,24 @@ class Chassis {
 
   Component::PID follow_pid_; /* 跟随云台用的PID */
 
+  /* 功率模型由电容或裁判系统测得的功率在线修正 */
+  Component::PowerLimiter power_limiter_;
+  float last_out_[4] = {}; /* 上个周期实际输出，与之后测得的功率对应 */
+  float last_cap_power_ = 0.0f;
+  uint32_t power_seq_ = 0;
+  bool power_sample_ = false; /* 裁判系统功率数据已更新 */
+
   System::Thread thread_;
 
   System::Semaphore ctrl_lock_;
 
+  Component::StaticSubscriber<Component::TopicHash("cmd_chassis")> cmd_sub_;
+  Component::StaticSubscriber<Component::TopicHash("chassis_yaw")> yaw_sub_;
+  Component::StaticSubscriber<Component::TopicHash("cap_info")> cap_sub_;
+
   float yaw_;
-  Device::Referee::Data raw_ref_;
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
 
   Component::CMD::ChassisCMD cmd_;
 
@@ -147,6 +165,8 @@ class Chassis {
   Component::UI::Line line_;
 
   Component::UI::Rectangle rectange_;
+
+  System::Term::Command<Chassis<Motor, MotorParam> *> power_cmd_;
 };
 
 typedef Chassis<Device::RMMotor, Device::RMMotor::Param> RMChassis;
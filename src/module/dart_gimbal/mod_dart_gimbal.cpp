@@ -26,7 +26,7 @@ Dartgimbal::Dartgimbal(Dartgimbal::Param& param, float control_freq)
       event_callback, this, this->param_.EVENT_MAP);
 
   auto thread_fn = [](Dartgimbal* dart_gimbal) {
-    auto cmd_sub = Message::Subscriber<Component::CMD::GimbalCMD>("cmd_gimbal");
+    Component::StaticSubscriber<Component::TopicHash("cmd_gimbal")> cmd_sub;
 
     uint32_t last_online_time = bsp_time_get_ms();
 
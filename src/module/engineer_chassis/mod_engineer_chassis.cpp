@@ -70,8 +70,7 @@ Chassis<Motor, MotorParam>::Chassis(Param& param, float control_freq)
                                                         this->param_.EVENT_MAP);
 
   auto chassis_thread = [](Chassis* chassis) {
-    auto cmd_sub =
-        Message::Subscriber<Component::CMD::ChassisCMD>("cmd_chassis");
+    Component::StaticSubscriber<Component::TopicHash("cmd_chassis")> cmd_sub;
     uint32_t last_online_time = bsp_time_get_ms();
     while (1) {
       /* 读取控制指令、电容、裁判系统、电机反馈 */
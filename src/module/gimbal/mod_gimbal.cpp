@@ -18,6 +18,9 @@ Gimbal::Gimbal(Param& param, float control_freq)
       yaw_motor_(this->param_.yaw_motor, "Gimbal_Yaw"),
       pit_motor_(this->param_.pit_motor, "Gimbal_Pitch"),
       ctrl_lock_(true) {
+  Component::TopicRegistry<Component::TopicHash("chassis_yaw")>::Register(
+      this->yaw_tp_);
+
   auto event_callback = [](GimbalEvent event, Gimbal* gimbal) {
     gimbal->ctrl_lock_.Wait(UINT32_MAX);
 
@@ -41,34 +44,22 @@ Gimbal::Gimbal(Param& param, float control_freq)
                                                       this->param_.EVENT_MAP);
 
   auto gimbal_thread = [](Gimbal* gimbal) {
-    auto eulr_sub = Message::Subscriber<Component::Type::Eulr>("imu_eulr");
-
-    auto gyro_sub = Message::Subscriber<Component::Type::Vector3>("imu_gyro");
-
-    auto cmd_sub = Message::Subscriber<Component::CMD::GimbalCMD>("cmd_gimbal");
-
-    uint32_t last_online_time = bsp_time_get_ms();
-
-    while (1) {
-      /* 读取控制指令、姿态、IMU、电机反馈 */
-      eulr_sub.DumpData(gimbal->eulr_); /* imu */
-      gyro_sub.DumpData(gimbal->gyro_); /* imu */
-      cmd_sub.DumpData(gimbal->cmd_);   /* cmd */
+    /* 读取控制指令、姿态、IMU、电机反馈 */
+    gimbal->eulr_sub_.DumpData(gimbal->eulr_); /* imu */
+    gimbal->gyro_sub_.DumpData(gimbal->gyro_); /* imu */
+    gimbal->cmd_sub_.DumpData(gimbal->cmd_);   /* cmd */
 
-      gimbal->ctrl_lock_.Wait(UINT32_MAX);
-      gimbal->UpdateFeedback();
-      gimbal->Control();
-      gimbal->ctrl_lock_.Post();
-
-      gimbal->yaw_tp_.Publish(gimbal->yaw_);
+    gimbal->ctrl_lock_.Wait(UINT32_MAX);
+    gimbal->UpdateFeedback();
+    gimbal->Control();
+    gimbal->ctrl_lock_.Post();
 
-      /* 运行结束，等待下一次唤醒 */
-      gimbal->thread_.SleepUntil(2, last_online_time);
-    }
+    gimbal->yaw_tp_.Publish(gimbal->yaw_);
   };
 
-  this->thread_.Create(gimbal_thread, this, "gimbal_thread",
-                       MODULE_GIMBAL_TASK_STACK_DEPTH, System::Thread::MEDIUM);
+  this->thread_.CreatePeriodic(gimbal_thread, this, "gimbal_thread",
+                               MODULE_GIMBAL_TASK_STACK_DEPTH,
+                               System::Thread::MEDIUM, 2);
 
   System::Timer::Create(this->DrawUIStatic, this, 2000);
 
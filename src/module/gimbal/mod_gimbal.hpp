@@ -100,6 +100,10 @@ class Gimbal {
 
   System::Semaphore ctrl_lock_;
 
+  Component::StaticSubscriber<Component::TopicHash("imu_eulr")> eulr_sub_;
+  Component::StaticSubscriber<Component::TopicHash("imu_gyro")> gyro_sub_;
+  Component::StaticSubscriber<Component::TopicHash("cmd_gimbal")> cmd_sub_;
+
   Message::Topic<float> yaw_tp_ = Message::Topic<float>("chassis_yaw");
 
   float yaw_;
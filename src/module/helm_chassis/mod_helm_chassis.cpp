@@ -61,6 +61,7 @@ template <typename Motor, typename MotorParam>
 HelmChassis<Motor, MotorParam>::HelmChassis(Param& param, float control_freq)
     : param_(param),
       mode_(HelmChassis::RELAX),
+      speed_actr_(param.speed_param, control_freq),
       follow_pid_(param.follow_pid_param, control_freq),
       ctrl_lock_(true) {
   memset(&(this->cmd_), 0, sizeof(this->cmd_));
@@ -73,9 +74,6 @@ HelmChassis<Motor, MotorParam>::HelmChassis(Param& param, float control_freq)
   }
 
   for (uint8_t i = 0; i < 4; i++) {
-    this->speed_actr_.at(i) =
-        new Component::SpeedActuator(param.speed_param.at(i), control_freq);
-
     this->speed_motor_.at(i) =
         new Motor(param.speed_motor_param.at(i),
                   (std::string("Chassis_speed_") + std::to_string(i)).c_str());
@@ -112,11 +110,9 @@ HelmChassis<Motor, MotorParam>::HelmChassis(Param& param, float control_freq)
       event_callback, this, this->param_.EVENT_MAP);
 
   auto chassis_thread = [](HelmChassis* chassis) {
-    auto cmd_sub =
-        Message::Subscriber<Component::CMD::ChassisCMD>("cmd_chassis");
-    auto yaw_sub = Message::Subscriber<float>("chassis_yaw");
-    auto raw_ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
-    auto cap_sub = Message::Subscriber<Device::Cap::Info>("cap_info");
+    Component::StaticSubscriber<Component::TopicHash("cmd_chassis")> cmd_sub;
+    Component::StaticSubscriber<Component::TopicHash("chassis_yaw")> yaw_sub;
+    Component::StaticSubscriber<Component::TopicHash("cap_info")> cap_sub;
 
     uint32_t last_online_time = bsp_time_get_ms();
 
@@ -124,12 +120,14 @@ HelmChassis<Motor, MotorParam>::HelmChassis(Param& param, float control_freq)
       /* 读取控制指令、电容、裁判系统、电机反馈 */
       cmd_sub.DumpData(chassis->cmd_);
       yaw_sub.DumpData(chassis->yaw_);
-      raw_ref_sub.DumpData(chassis->raw_ref_);
       cap_sub.DumpData(chassis->cap_);
 
       chassis->ctrl_lock_.Wait(UINT32_MAX);
       /* 更新反馈值 */
-      chassis->PraseRef();
+      /* 裁判系统数据只在更新时解析 */
+      if (chassis->raw_ref_.Update()) {
+        chassis->PraseRef();
+      }
       chassis->UpdateFeedback();
       chassis->Control();
       chassis->ctrl_lock_.Post();
@@ -150,10 +148,10 @@ HelmChassis<Motor, MotorParam>::HelmChassis(Param& param, float control_freq)
 template <typename Motor, typename MotorParam>
 void HelmChassis<Motor, MotorParam>::PraseRef() {
   this->ref_.chassis_power_limit =
-      this->raw_ref_.robot_status.chassis_power_limit;
-  this->ref_.chassis_pwr_buff = this->raw_ref_.power_heat.chassis_pwr_buff;
-  this->ref_.chassis_watt = this->raw_ref_.power_heat.chassis_watt;
-  this->ref_.status = this->raw_ref_.status;
+      this->raw_ref_->robot_status.chassis_power_limit;
+  this->ref_.chassis_pwr_buff = this->raw_ref_->power_heat.chassis_pwr_buff;
+  this->ref_.chassis_watt = this->raw_ref_->power_heat.chassis_watt;
+  this->ref_.status = this->raw_ref_->status;
 }
 template <typename Motor, typename MotorParam>
 void HelmChassis<Motor, MotorParam>::UpdateFeedback() {
@@ -238,7 +236,8 @@ void HelmChassis<Motor, MotorParam>::Control() {
       this->move_vec_.vx = 0;
       this->move_vec_.vy = tmp;
       if (tmp >= 0.1) {
-        this->direct_offset_ = -(atan2(cmd_.y, cmd_.x) - M_PI / 2.0f);
+        this->direct_offset_ =
+            -(Component::FastMath::Atan2(cmd_.y, cmd_.x) - M_PI / 2.0f);
       } else {
         this->direct_offset_ = 0;
       }
@@ -247,8 +246,8 @@ void HelmChassis<Motor, MotorParam>::Control() {
     case HelmChassis::CHASSIS_FOLLOW_GIMBAL:
     case HelmChassis::ROTOR: {
       float beta = this->yaw_;
-      float cos_beta = cosf(beta);
-      float sin_beta = sinf(beta);
+      float cos_beta = 0.0f, sin_beta = 0.0f;
+      Component::FastMath::SinCos(beta, &sin_beta, &cos_beta);
       this->move_vec_.vx = cos_beta * this->cmd_.x - sin_beta * this->cmd_.y;
       this->move_vec_.vy = sin_beta * this->cmd_.x + cos_beta * this->cmd_.y;
       break;
@@ -311,12 +310,16 @@ void HelmChassis<Motor, MotorParam>::Control() {
       break;
     case HelmChassis::CHASSIS_FOLLOW_GIMBAL:
     case HelmChassis::ROTOR: {
-      float x = 0, y = 0, wheel_pos = 0;
+      /* 轮子位置角为3PI/4 - i*PI/2，其正余弦为常量 */
+      const float R = 0.70710678f;
+      const float WHEEL_SIN[4] = {R, R, -R, -R};
+      const float WHEEL_COS[4] = {-R, R, R, -R};
+      float x = 0, y = 0;
       for (int i = 0; i < 4; i++) {
-        wheel_pos = -i * M_PI / 2.0f + M_PI / 4.0f * 3.0f;
-        x = sinf(wheel_pos) * move_vec_.wz + move_vec_.vx;
-        y = cosf(wheel_pos) * move_vec_.wz + move_vec_.vy;
-        setpoint_.wheel_pos[i] = -(atan2(y, x) - M_PI / 2.0f);
+        x = WHEEL_SIN[i] * move_vec_.wz + move_vec_.vx;
+        y = WHEEL_COS[i] * move_vec_.wz + move_vec_.vy;
+        setpoint_.wheel_pos[i] =
+            -(Component::FastMath::Atan2(y, x) - M_PI / 2.0f);
         setpoint_.motor_rotational_speed[i] = max_motor_rotational_speed_ *
                                               sqrtf(x * x + y * y) * 1.41421f /
                                               2.0f;
@@ -337,18 +340,21 @@ void HelmChassis<Motor, MotorParam>::Control() {
   }
 
   /* 输出计算 */
+  float speed_setpoint[4], speed_feedback[4];
+  for (int i = 0; i < 4; i++) {
+    speed_setpoint[i] = motor_reverse_[i] ? -setpoint_.motor_rotational_speed[i]
+                                          : setpoint_.motor_rotational_speed[i];
+    speed_feedback[i] = speed_motor_[i]->GetSpeed();
+  }
+  speed_actr_.Calculate(speed_setpoint, speed_feedback, dt_,
+                        out_.speed_motor_out);
+
   for (int i = 0; i < 4; i++) {
     if (motor_reverse_[i]) {
-      out_.speed_motor_out[i] =
-          speed_actr_[i]->Calculate(-setpoint_.motor_rotational_speed[i],
-                                    speed_motor_[i]->GetSpeed(), dt_);
       out_.motor6020_out[i] = pos_actr_[i]->Calculate(
           setpoint_.wheel_pos[i] + M_PI + this->param_.mech_zero[i],
           pos_motor_[i]->GetSpeed(), pos_motor_[i]->GetAngle(), dt_);
     } else {
-      out_.speed_motor_out[i] =
-          speed_actr_[i]->Calculate(setpoint_.motor_rotational_speed[i],
-                                    speed_motor_[i]->GetSpeed(), dt_);
       out_.motor6020_out[i] = pos_actr_[i]->Calculate(
           setpoint_.wheel_pos[i] + this->param_.mech_zero[i],
           pos_motor_[i]->GetSpeed(), pos_motor_[i]->GetAngle(), dt_);
@@ -409,8 +415,8 @@ void HelmChassis<Motor, MotorParam>::SetMode(HelmChassis::Mode mode) {
   }
 
   /* 切换模式后重置PID和滤波器 */
+  this->speed_actr_.Reset();
   for (size_t i = 0; i < 4; i++) {
-    this->speed_actr_[i]->Reset();
     this->pos_actr_[i]->Reset();
   }
 
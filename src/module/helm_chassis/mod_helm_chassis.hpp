@@ -114,7 +114,8 @@ class HelmChassis {
   float max_motor_rotational_speed_;
   Device::Cap::Info cap_;
 
-  Device::Referee::Data raw_ref_;
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
 
   float speed_motor_feedback_[4];
   float pos_motor_feedback_[4];
@@ -124,7 +125,7 @@ class HelmChassis {
   Mode mode_ = RELAX;
 
   std::array<Component::PosActuator *, 4> pos_actr_;
-  std::array<Component::SpeedActuator *, 4> speed_actr_;
+  Component::ActuatorBank<4> speed_actr_;
 
   std::array<Device::BaseMotor *, 4> pos_motor_;
   std::array<Device::BaseMotor *, 4> speed_motor_;
@@ -8,7 +8,10 @@
 using namespace Module;
 
 Launcher::Launcher(Param& param, float control_freq)
-    : param_(param), ctrl_lock_(true) {
+    : param_(param),
+      fric_actuator_(param.fric_actr, control_freq),
+      ctrl_lock_(true),
+      cmd_(this, ShowCMD, param.name) {
   for (size_t i = 0; i < LAUNCHER_ACTR_TRIG_NUM; i++) {
     this->trig_actuator_.at(i) =
         new Component::PosActuator(param.trig_actr.at(i), control_freq);
@@ -19,9 +22,6 @@ Launcher::Launcher(Param& param, float control_freq)
   }
 
   for (size_t i = 0; i < LAUNCHER_ACTR_FRIC_NUM; i++) {
-    this->fric_actuator_.at(i) =
-        new Component::SpeedActuator(param.fric_actr.at(i), control_freq);
-
     this->fric_motor_.at(i) =
         new Device::RMMotor(this->param_.fric_motor.at(i),
                             ("Launcher_Fric" + std::to_string(i)).c_str());
@@ -80,30 +80,22 @@ Launcher::Launcher(Param& param, float control_freq)
   bsp_pwm_set_comp(BSP_PWM_LAUNCHER_SERVO, this->param_.cover_close_duty);
 
   auto launcher_thread = [](Launcher* launcher) {
-    auto ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
-
-    uint32_t last_online_time = bsp_time_get_ms();
-
-    while (1) {
-      ref_sub.DumpData(launcher->raw_ref_);
-
+    /* 裁判系统数据只在更新时解析 */
+    if (launcher->raw_ref_.Update()) {
       launcher->PraseRef();
+    }
 
-      launcher->ctrl_lock_.Wait(UINT32_MAX);
-
-      launcher->UpdateFeedback();
-      launcher->Control();
+    launcher->ctrl_lock_.Wait(UINT32_MAX);
 
-      launcher->ctrl_lock_.Post();
+    launcher->UpdateFeedback();
+    launcher->Control();
 
-      /* 运行结束，等待下一次唤醒 */
-      launcher->thread_.SleepUntil(2, last_online_time);
-    }
+    launcher->ctrl_lock_.Post();
   };
 
-  this->thread_.Create(launcher_thread, this, "launcher_thread",
-                       MODULE_LAUNCHER_TASK_STACK_DEPTH,
-                       System::Thread::MEDIUM);
+  this->thread_.CreatePeriodic(launcher_thread, this, "launcher_thread",
+                               MODULE_LAUNCHER_TASK_STACK_DEPTH,
+                               System::Thread::MEDIUM, 2);
   System::Timer::Create(this->DrawUIStatic, this, 2200);
 
   System::Timer::Create(this->DrawUIDynamic, this, 100);
@@ -124,6 +116,19 @@ void Launcher::UpdateFeedback() {
   const float DELTA_MOTOR_ANGLE =
       this->trig_motor_[0]->GetAngle() - LAST_TRIG_MOTOR_ANGLE;
   this->trig_angle_ += DELTA_MOTOR_ANGLE / this->param_.trig_gear_ratio;
+
+  /* 拨弹盘向发射方向每转过一个齿记为一发，回退时不计 */
+  const float TOOTH_ANGLE = M_2PI / this->param_.num_trig_tooth;
+  if (this->trig_angle_ > this->heat_trig_angle_) {
+    this->heat_trig_angle_ = this->trig_angle_;
+  } else {
+    const float SHOT =
+        floorf((this->heat_trig_angle_ - this->trig_angle_) / TOOTH_ANGLE);
+    if (SHOT >= 1.0f) {
+      this->heat_est_.Shoot(static_cast<uint32_t>(SHOT), bsp_time_get_ms());
+      this->heat_trig_angle_ -= SHOT * TOOTH_ANGLE;
+    }
+  }
 }
 
 void Launcher::Control() {
@@ -164,8 +169,7 @@ void Launcher::Control() {
       /* 设置要发射多少弹丸 */
       if (this->fire_ctrl_.first_pressed_fire && !this->fire_ctrl_.to_launch) {
         this->fire_ctrl_.to_launch =
-            MIN(max_burst,
-                (this->heat_ctrl_.available_shot - this->fire_ctrl_.launched));
+            MIN(max_burst, this->heat_ctrl_.available_shot);
       }
 
       /* 以下逻辑保证触发后一定会打完预设的弹丸，完成爆发 */
@@ -257,13 +261,17 @@ void Launcher::Control() {
         this->trig_motor_[i]->Control(trig_out);
       }
 
+      /* 控制摩擦轮 */
+      float fric_fb[LAUNCHER_ACTR_FRIC_NUM], fric_out[LAUNCHER_ACTR_FRIC_NUM];
       for (size_t i = 0; i < LAUNCHER_ACTR_FRIC_NUM; i++) {
-        /* 控制摩擦轮 */
-        float fric_out = this->fric_actuator_[i]->Calculate(
-            this->setpoint_.fric_rpm_[i], this->fric_motor_[i]->GetSpeed(),
-            this->dt_);
+        fric_fb[i] = this->fric_motor_[i]->GetSpeed();
+      }
 
-        this->fric_motor_[i]->Control(fric_out);
+      this->fric_actuator_.Calculate(this->setpoint_.fric_rpm_.data(), fric_fb,
+                                     this->dt_, fric_out);
+
+      for (size_t i = 0; i < LAUNCHER_ACTR_FRIC_NUM; i++) {
+        this->fric_motor_[i]->Control(fric_out[i]);
       }
 
       /* 根据弹仓盖开关状态更新弹舱盖打开时舵机PWM占空比 */
@@ -295,9 +303,7 @@ void Launcher::SetFireMode(FireMode mode) {
 
   fire_ctrl_.fire = false;
 
-  for (size_t i = 0; i < LAUNCHER_ACTR_FRIC_NUM; i++) {
-    this->fric_actuator_[i]->Reset();
-  } /* reset 所有电机执行器PID等参数 */
+  this->fric_actuator_.Reset(); /* reset 所有电机执行器PID等参数 */
 
   if (mode == LOADED) {
     this->fire_ctrl_.to_launch = 0;
@@ -307,31 +313,13 @@ void Launcher::SetFireMode(FireMode mode) {
 }
 
 void Launcher::HeatLimit() {
+  this->heat_est_.Update(this->dt_);
+
   if (this->ref_.status == Device::Referee::RUNNING) {
-    /* 根据机器人型号获得对应数据 */
-    if (this->param_.model == LAUNCHER_MODEL_42MM) {
-      this->heat_ctrl_.heat = this->ref_.power_heat.launcher_42_heat;
-      this->heat_ctrl_.heat_limit = this->ref_.robot_status.shooter_heat_limit;
-      this->heat_ctrl_.speed_limit = BULLET_SPEED_LIMIT_42MM;
-      this->heat_ctrl_.cooling_rate =
-          this->ref_.robot_status.shooter_cooling_value;
-      this->heat_ctrl_.heat_increase = GAME_HEAT_INCREASE_42MM;
-    } else if (this->param_.model == LAUNCHER_MODEL_17MM) {
-      this->heat_ctrl_.heat = this->ref_.power_heat.launcher_id1_17_heat;
-      this->heat_ctrl_.heat_limit = this->ref_.robot_status.shooter_heat_limit;
-      this->heat_ctrl_.speed_limit = BULLET_SPEED_LIMIT_17MM;
-      this->heat_ctrl_.cooling_rate =
-          this->ref_.robot_status.shooter_cooling_value;
-      this->heat_ctrl_.heat_increase = GAME_HEAT_INCREASE_17MM;
-    }
-    /* 检测热量更新后,计算可发射弹丸（裁判系统数据更新有延迟） */
-    if ((this->heat_ctrl_.heat != this->heat_ctrl_.last_heat) ||
-        this->heat_ctrl_.available_shot == 0 || (this->heat_ctrl_.heat == 0)) {
-      this->heat_ctrl_.available_shot = static_cast<uint32_t>(
-          floorf((this->heat_ctrl_.heat_limit - this->heat_ctrl_.heat) /
-                 this->heat_ctrl_.heat_increase));
-      this->heat_ctrl_.last_heat = this->heat_ctrl_.heat;
-    }
+    /* 估计值在裁判系统两帧之间随发射与冷却变化 */
+    this->heat_ctrl_.heat = this->heat_est_.Heat();
+    this->heat_ctrl_.available_shot =
+        this->heat_est_.Available(LAUNCHER_HEAT_MARGIN);
     this->fire_ctrl_.bullet_speed = this->heat_ctrl_.speed_limit;
   } else {
     /* 裁判系统离线，不启用热量控制 */
@@ -341,37 +329,53 @@ void Launcher::HeatLimit() {
 }
 
 void Launcher::PraseRef() {
-  memcpy(&(this->ref_.power_heat), &(this->raw_ref_.power_heat),
+  memcpy(&(this->ref_.power_heat), &(this->raw_ref_->power_heat),
          sizeof(this->ref_.power_heat));
-  memcpy(&(this->ref_.robot_status), &(this->raw_ref_.robot_status),
+  memcpy(&(this->ref_.robot_status), &(this->raw_ref_->robot_status),
          sizeof(this->ref_.robot_status));
-  memcpy(&(this->ref_.launcher_data), &(this->raw_ref_.launcher_data),
+  memcpy(&(this->ref_.launcher_data), &(this->raw_ref_->launcher_data),
          sizeof(this->ref_.launcher_data));
-  this->ref_.status = this->raw_ref_.status;
-}
+  this->ref_.status = this->raw_ref_->status;
 
-float Launcher::LimitLauncherFreq() { /* 热量限制计算 */
-  float heat_percent = this->heat_ctrl_.heat / this->heat_ctrl_.heat_limit;
-  float stable_freq = this->heat_ctrl_.cooling_rate /
-                      this->heat_ctrl_.heat_increase; /* 每秒可发弹量 */
+  if (this->ref_.status != Device::Referee::RUNNING) {
+    return;
+  }
+
+  /* 根据机器人型号获得对应数据 */
   if (this->param_.model == LAUNCHER_MODEL_42MM) {
-    return stable_freq;
+    this->heat_ctrl_.ref_heat = this->ref_.power_heat.launcher_42_heat;
+    this->heat_ctrl_.speed_limit = BULLET_SPEED_LIMIT_42MM;
+    this->heat_ctrl_.heat_increase = GAME_HEAT_INCREASE_42MM;
   } else {
-    if (heat_percent > 0.9f) {
-      return 0.5f;
-    } else if (heat_percent > 0.8f) {
-      return 1.0f;
-    } else if (heat_percent > 0.6f) {
-      return 2.0f * stable_freq;
-    } else if (heat_percent > 0.2f) {
-      return 3.0f * stable_freq;
-    } else if (heat_percent > 0.1f) {
-      return 4.0f * stable_freq;
-    } else {
-      return 5.0f;
-    }
+    this->heat_ctrl_.ref_heat = this->ref_.power_heat.launcher_id1_17_heat;
+    this->heat_ctrl_.speed_limit = BULLET_SPEED_LIMIT_17MM;
+    this->heat_ctrl_.heat_increase = GAME_HEAT_INCREASE_17MM;
+  }
+  this->heat_ctrl_.heat_limit = this->ref_.robot_status.shooter_heat_limit;
+  this->heat_ctrl_.cooling_rate = this->ref_.robot_status.shooter_cooling_value;
+
+  this->heat_est_.SetParam(this->heat_ctrl_.heat_limit,
+                           this->heat_ctrl_.cooling_rate,
+                           this->heat_ctrl_.heat_increase);
+
+  /* 只在热量数据更新时修正，其他消息到达时热量值不变 */
+  const Device::Referee::MessageStamp &STAMP = Device::Referee::Stamp(
+      *this->raw_ref_, Device::Referee::REF_CMD_ID_POWER_HEAT_DATA);
+  if (STAMP.seq != this->heat_seq_) {
+    this->heat_seq_ = STAMP.seq;
+    this->heat_est_.Reconcile(this->heat_ctrl_.ref_heat, STAMP.time,
+                              LAUNCHER_HEAT_REF_DELAY);
   }
 }
+
+float Launcher::LimitLauncherFreq() {
+  /* 热量估计在两帧之间同样有效，余量内按最高射频发射，用尽后等待冷却 */
+  if (this->heat_ctrl_.available_shot > 0) {
+    return 1000.0f / static_cast<float>(this->param_.min_launch_delay);
+  }
+  return 0.0f;
+}
+
 void Launcher::DrawUIStatic(Launcher* launcher) {
   launcher->string_.Draw("SM", Component::UI::UI_GRAPHIC_OP_ADD,
                          Component::UI::UI_GRAPHIC_LAYER_CONST,
@@ -655,3 +659,27 @@ void Launcher::DrawUIDynamic(Launcher* launcher) {
       40, 40);
   Device::Referee::AddUI(launcher->arc_);
 }
+
+int Launcher::ShowCMD(Launcher* launcher, int argc, char** argv) {
+  if (argc == 1) {
+    printf("[heat]   打印热量估计与预测误差\r\n");
+    printf("[reset]  清零统计\r\n");
+  } else if (argc == 2) {
+    launcher->ctrl_lock_.Wait(UINT32_MAX);
+
+    if (strcmp(argv[1], "heat") == 0) {
+      launcher->heat_est_.PrintInfo();
+      printf("ref:%.1f available:%lu\r\n",
+             static_cast<double>(launcher->heat_ctrl_.ref_heat),
+             static_cast<unsigned long>(launcher->heat_ctrl_.available_shot));
+    } else if (strcmp(argv[1], "reset") == 0) {
+      launcher->heat_est_.ResetStats();
+    } else {
+      printf("参数错误\r\n");
+    }
+
+    launcher->ctrl_lock_.Post();
+  }
+
+  return 0;
+}
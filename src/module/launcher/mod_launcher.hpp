@@ -5,6 +5,7 @@
 #include "comp_actuator.hpp"
 #include "comp_cmd.hpp"
 #include "comp_filter.hpp"
+#include "comp_heat.hpp"
 #include "comp_pid.hpp"
 #include "dev_referee.hpp"
 #include "dev_rm_motor.hpp"
@@ -68,6 +69,7 @@ class Launcher {
   } Model;
 
   typedef struct {
+    const char *name;           /* 终端命令名，有多个发射机构时区分 */
     float num_trig_tooth;       /* 拨弹盘中一圈能存储几颗弹丸 */
     float trig_gear_ratio;      /* 拨弹电机减速比 3508:19, 2006:36 */
     float fric_radius;          /* 摩擦轮半径，单位：米 */
@@ -88,8 +90,8 @@ class Launcher {
 
   /* 热量控制 */
   struct HeatControl {
-    float heat;          /* 现在热量水平 */
-    float last_heat;     /* 之前的热量水平 */
+    float heat;          /* 估计的热量水平 */
+    float ref_heat;      /* 裁判系统上次发来的热量 */
     float heat_limit;    /* 热量上限 */
     float speed_limit;   /* 弹丸初速是上限 */
     float cooling_rate;  /* 冷却速率 */
@@ -143,6 +145,8 @@ class Launcher {
 
   static void DrawUIDynamic(Launcher *launcher);
 
+  static int ShowCMD(Launcher *launcher, int argc, char **argv);
+
  private:
   uint64_t last_wakeup_ = 0;
 
@@ -162,11 +166,16 @@ class Launcher {
     float trig_angle_ = 0.0f;       /* 拨弹电机角度，单位：弧度 */
   } setpoint_;
 
-  HeatControl heat_ctrl_;
+  HeatControl heat_ctrl_{};
   FireControl fire_ctrl_;
 
+  /* 两帧裁判系统数据之间由拨弹盘角度估计热量 */
+  Component::HeatEstimator heat_est_;
+  float heat_trig_angle_ = 0.0f; /* 上次计入发射时的拨弹盘角度 */
+  uint32_t heat_seq_ = 0;        /* 已比较过的热量数据序号 */
+
   std::array<Component::PosActuator *, LAUNCHER_ACTR_TRIG_NUM> trig_actuator_;
-  std::array<Component::SpeedActuator *, LAUNCHER_ACTR_FRIC_NUM> fric_actuator_;
+  Component::ActuatorBank<LAUNCHER_ACTR_FRIC_NUM> fric_actuator_;
 
   std::array<Device::RMMotor *, LAUNCHER_ACTR_TRIG_NUM> trig_motor_;
   std::array<Device::RMMotor *, LAUNCHER_ACTR_FRIC_NUM> fric_motor_;
@@ -177,12 +186,15 @@ class Launcher {
 
   System::Semaphore ctrl_lock_;
 
-  Device::Referee::Data raw_ref_;
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
 
   Component::UI::String string_;
 
   Component::UI::Rectangle rectangle_;
 
   Component::UI::Arc arc_;
+
+  System::Term::Command<Launcher *> cmd_;
 };
 }  // namespace Module
@@ -53,14 +53,14 @@ UVALauncher::UVALauncher(Param& param, float control_freq)
       event_callback, this, this->param_.EVENT_MAP);
 
   auto launcher_thread = [](UVALauncher* launcher) {
-    auto ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
 
     uint32_t last_online_time = bsp_time_get_ms();
 
     while (1) {
-      ref_sub.DumpData(launcher->raw_ref_);
-
-      launcher->PraseRef();
+      /* 裁判系统数据只在更新时解析 */
+      if (launcher->raw_ref_.Update()) {
+        launcher->PraseRef();
+      }
       launcher->ctrl_lock_.Wait(UINT32_MAX);
 
       launcher->FricControl();
@@ -164,13 +164,13 @@ void UVALauncher::Control() {
   }
 }
 void UVALauncher::PraseRef() {
-  memcpy(&(this->ref_.robot_status), &(this->raw_ref_.robot_status),
+  memcpy(&(this->ref_.robot_status), &(this->raw_ref_->robot_status),
          sizeof(this->ref_.robot_status));
 
-  this->ref_.status = this->raw_ref_.status;
+  this->ref_.status = this->raw_ref_->status;
 }
 void UVALauncher::FricControl() {
-  if (/*this->raw_ref_.robot_status.power_launcher_output == 1 &&*/
+  if (/*this->raw_ref_->robot_status.power_launcher_output == 1 &&*/
       this->fire_ctrl_.fric_on == true) {
     /*摩擦轮开启模式*/
     bsp_pwm_start(BSP_PWM_SERVO_A);
@@ -93,7 +93,8 @@ class UVALauncher {
 
   RefForLauncher ref_;
 
-  Device::Referee::Data raw_ref_;
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
 
   std::array<Component::PosActuator *, 1> trig_actuator_;
 
@@ -47,15 +47,13 @@ template <typename Motor, typename MotorParam>
 OmniChassis<Motor, MotorParam>::OmniChassis(Param& param, float control_freq)
     : param_(param),
       mode_(OmniChassis::RELAX),
+      actuator_(param.actuator_param, control_freq),
       mixer_(param.type),
       follow_pid_(param.follow_pid_param, control_freq),
       ctrl_lock_(true) {
   memset(&(this->cmd_), 0, sizeof(this->cmd_));
 
   for (uint8_t i = 0; i < this->mixer_.len_; i++) {
-    this->actuator_.at(i) =
-        new Component::SpeedActuator(param.actuator_param.at(i), control_freq);
-
     this->motor_.at(i) =
         new Motor(param.motor_param.at(i),
                   (std::string("Chassis_") + std::to_string(i)).c_str());
@@ -98,25 +96,25 @@ OmniChassis<Motor, MotorParam>::OmniChassis(Param& param, float control_freq)
       event_callback, this, this->param_.EVENT_MAP);
 
   auto chassis_thread = [](OmniChassis* chassis) {
-    auto raw_ref_sub = Message::Subscriber<Device::Referee::Data>("referee");
-    auto cmd_sub =
-        Message::Subscriber<Component::CMD::ChassisCMD>("cmd_chassis");
+    Component::StaticSubscriber<Component::TopicHash("cmd_chassis")> cmd_sub;
 
-    auto yaw_sub = Message::Subscriber<float>("chassis_yaw");
+    Component::StaticSubscriber<Component::TopicHash("chassis_yaw")> yaw_sub;
 
-    auto cap_sub = Message::Subscriber<Device::Cap::Info>("cap_info");
+    Component::StaticSubscriber<Component::TopicHash("cap_info")> cap_sub;
 
     uint32_t last_online_time = bsp_time_get_ms();
 
     while (1) {
       /* 读取控制指令、电容、裁判系统、电机反馈 */
       cmd_sub.DumpData(chassis->cmd_);
-      raw_ref_sub.DumpData(chassis->raw_ref_);
       yaw_sub.DumpData(chassis->yaw_);
       cap_sub.DumpData(chassis->cap_);
 
       /* 更新反馈值 */
-      chassis->PraseRef();
+      /* 裁判系统数据只在更新时解析 */
+      if (chassis->raw_ref_.Update()) {
+        chassis->PraseRef();
+      }
 
       chassis->ctrl_lock_.Wait(UINT32_MAX);
       chassis->UpdateFeedback();
@@ -277,8 +275,8 @@ void OmniChassis<Motor, MotorParam>::Control() {
     case OmniChassis::FOLLOW_GIMBAL_CROSS:
     case OmniChassis::ROTOR: {
       float beta = this->yaw_;
-      float cos_beta = cosf(beta);
-      float sin_beta = sinf(beta);
+      float cos_beta = 0.0f, sin_beta = 0.0f;
+      Component::FastMath::SinCos(beta, &sin_beta, &cos_beta);
       this->move_vec_.vx = cos_beta * this->cmd_.x - sin_beta * this->cmd_.y;
       this->move_vec_.vy = sin_beta * this->cmd_.x + cos_beta * this->cmd_.y;
       break;
@@ -341,12 +339,14 @@ void OmniChassis<Motor, MotorParam>::Control() {
       float max_power_limit =
           ref_.chassis_power_limit +
           ref_.chassis_power_limit * 0.2 * this->cap_.percentage_;
+      float setpoint[4] = {}, feedback[4] = {};
       for (unsigned i = 0; i < this->mixer_.len_; i++) {
-        out_.motor3508_out[i] = this->actuator_[i]->Calculate(
-            this->setpoint_.motor_rotational_speed[i] *
-                max_motor_rotational_speed_,
-            this->motor_[i]->GetSpeed(), this->dt_);
+        setpoint[i] = this->setpoint_.motor_rotational_speed[i] *
+                      max_motor_rotational_speed_;
+        feedback[i] = this->motor_[i]->GetSpeed();
       }
+      this->actuator_.Calculate(setpoint, feedback, this->dt_,
+                                out_.motor3508_out);
       for (unsigned i = 0; i < this->mixer_.len_; i++) {
         if (cap_.online_) {
           LimitChassisOutPower(max_power_limit, out_.motor3508_out,
@@ -375,10 +375,10 @@ void OmniChassis<Motor, MotorParam>::Control() {
 template <typename Motor, typename MotorParam>
 void OmniChassis<Motor, MotorParam>::PraseRef() {
   this->ref_.chassis_power_limit =
-      this->raw_ref_.robot_status.chassis_power_limit;
-  this->ref_.chassis_pwr_buff = this->raw_ref_.power_heat.chassis_pwr_buff;
-  this->ref_.chassis_watt = this->raw_ref_.power_heat.chassis_watt;
-  this->ref_.status = this->raw_ref_.status;
+      this->raw_ref_->robot_status.chassis_power_limit;
+  this->ref_.chassis_pwr_buff = this->raw_ref_->power_heat.chassis_pwr_buff;
+  this->ref_.chassis_watt = this->raw_ref_->power_heat.chassis_watt;
+  this->ref_.status = this->raw_ref_->status;
 }
 
 template <typename Motor, typename MotorParam>
@@ -407,9 +407,7 @@ void OmniChassis<Motor, MotorParam>::SetMode(OmniChassis::Mode mode) {
     this->param_.type = Component::Mixer::OMNIPLUS;
   }
   /* 切换模式后重置PID和滤波器 */
-  for (size_t i = 0; i < this->mixer_.len_; i++) {
-    this->actuator_[i]->Reset();
-  }
+  this->actuator_.Reset();
   this->mode_ = mode;
 }
 
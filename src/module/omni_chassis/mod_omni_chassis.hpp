@@ -112,7 +112,7 @@ class OmniChassis {
 
   Device::Cap::Info cap_;
 
-  std::array<Component::SpeedActuator *, 4> actuator_;
+  Component::ActuatorBank<4> actuator_;
 
   std::array<Device::BaseMotor *, 4> motor_;
 
@@ -139,7 +139,8 @@ class OmniChassis {
   System::Semaphore ctrl_lock_;
 
   float yaw_;
-  Device::Referee::Data raw_ref_;
+  Component::SnapshotView<Device::Referee::Data> raw_ref_ =
+      Component::SnapshotView<Device::Referee::Data>("referee");
 
   Device::BaseMotor::Feedback motor_feedback_;
 
@@ -1,6 +1,25 @@
 #include "bsp_time.h"
+#include "comp_actuator.hpp"
+#include "comp_clock_sync.hpp"
+#include "comp_fixed.hpp"
+#include "comp_power_limit.hpp"
 #include "module.hpp"
 
+/* 目标板上另外统计CPU周期，M0+没有DWT，按主频由时间换算 */
+#if defined(__arm__) && !defined(__linux__)
+#define MOD_PERF_CYCLE (1)
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define MOD_PERF_CYCLE_DWT (1)
+#else
+#define MOD_PERF_CYCLE_DWT (0)
+extern "C" uint32_t SystemCoreClock;
+#endif
+#else
+#define MOD_PERF_CYCLE (0)
+#define MOD_PERF_CYCLE_DWT (0)
+#endif
+
 namespace Module {
 class Performance {
  public:
@@ -161,9 +180,504 @@ class Performance {
            static_cast<uint32_t>((end_time - start_time) / 1000));
     printf("*** Float Test End ***\r\n");
 
+    ActuatorTest();
+
+    FixedPointTest();
+
+    CycleValueTest();
+
+    FastMathTest();
+
+    PowerLimitTest();
+
+    ClockSyncTest();
+
     return 0;
   }
 
+  static void ActuatorTest() {
+    printf("*** Actuator Test Start ***\r\n");
+
+    std::array<Component::SpeedActuator::Param, 4> param{};
+    for (auto& item : param) {
+      item.speed = {1.0f, 0.0015f, 0.05f, 0.0f, 1.0f, 1.0f, -1.0f, false};
+      item.in_cutoff_freq = 120.0f;
+      item.out_cutoff_freq = -1.0f;
+    }
+
+    std::array<Component::SpeedActuator*, 4> single;
+    for (size_t i = 0; i < 4; i++) {
+      single[i] = new Component::SpeedActuator(param[i], 500.0f);
+    }
+
+    auto bank = new Component::ActuatorBank<4>(param, 500.0f);
+
+    float setpoint[4] = {3000.0f, -3000.0f, 1500.0f, -1500.0f};
+    float feedback[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float out[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    auto time = bsp_time_get();
+    for (uint32_t i = 0; i < 100000; i++) {
+      for (size_t j = 0; j < 4; j++) {
+        out[j] = single[j]->Calculate(setpoint[j], feedback[j], 0.002f);
+        feedback[j] += out[j];
+      }
+    }
+    time = bsp_time_get() - time;
+
+    printf("\tUpdate 4 SpeedActuator 100000 times\r\n");
+    printf("\t\t%f microseconds per update\r\n",
+           static_cast<float>(time) / 100000.0f);
+
+    memset(feedback, 0, sizeof(feedback));
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < 100000; i++) {
+      bank->Calculate(setpoint, feedback, 0.002f, out);
+      for (size_t j = 0; j < 4; j++) {
+        feedback[j] += out[j];
+      }
+    }
+    time = bsp_time_get() - time;
+
+    printf("\tUpdate ActuatorBank<4> 100000 times\r\n");
+    printf("\t\t%f microseconds per update\r\n",
+           static_cast<float>(time) / 100000.0f);
+
+    for (auto actuator : single) {
+      delete actuator;
+    }
+    delete bank;
+
+    printf("*** Actuator Test End ***\r\n");
+  }
+
+  typedef struct {
+    uint64_t time;  /* us */
+    uint32_t cycle; /* CPU周期，主机上为0 */
+  } Cost;
+
+  static uint32_t CycleNow() {
+#if MOD_PERF_CYCLE_DWT
+    return *reinterpret_cast<volatile uint32_t*>(0xE0001004u);
+#elif MOD_PERF_CYCLE
+    return static_cast<uint32_t>(bsp_time_get() * (SystemCoreClock / 1000000u));
+#else
+    return 0;
+#endif
+  }
+
+  static Cost CostStart() {
+#if MOD_PERF_CYCLE_DWT
+    /* DEMCR.TRCENA与DWT_CTRL.CYCCNTENA，不清零计数以免影响trace */
+    *reinterpret_cast<volatile uint32_t*>(0xE000EDFCu) |= 1u << 24;
+    *reinterpret_cast<volatile uint32_t*>(0xE0001000u) |= 1u;
+#endif
+    return {bsp_time_get(), CycleNow()};
+  }
+
+  /* 计数为32位，单次测量不能超过一个回绕周期 */
+  static Cost CostSince(const Cost& start) {
+    return {bsp_time_get() - start.time, CycleNow() - start.cycle};
+  }
+
+  static void PrintCompare(const char* name, uint32_t times,
+                           const Cost& float_cost, const Cost& fixed_cost) {
+    printf("\t%s %d times\r\n", name, times);
+    printf("\t\t%f / %f microseconds per update, speedup %f\r\n",
+           static_cast<float>(float_cost.time) / times,
+           static_cast<float>(fixed_cost.time) / times,
+           static_cast<float>(float_cost.time) /
+               static_cast<float>(fixed_cost.time));
+#if MOD_PERF_CYCLE
+    printf("\t\t%f / %f cycles per update\r\n",
+           static_cast<float>(float_cost.cycle) / times,
+           static_cast<float>(fixed_cost.cycle) / times);
+#endif
+  }
+
+  static void FixedPointTest() {
+    printf("*** Fixed Point Test Start ***\r\n");
+
+    const uint32_t TIMES = 100000;
+    float fb = 0.0f;
+    Component::Type::Q16 fb_q;
+
+    Component::PID::Param param = {1.0f,  0.0015f, 0.05f, 0.0002f,
+                                   1.0f,  1.0f,    60.0f, false};
+    auto pid = new Component::PID(param, 500.0f);
+    auto pid_q = new Component::FixedPID<Component::Type::Q16>(param, 500.0f);
+
+    auto cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      fb += pid->Calculate(3000.0f, fb, 0.002f);
+    }
+    auto float_cost = CostSince(cost);
+
+    const Component::Type::Q16 SP(3000.0f), DT(0.002f);
+    cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      fb_q += pid_q->Calculate(SP, fb_q, DT);
+    }
+    auto fixed_cost = CostSince(cost);
+
+    PrintCompare("PID / FixedPID<Q16>", TIMES, float_cost, fixed_cost);
+
+    delete pid;
+    delete pid_q;
+
+    Component::LowPassFilter2p filter(1000.0f, 30.0f);
+    Component::FixedLowPassFilter2p<Component::Type::Q16> filter_q(1000.0f,
+                                                                   30.0f);
+
+    cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      fb = filter.Apply(static_cast<float>(i & 0xff));
+    }
+    float_cost = CostSince(cost);
+
+    cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      fb_q = filter_q.Apply(Component::Type::Q16::FromRaw((i & 0xff) << 16));
+    }
+    fixed_cost = CostSince(cost);
+
+    PrintCompare("LowPassFilter2p / FixedLowPassFilter2p<Q16>", TIMES,
+                 float_cost, fixed_cost);
+
+    Component::Type::CycleValue angle(0.0f);
+    float err = 0.0f;
+
+    cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      angle += 0.01f;
+      err += angle - 1.0f;
+    }
+    float_cost = CostSince(cost);
+
+    Component::Type::Angle32 angle_q, target_q(1.0f);
+    const Component::Type::Angle32 STEP(0.01f);
+    int32_t err_q = 0;
+
+    cost = CostStart();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      angle_q += STEP;
+      err_q += angle_q - target_q;
+    }
+    fixed_cost = CostSince(cost);
+
+    PrintCompare("CycleValue / Angle32 wrap and diff", TIMES, float_cost,
+                 fixed_cost);
+
+    /* 防止被优化 */
+    printf("\t\tchecksum %f %f %f %d\r\n", fb, fb_q.ToFloat(), err,
+           static_cast<int>(err_q));
+
+    printf("*** Fixed Point Test End ***\r\n");
+  }
+
+  /* 原fmodf实现，作为CycleValue的对照 */
+  static float CycleReference(float value) {
+    value = fmodf(value, M_2PI);
+    if (value < 0) {
+      value += M_2PI;
+    }
+    return value;
+  }
+
+  static float CycleDiffReference(float a, float b) {
+    float ans = CycleReference(a) - CycleReference(b);
+    while (ans >= M_PI) {
+      ans -= M_2PI;
+    }
+
+    while (ans < -M_PI) {
+      ans += M_2PI;
+    }
+    return ans;
+  }
+
+  static void CycleValueTest() {
+    printf("*** CycleValue Test Start ***\r\n");
+
+    const uint32_t TIMES = 100000;
+
+    /* 随机比较，误差按圆周距离计算 */
+    float max_err = 0.0f;
+    srand(bsp_time_get_ms());
+    for (uint32_t i = 0; i < TIMES; i++) {
+      const float RANGE = (i & 1) ? 20.0f : 2000.0f;
+      const float A = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) *
+                      RANGE;
+      const float B = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) *
+                      RANGE;
+
+      float err = fabsf(Component::Type::CycleValue(A).Value() -
+                        CycleReference(A));
+      err = fminf(err, M_2PI - err);
+      max_err = fmaxf(max_err, err);
+
+      err = fabsf(Component::Type::CycleValue(A) - B - CycleDiffReference(A, B));
+      err = fminf(err, M_2PI - err);
+      max_err = fmaxf(max_err, err);
+    }
+
+    printf("\tRandom compare with fmodf %d times\r\n", TIMES);
+    printf("\t\tmax error %f rad %s\r\n", max_err,
+           max_err < 1e-5f ? "PASS" : "FAIL");
+
+    static float input[256];
+    for (auto& item : input) {
+      item = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) * 20.0f;
+    }
+
+    float sum = 0.0f;
+    auto time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += CycleDiffReference(input[i & 0xff], 1.0f);
+    }
+    auto ref_time = bsp_time_get() - time;
+
+    Component::Type::CycleValue target(1.0f);
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += Component::Type::CycleValue(input[i & 0xff]) - target;
+    }
+    auto new_time = bsp_time_get() - time;
+
+    printf("\tWrap and diff fmodf / CycleValue %d times\r\n", TIMES);
+    printf("\t\t%f / %f microseconds per update, speedup %f\r\n",
+           static_cast<float>(ref_time) / TIMES,
+           static_cast<float>(new_time) / TIMES,
+           static_cast<float>(ref_time) / static_cast<float>(new_time));
+
+    /* 防止被优化 */
+    printf("\t\tchecksum %f\r\n", sum);
+
+    printf("*** CycleValue Test End ***\r\n");
+  }
+
+  static void FastMathTest() {
+    printf("*** FastMath Test Start ***\r\n");
+
+    const uint32_t TIMES = 100000;
+
+    static float input[256];
+    for (auto& item : input) {
+      item = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) * 10.0f;
+    }
+
+    /* 精度，以libm为基准 */
+    float err_table = 0.0f, err_poly = 0.0f;
+    float err_atan_fast = 0.0f, err_atan_poly = 0.0f;
+    for (uint32_t i = 0; i < TIMES; i++) {
+      const float X = input[i & 0xff] + static_cast<float>(i) * 1e-4f;
+      const float Y = input[(i + 1) & 0xff];
+      float s = 0.0f, c = 0.0f;
+
+      Component::FastMath::SinCosTable(X, &s, &c);
+      err_table = fmaxf(err_table, fmaxf(fabsf(s - sinf(X)),
+                                         fabsf(c - cosf(X))));
+
+      Component::FastMath::SinCosPoly(X, &s, &c);
+      err_poly = fmaxf(err_poly, fmaxf(fabsf(s - sinf(X)),
+                                       fabsf(c - cosf(X))));
+
+      const float ATAN = atan2f(Y, X);
+      err_atan_fast = fmaxf(
+          err_atan_fast, fabsf(Component::FastMath::Atan2Fast(Y, X) - ATAN));
+      err_atan_poly = fmaxf(
+          err_atan_poly, fabsf(Component::FastMath::Atan2Poly(Y, X) - ATAN));
+    }
+
+    printf("\tMax error\r\n");
+    printf("\t\tsincos table %e, poly %e\r\n", err_table, err_poly);
+    printf("\t\tatan2 fast %e, poly %e\r\n", err_atan_fast, err_atan_poly);
+
+    /* 速度 */
+    float sum = 0.0f;
+    auto time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += sinf(input[i & 0xff]) + cosf(input[i & 0xff]);
+    }
+    auto libm_time = bsp_time_get() - time;
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      float s = 0.0f, c = 0.0f;
+      Component::FastMath::SinCosTable(input[i & 0xff], &s, &c);
+      sum += s + c;
+    }
+    auto table_time = bsp_time_get() - time;
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      float s = 0.0f, c = 0.0f;
+      Component::FastMath::SinCosPoly(input[i & 0xff], &s, &c);
+      sum += s + c;
+    }
+    auto poly_time = bsp_time_get() - time;
+
+    printf("\tsinf+cosf / SinCosTable / SinCosPoly %d times\r\n", TIMES);
+    printf("\t\t%f / %f / %f microseconds per call\r\n",
+           static_cast<float>(libm_time) / TIMES,
+           static_cast<float>(table_time) / TIMES,
+           static_cast<float>(poly_time) / TIMES);
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += atan2f(input[i & 0xff], input[(i + 1) & 0xff]);
+    }
+    libm_time = bsp_time_get() - time;
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += Component::FastMath::Atan2Fast(input[i & 0xff],
+                                            input[(i + 1) & 0xff]);
+    }
+    table_time = bsp_time_get() - time;
+
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      sum += Component::FastMath::Atan2Poly(input[i & 0xff],
+                                            input[(i + 1) & 0xff]);
+    }
+    poly_time = bsp_time_get() - time;
+
+    printf("\tatan2f / Atan2Fast / Atan2Poly %d times\r\n", TIMES);
+    printf("\t\t%f / %f / %f microseconds per call\r\n",
+           static_cast<float>(libm_time) / TIMES,
+           static_cast<float>(table_time) / TIMES,
+           static_cast<float>(poly_time) / TIMES);
+
+    /* 防止被优化 */
+    printf("\t\tchecksum %f\r\n", sum);
+
+    printf("*** FastMath Test End ***\r\n");
+  }
+
+  static void PowerLimitTest() {
+    printf("*** PowerLimiter Test Start ***\r\n");
+
+    const uint32_t TIMES = 100000;
+
+    /* 以一组实测系数生成功率，从偏离的初值开始拟合 */
+    const Component::PowerLimiter::Model TRUTH = {0.0327f, 2.19e-7f, 74.3f,
+                                                  1.90f};
+    auto limiter = new Component::PowerLimiter({0.02f, 4e-7f, 50.0f, 4.0f});
+
+    static float out[256][4], speed[256][4], power[256];
+    srand(bsp_time_get_ms());
+    for (size_t i = 0; i < 256; i++) {
+      power[i] = TRUTH.constant;
+      for (size_t j = 0; j < 4; j++) {
+        out[i][j] = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f);
+        speed[i][j] =
+            (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) * 7000.0f;
+        power[i] += TRUTH.torque * fabsf(out[i][j] * speed[i][j]) +
+                    TRUTH.speed_2 * speed[i][j] * speed[i][j] +
+                    TRUTH.out_2 * out[i][j] * out[i][j];
+      }
+    }
+
+    auto time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      limiter->Fit(out[i & 0xff], speed[i & 0xff], 4, power[i & 0xff]);
+    }
+    auto fit_time = bsp_time_get() - time;
+
+    const float ERROR[4] = {3000.0f, 3000.0f, 500.0f, 100.0f};
+    float sum = 0.0f;
+    time = bsp_time_get();
+    for (uint32_t i = 0; i < TIMES; i++) {
+      float tmp[4];
+      memcpy(tmp, out[i & 0xff], sizeof(tmp));
+      limiter->Allocate(60.0f, tmp, speed[i & 0xff], ERROR, 4);
+      sum += tmp[0];
+    }
+    auto alloc_time = bsp_time_get() - time;
+
+    const float FIT_US = static_cast<float>(fit_time) / TIMES;
+    const float ALLOC_US = static_cast<float>(alloc_time) / TIMES;
+
+    printf("\tFit / Allocate 4 motors %d times\r\n", TIMES);
+    printf("\t\t%f / %f microseconds per update, %f%% of 2ms\r\n", FIT_US,
+           ALLOC_US, (FIT_US + ALLOC_US) / 2000.0f * 100.0f);
+
+    const Component::PowerLimiter::Model MODEL = limiter->GetModel();
+    printf("\tFitted k1 %e / %e, k3 %f / %f\r\n", MODEL.torque, TRUTH.torque,
+           MODEL.out_2, TRUTH.out_2);
+
+    /* 防止被优化 */
+    printf("\t\tchecksum %f\r\n", sum);
+
+    delete limiter;
+
+    printf("*** PowerLimiter Test End ***\r\n");
+  }
+
+  static void ClockSyncTest() {
+    printf("*** ClockSync Test Start ***\r\n");
+
+    /* 本地回环：远端时钟带固定偏差与频率误差，链路延迟带抖动与排队 */
+    const uint32_t TIMES = 6000;
+    const uint32_t PERIOD = 10000;
+    const int64_t OFFSET = 123456789;
+    const float SKEW = 50e-6f;
+
+    auto remote = [&](uint64_t local) {
+      return static_cast<uint64_t>(
+          static_cast<int64_t>(local) + OFFSET +
+          static_cast<int64_t>(SKEW * static_cast<float>(local)));
+    };
+
+    auto delay = []() {
+      uint64_t ans = 200 + rand() % 50;
+      if (rand() % 8 == 0) {
+        ans += 2000;
+      }
+      return ans;
+    };
+
+    auto sync = new Component::ClockSync();
+
+    srand(bsp_time_get_ms());
+    uint64_t update_time = 0;
+    uint64_t now = 0;
+    for (uint32_t i = 0; i < TIMES; i++) {
+      now += PERIOD;
+      const uint64_t T1 = now;
+      const uint64_t ARRIVE = T1 + delay();
+      const uint64_t T2 = remote(ARRIVE);
+      const uint64_t T3 = remote(ARRIVE + 100);
+      const uint64_t T4 = ARRIVE + 100 + delay();
+
+      auto time = bsp_time_get();
+      sync->Update(T1, T2, T3, T4);
+      update_time += bsp_time_get() - time;
+    }
+
+    const int64_t TRUE_OFFSET = static_cast<int64_t>(remote(now) - now);
+    const int64_t ERROR = sync->Offset(now) - TRUE_OFFSET;
+
+    /* 一秒内偏差的变化即频率误差 */
+    const float SKEW_PPM =
+        static_cast<float>(sync->Offset(now + 1000000) - sync->Offset(now));
+
+    printf("\t%d exchanges every %d us, 1 in 8 delayed 2 ms\r\n", TIMES,
+           PERIOD);
+    printf("\t\t%f microseconds per update\r\n",
+           static_cast<float>(update_time) / TIMES);
+    printf("\tOffset error %d us, skew %f / %f ppm\r\n",
+           static_cast<int>(ERROR), SKEW_PPM, SKEW * 1e6f);
+
+    sync->PrintInfo();
+
+    delete sync;
+
+    printf("*** ClockSync Test End ***\r\n");
+  }
+
   Performance() : test_cmd_(this, Test, "perf"), sem_1_(0), sem_2_(0) {}
 };
 }  // namespace Module
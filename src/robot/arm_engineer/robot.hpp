@@ -21,11 +21,14 @@ class ArmEngineer {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::Can can_;
   Device::Referee referee_;
   Device::DR16 dr16_;
   Device::BlinkLED blink_;
+  System::Memory::Owner chassis_owner_ = System::Memory::Owner("chassis");
   Module::RMChassis chassis_;
+  System::Memory::Owner robotarm_owner_ = System::Memory::Owner("robotarm");
   Module::RobotArm robotarm_;
 
   ArmEngineer(Param &param, float control_freq)
@@ -18,6 +18,8 @@ class Dart {
   } Param;
 
   Component::CMD cmd_;
+
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::RGB rgb_{};
   Device::Referee referee;
   Device::Can can_;
@@ -25,6 +27,8 @@ class Dart {
   Device::BMI088 bmi088_;
   Device::AHRS ahrs_;
 
+  System::Memory::Owner dartlauncher_owner_ =
+      System::Memory::Owner("dartlauncher");
   Module::DartLauncher dartlauncher_;
 
   Dart(Param& param, float control_freq)
@@ -22,6 +22,7 @@ class UVA {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::AHRS ahrs_;
   Device::BMI088 bmi088_;
   Device::Can can_;
@@ -29,7 +30,9 @@ class UVA {
   Device::RGB led_;
   Device::Referee referee_;
 
+  System::Memory::Owner gimbal_owner_ = System::Memory::Owner("gimbal");
   Module::Gimbal gimbal_;
+  System::Memory::Owner launcher_owner_ = System::Memory::Owner("launcher");
   Module::UVALauncher launcher_;
   static UVA* self_;
   UVA(Param& param, float control_freq)
@@ -446,6 +446,7 @@ Robot::HelmInfantry::Param param =
 
             },
     .launcher = {
+        .name = "launcher",
         .num_trig_tooth = 8.0f,
         .trig_gear_ratio = 36.0f,
         .fric_radius = 0.03f,
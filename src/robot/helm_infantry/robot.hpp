@@ -27,6 +27,7 @@ class HelmInfantry {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::Referee referee_;
   Device::Can can_;
   Device::AI ai_;
@@ -36,8 +37,11 @@ class HelmInfantry {
   Device::DR16 dr16_;
   Device::RGB led_;
 
+  System::Memory::Owner chassis_owner_ = System::Memory::Owner("chassis");
   Module::RMHelmChassis chassis_;
+  System::Memory::Owner gimbal_owner_ = System::Memory::Owner("gimbal");
   Module::Gimbal gimbal_;
+  System::Memory::Owner launcher_owner_ = System::Memory::Owner("launcher");
   Module::Launcher launcher_;
 
   HelmInfantry(Param& param, float control_freq)
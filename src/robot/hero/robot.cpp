@@ -309,6 +309,7 @@ Robot::Hero::Param param = {
   },
 
   .launcher = {
+    .name = "launcher",
     .num_trig_tooth = 6.0f,
     .trig_gear_ratio = 3591.0f / 187.0f,
     .fric_radius = 0.03f,
@@ -25,6 +25,7 @@ class Infantry {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::AI ai_;
   Device::AHRS ahrs_;
   Device::BMI088 bmi088_;
@@ -34,8 +35,11 @@ class Infantry {
   Device::DR16 dr16_;
   Device::RGB led_;
 
+  System::Memory::Owner chassis_owner_ = System::Memory::Owner("chassis");
   Module::RMChassis chassis_;
+  System::Memory::Owner gimbal_owner_ = System::Memory::Owner("gimbal");
   Module::Gimbal gimbal_;
+  System::Memory::Owner launcher_owner_ = System::Memory::Owner("launcher");
   Module::Launcher launcher_;
 
   Infantry(Param& param, float control_freq)
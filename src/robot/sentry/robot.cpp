@@ -295,6 +295,7 @@ Robot::Sentry::Param param = {
   },
 
   .launcher1 = {
+    .name = "launcher1",
     .num_trig_tooth = 8.0f,
     .trig_gear_ratio = 36.0f,
     .fric_radius = 0.03f,
@@ -429,6 +430,7 @@ Robot::Sentry::Param param = {
     },
   }, /* launcher1 */
 .launcher2 = {
+    .name = "launcher2",
     .num_trig_tooth = 8.0f,
     .trig_gear_ratio = 36.0f,
     .fric_radius = 0.03f,
@@ -26,6 +26,7 @@ class Sentry {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::AI ai_;
 
   Device::AHRS ahrs_;
@@ -36,9 +37,13 @@ class Sentry {
   Device::RGB led_;
   Device::Referee referee_;
 
+  System::Memory::Owner chassis_owner_ = System::Memory::Owner("chassis");
   Module::RMChassis chassis_;
+  System::Memory::Owner gimbal_owner_ = System::Memory::Owner("gimbal");
   Module::Gimbal gimbal_;
+  System::Memory::Owner launcher1_owner_ = System::Memory::Owner("launcher1");
   Module::Launcher launcher1_;
+  System::Memory::Owner launcher2_owner_ = System::Memory::Owner("launcher2");
   Module::Launcher launcher2_;
   Sentry(Param& param, float control_freq)
       : cmd_(Component::CMD::CMD_AUTO_CTRL),
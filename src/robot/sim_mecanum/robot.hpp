@@ -19,6 +19,7 @@ class Simulator {
 
   Component::CMD cmd_;
 
+  System::Memory::Owner device_owner_ = System::Memory::Owner("device");
   Device::BlinkLED led_;
   Device::Cap cap_;
   Device::Referee referee_;
@@ -26,6 +27,7 @@ class Simulator {
   Device::Camera camera_;
   Device::IMU imu_;
 
+  System::Memory::Owner chassis_owner_ = System::Memory::Owner("chassis");
   Module::RMChassis chassis_;
 
   Simulator(Param& param)
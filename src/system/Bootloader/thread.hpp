@@ -12,6 +12,9 @@ class Thread {
  public:
   typedef enum { IDLE, LOW, MEDIUM, HIGH, REALTIME } Priority;
 
+  /* 是否支持抢占式多线程，不支持时Create不会创建线程 */
+  static constexpr bool MULTITHREAD = false;
+
   template <typename FunType, typename ArgType>
   void Create(FunType fun, ArgType arg, const char* name, uint32_t stack_depth,
               Priority priority) {
@@ -22,6 +25,21 @@ class Thread {
     XB_UNUSED(priority);
   }
 
+  template <typename FunType, typename ArgType>
+  void CreatePeriodic(FunType fun, ArgType arg, const char* name,
+                      uint32_t stack_depth, Priority priority,
+                      uint32_t cycle) {
+    XB_UNUSED(cycle);
+    this->Create(fun, arg, name, stack_depth, priority);
+  }
+
+  template <typename FunType, typename ArgType, typename EventType>
+  void CreateEvent(FunType fun, ArgType arg, const char* name,
+                   uint32_t stack_depth, Priority priority, EventType& event) {
+    XB_UNUSED(event);
+    this->Create(fun, arg, name, stack_depth, priority);
+  }
+
   static Thread Current(void) { return Thread(); }
 
   static void Sleep(uint32_t microseconds) {
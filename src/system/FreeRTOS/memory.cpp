@@ -1,9 +1,193 @@
+#include <cstdio>
+#include <cstring>
 #include <memory.hpp>
+#include <thread.hpp>
 
 #include "portable.h"
+#include "task.h"
 
 using namespace System;
 
-void* operator new(std::size_t size) { return pvPortMalloc(size); }
+void* operator new(std::size_t size) { return Memory::Malloc(size); }
 
-void operator delete(void* ptr) noexcept { vPortFree(ptr); }
+void operator delete(void* ptr) noexcept { Memory::Free(ptr); }
+
+#define MEMORY_OWNER_NUM (24)
+
+typedef struct {
+  const char* name;
+  uint32_t arena_bytes;
+  uint32_t heap_bytes;
+  uint32_t count;
+} OwnerUsage;
+
+/* 0号为未标记的系统分配，1号为封存后的运行期分配 */
+static OwnerUsage owner_usage[MEMORY_OWNER_NUM] = {{"system", 0, 0, 0},
+                                                   {"runtime", 0, 0, 0}};
+static uint32_t owner_num = 2;
+static uint32_t owner_current = 0;
+static bool arena_sealed = false;
+static uint32_t arena_free_count = 0;
+
+#if FREERTOS_ARENA_SIZE > 0
+/* 单独的符号，便于在链接map中确认大小与所在段 */
+alignas(8) uint8_t system_arena[FREERTOS_ARENA_SIZE];
+
+static size_t arena_used;
+#endif
+
+static void account(size_t size, bool from_arena) {
+  OwnerUsage& usage = owner_usage[arena_sealed ? 1 : owner_current];
+  if (from_arena) {
+    usage.arena_bytes += size;
+  } else {
+    usage.heap_bytes += size;
+  }
+  usage.count++;
+}
+
+void* Memory::Malloc(size_t size) {
+  void* ans = NULL;
+
+#if FREERTOS_ARENA_SIZE > 0
+  const size_t ALIGNED = (size + 7u) & ~static_cast<size_t>(7u);
+
+  taskENTER_CRITICAL();
+  if (!arena_sealed && arena_used + ALIGNED <= sizeof(system_arena)) {
+    ans = &system_arena[arena_used];
+    arena_used += ALIGNED;
+    account(ALIGNED, true);
+  }
+  taskEXIT_CRITICAL();
+
+  if (ans != NULL) {
+    return ans;
+  }
+#endif
+
+#if FREERTOS_ARENA_SEAL_ASSERT
+  /* 控制循环中不允许动态分配 */
+  XB_ASSERT(!arena_sealed);
+#endif
+
+  ans = pvPortMalloc(size);
+
+  taskENTER_CRITICAL();
+  account(size, false);
+  taskEXIT_CRITICAL();
+
+  return ans;
+}
+
+void Memory::Free(void* block) {
+#if FREERTOS_ARENA_SIZE > 0
+  const uint8_t* ADDR = static_cast<const uint8_t*>(block);
+  if (ADDR >= system_arena && ADDR < system_arena + sizeof(system_arena)) {
+    arena_free_count++;
+    return;
+  }
+#endif
+
+  vPortFree(block);
+}
+
+void Memory::SetOwner(const char* owner) {
+  taskENTER_CRITICAL();
+  uint32_t i = 0;
+  while (i < owner_num && strcmp(owner_usage[i].name, owner) != 0) {
+    i++;
+  }
+
+  if (i == owner_num && owner_num < MEMORY_OWNER_NUM) {
+    owner_usage[i] = {owner, 0, 0, 0};
+    owner_num++;
+  }
+
+  owner_current = i < MEMORY_OWNER_NUM ? i : 0;
+  taskEXIT_CRITICAL();
+}
+
+void Memory::Seal() {
+  taskENTER_CRITICAL();
+  arena_sealed = true;
+  owner_current = 1;
+  taskEXIT_CRITICAL();
+}
+
+static size_t static_usage[Memory::STATIC_TYPE_NUM];
+
+static const char* const STATIC_TYPE_NAME[Memory::STATIC_TYPE_NUM] = {
+    "thread stack", "thread tcb", "queue", "callback",
+    "timer",        "robot",      "other"};
+
+#if FREERTOS_STATIC_ALLOCATION
+/* 单独的符号，便于在链接map中确认大小与所在段 */
+alignas(8) uint8_t system_static_pool[FREERTOS_STATIC_POOL_SIZE];
+
+static size_t static_pool_used;
+#endif
+
+void* Memory::MallocStatic(size_t size, StaticType type) {
+  size = (size + 7u) & ~static_cast<size_t>(7u);
+
+  void* ans = NULL;
+
+#if !FREERTOS_STATIC_ALLOCATION
+  ans = Malloc(size);
+#endif
+
+  taskENTER_CRITICAL();
+#if FREERTOS_STATIC_ALLOCATION
+  if (static_pool_used + size <= sizeof(system_static_pool)) {
+    ans = &system_static_pool[static_pool_used];
+    static_pool_used += size;
+  }
+#endif
+  if (ans != NULL) {
+    static_usage[type] += size;
+  }
+  taskEXIT_CRITICAL();
+
+  XB_ASSERT(ans != NULL);
+
+  return ans;
+}
+
+void Memory::PrintReport() {
+#if FREERTOS_STATIC_ALLOCATION
+  printf("static pool: %u/%u bytes\r\n",
+         static_cast<unsigned int>(static_pool_used),
+         static_cast<unsigned int>(sizeof(system_static_pool)));
+#else
+  printf("static pool: disabled, system objects use heap\r\n");
+#endif
+
+  for (int i = 0; i < STATIC_TYPE_NUM; i++) {
+    printf("\t%-14s %8u bytes\r\n", STATIC_TYPE_NAME[i],
+           static_cast<unsigned int>(static_usage[i]));
+  }
+
+  printf("heap free: %u bytes, minimum ever free: %u bytes\r\n",
+         static_cast<unsigned int>(xPortGetFreeHeapSize()),
+         static_cast<unsigned int>(xPortGetMinimumEverFreeHeapSize()));
+
+#if FREERTOS_ARENA_SIZE > 0
+  printf("arena: %u/%u bytes, %s, %lu frees not reclaimed\r\n",
+         static_cast<unsigned int>(arena_used),
+         static_cast<unsigned int>(sizeof(system_arena)),
+         arena_sealed ? "sealed" : "open",
+         static_cast<unsigned long>(arena_free_count));
+#else
+  printf("arena: disabled\r\n");
+#endif
+
+  printf("%-16s %10s %10s %8s\r\n", "owner", "arena(B)", "heap(B)", "count");
+  for (uint32_t i = 0; i < owner_num; i++) {
+    printf("%-16s %10lu %10lu %8lu\r\n", owner_usage[i].name,
+           static_cast<unsigned long>(owner_usage[i].arena_bytes),
+           static_cast<unsigned long>(owner_usage[i].heap_bytes),
+           static_cast<unsigned long>(owner_usage[i].count));
+  }
+
+  Thread::PrintReport();
+}
@@ -4,12 +4,62 @@
 
 #include "FreeRTOS.h"
 
+/* 静态分配模式需要在FreeRTOSConfig.h中开启configSUPPORT_STATIC_ALLOCATION */
+#if FREERTOS_STATIC_ALLOCATION && !configSUPPORT_STATIC_ALLOCATION
+#error "FREERTOS_STATIC_ALLOCATION requires configSUPPORT_STATIC_ALLOCATION."
+#endif
+
+#ifndef FREERTOS_STATIC_POOL_SIZE
+#define FREERTOS_STATIC_POOL_SIZE (32768)
+#endif
+
+/* 构造期内存区大小，0表示不使用 */
+#ifndef FREERTOS_ARENA_SIZE
+#define FREERTOS_ARENA_SIZE (0)
+#endif
+
+/* 初始化结束后等待线程完成准备工作再封存内存区，单位ms */
+#ifndef FREERTOS_ARENA_SEAL_DELAY
+#define FREERTOS_ARENA_SEAL_DELAY (1000)
+#endif
+
 void* operator new(std::size_t size);
 void operator delete(void* ptr) noexcept;
 namespace System {
 class Memory {
  public:
-  static void* Malloc(size_t size) { return pvPortMalloc(size); }
-  static void Free(void* block) { vPortFree(block); }
+  /* 启动阶段创建、永不释放的系统对象类别 */
+  typedef enum {
+    STATIC_THREAD_STACK,
+    STATIC_THREAD_TCB,
+    STATIC_QUEUE,
+    STATIC_CALLBACK,
+    STATIC_TIMER,
+    STATIC_ROBOT,
+    STATIC_OTHER,
+    STATIC_TYPE_NUM
+  } StaticType;
+
+  /* 封存前优先从构造期内存区顺序分配，内存区中的内存释放时不回收 */
+  static void* Malloc(size_t size);
+  static void Free(void* block);
+
+  /* 之后的分配计入owner，用于按模块统计 */
+  static void SetOwner(const char* owner);
+
+  /* 初始化结束，之后的分配计为运行期分配 */
+  static void Seal();
+
+  /* 作为机器人类的成员放在模块成员之前，标记后续成员构造时的分配 */
+  class Owner {
+   public:
+    Owner(const char* name) { SetOwner(name); }
+  };
+
+  /* 静态分配模式下从静态内存池中分配，否则从堆中分配，均按类别统计 */
+  static void* MallocStatic(size_t size, StaticType type = STATIC_OTHER);
+
+  /* 打印静态内存与堆的使用情况 */
+  static void PrintReport();
 };
 }  // namespace System
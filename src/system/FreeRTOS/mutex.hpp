@@ -8,15 +8,28 @@
 namespace System {
 class Mutex {
  public:
+#if FREERTOS_STATIC_ALLOCATION
+  Mutex() : mutex_(xSemaphoreCreateMutexStatic(&this->buffer_)) {}
+#else
   Mutex() : mutex_(xSemaphoreCreateMutex()) {}
+#endif
 
   ~Mutex() { vSemaphoreDelete(mutex_); }
 
+  /* 句柄指向对象内的控制块，不能复制或移动 */
+  Mutex(const Mutex&) = delete;
+  Mutex& operator=(const Mutex&) = delete;
+  Mutex(Mutex&&) = delete;
+  Mutex& operator=(Mutex&&) = delete;
+
   void Unlock() { xSemaphoreGive(mutex_); }
 
   bool Lock() { return xSemaphoreTake(mutex_, UINT32_MAX); }
 
  private:
+#if FREERTOS_STATIC_ALLOCATION
+  StaticSemaphore_t buffer_;
+#endif
   SemaphoreHandle_t mutex_;
 };
 }  // namespace System
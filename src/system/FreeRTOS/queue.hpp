@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory.hpp>
 #include <mutex.hpp>
 #include <semaphore.hpp>
 #include <thread.hpp>
@@ -16,7 +17,23 @@ namespace System {
 template <typename Data>
 class Queue {
  public:
+#if FREERTOS_STATIC_ALLOCATION
+  /* 存储区大小由数据类型与长度确定，从静态内存池中分配 */
+  Queue(uint16_t length)
+      : queue_(xQueueCreateStatic(
+            length, sizeof(Data),
+            static_cast<uint8_t*>(Memory::MallocStatic(
+                length * sizeof(Data), Memory::STATIC_QUEUE)),
+            &this->buffer_)) {}
+#else
   Queue(uint16_t length) : queue_(xQueueCreate(length, sizeof(Data))) {}
+#endif
+
+  /* 句柄指向对象内的控制块，不能复制或移动 */
+  Queue(const Queue&) = delete;
+  Queue& operator=(const Queue&) = delete;
+  Queue(Queue&&) = delete;
+  Queue& operator=(Queue&&) = delete;
 
   bool Send(const Data& data) {
     if (bsp_sys_in_isr()) {
@@ -71,6 +88,9 @@ class Queue {
   }
 
  private:
+#if FREERTOS_STATIC_ALLOCATION
+  StaticQueue_t buffer_;
+#endif
   QueueHandle_t queue_;
 };
 }  // namespace System
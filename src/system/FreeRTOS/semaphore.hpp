@@ -5,16 +5,31 @@
 #include "FreeRTOS.h"
 #include "bsp_sys.h"
 #include "semphr.h"
+#include "trace.hpp"
 
 namespace System {
 class Semaphore {
  public:
+#if FREERTOS_STATIC_ALLOCATION
+  Semaphore(uint32_t init_count)
+      : handle_(xSemaphoreCreateCountingStatic(UINT32_MAX, init_count,
+                                               &this->buffer_)) {}
+#else
   Semaphore(uint32_t init_count)
       : handle_(xSemaphoreCreateCounting(UINT32_MAX, init_count)) {}
+#endif
 
   ~Semaphore() { vSemaphoreDelete(handle_); }
 
+  /* 句柄指向对象内的控制块，不能复制或移动 */
+  Semaphore(const Semaphore&) = delete;
+  Semaphore& operator=(const Semaphore&) = delete;
+  Semaphore(Semaphore&&) = delete;
+  Semaphore& operator=(Semaphore&&) = delete;
+
   void Post() {
+    Trace::Instant(Trace::SEMAPHORE, "post", this);
+
     if (bsp_sys_in_isr()) {
       BaseType_t px_higher_priority_task_woken = 0;
       xSemaphoreGiveFromISR(this->handle_, &px_higher_priority_task_woken);
@@ -28,7 +43,15 @@ class Semaphore {
 
   bool Wait(uint32_t timeout = UINT32_MAX) {
     if (!bsp_sys_in_isr()) {
-      return xSemaphoreTake(this->handle_, timeout) == pdTRUE;
+      if (timeout == 0) {
+        return xSemaphoreTake(this->handle_, 0) == pdTRUE;
+      }
+
+      /* 只记录可能阻塞的等待 */
+      Trace::Begin(Trace::SEMAPHORE, "wait", this);
+      bool ans = xSemaphoreTake(this->handle_, timeout) == pdTRUE;
+      Trace::End(Trace::SEMAPHORE, "wait", this);
+      return ans;
     } else {
       BaseType_t px_higher_priority_task_woken = 0;
       BaseType_t ans =
@@ -45,6 +68,9 @@ class Semaphore {
   uint32_t Value() { return uxSemaphoreGetCount(&handle_); }
 
  private:
+#if FREERTOS_STATIC_ALLOCATION
+  StaticSemaphore_t buffer_;
+#endif
   SemaphoreHandle_t handle_;
 };
 }  // namespace System
@@ -13,19 +13,31 @@ namespace System {
 template <typename RobotType, typename... RobotParam>
 void Start(RobotParam... param) {
   auto init_fun = [](RobotParam... param) {
-    Message* msg = static_cast<Message*>(pvPortMalloc(sizeof(Message)));
+    Message* msg = static_cast<Message*>(
+        Memory::MallocStatic(sizeof(Message), Memory::STATIC_OTHER));
     new (msg) Message();
-    Term* term = static_cast<Term*>(pvPortMalloc(sizeof(Term)));
+    Term* term = static_cast<Term*>(
+        Memory::MallocStatic(sizeof(Term), Memory::STATIC_OTHER));
     new (term) Term();
-    Database* database = static_cast<Database*>(pvPortMalloc(sizeof(Database)));
+    Database* database = static_cast<Database*>(
+        Memory::MallocStatic(sizeof(Database), Memory::STATIC_OTHER));
     new (database) Database();
-    Timer* timer = static_cast<Timer*>(pvPortMalloc(sizeof(Timer)));
+    Timer* timer = static_cast<Timer*>(
+        Memory::MallocStatic(sizeof(Timer), Memory::STATIC_OTHER));
     new (timer) Timer();
 
-    static auto xrobot_debug_handle = new RobotType(param...);
+    Memory::SetOwner("robot");
+
+    static auto xrobot_debug_handle = new (
+        Memory::MallocStatic(sizeof(RobotType), Memory::STATIC_ROBOT))
+        RobotType(param...);
 
     XB_UNUSED(xrobot_debug_handle);
 
+    /* 等待各线程完成准备工作后封存构造期内存区 */
+    System::Thread::Sleep(FREERTOS_ARENA_SEAL_DELAY);
+    Memory::Seal();
+
     while (1) {
       System::Thread::Sleep(UINT32_MAX);
     }
@@ -1,6 +1,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <memory.hpp>
 #include <term.hpp>
 #include <thread.hpp>
 
@@ -10,12 +11,17 @@
 #include "ms.h"
 #include "om.hpp"
 #include "om_def.h"
+#include "trace.hpp"
 
 using namespace System;
 
 static System::Thread term_thread, usb_thread;
 
-static ms_item_t task_info, power_ctrl, date;
+static ms_item_t task_info, power_ctrl, date, mem_info;
+
+#if SYSTEM_TRACE
+static ms_item_t trace;
+#endif
 
 #ifdef MCU_DEBUG_BUILD
 static char task_print_buff[1024];
@@ -122,6 +128,32 @@ Term::Term() {
   ms_file_init(&date, "date", date_cmd_fn, NULL, 0, false);
   ms_cmd_add(&date);
 
+#endif
+
+  auto mem_cmd_fn = [](ms_item_t *item, int argc, char **argv) {
+    XB_UNUSED(item);
+    XB_UNUSED(argc);
+    XB_UNUSED(argv);
+
+    System::Memory::PrintReport();
+
+    return 0;
+  };
+
+  ms_file_init(&mem_info, "mem_info", mem_cmd_fn, NULL, 0, false);
+  ms_cmd_add(&mem_info);
+
+#if SYSTEM_TRACE
+  System::Trace::Init();
+
+  auto trace_cmd_fn = [](ms_item_t *item, int argc, char **argv) {
+    XB_UNUSED(item);
+
+    return System::Trace::Command(argc, argv);
+  };
+
+  ms_file_init(&trace, "trace", trace_cmd_fn, NULL, 0, false);
+  ms_cmd_add(&trace);
 #endif
 
   auto usb_thread_fn = [](void *arg) {
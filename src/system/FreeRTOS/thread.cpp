@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <cstring>
+#include <thread.hpp>
+
+using namespace System;
+
+Thread::ThreadInfo* Thread::info_list_ = NULL;
+Thread::ThreadInfo* Thread::free_list_ = NULL;
+
+Thread::ThreadInfo* Thread::TakeInfo(uint32_t stack_depth, size_t type_size) {
+  ThreadInfo* info = NULL;
+
+  taskENTER_CRITICAL();
+  for (ThreadInfo** pos = &free_list_; *pos != NULL; pos = &(*pos)->next) {
+    bool fit = (*pos)->type_size >= type_size;
+#if FREERTOS_STATIC_ALLOCATION
+    fit = fit && (*pos)->stack_depth >= stack_depth;
+#endif
+    if (fit) {
+      info = *pos;
+      *pos = info->next;
+      break;
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  if (info != NULL) {
+#if !FREERTOS_STATIC_ALLOCATION
+    info->stack_depth = stack_depth;
+#endif
+    return info;
+  }
+
+  info = static_cast<ThreadInfo*>(
+      Memory::MallocStatic(sizeof(ThreadInfo), Memory::STATIC_OTHER));
+  info->stack_depth = stack_depth;
+  info->type = Memory::MallocStatic(type_size, Memory::STATIC_CALLBACK);
+  info->type_size = type_size;
+
+#if FREERTOS_STATIC_ALLOCATION
+  info->stack = static_cast<StackType_t*>(Memory::MallocStatic(
+      stack_depth * sizeof(StackType_t), Memory::STATIC_THREAD_STACK));
+  info->tcb = static_cast<StaticTask_t*>(
+      Memory::MallocStatic(sizeof(StaticTask_t), Memory::STATIC_THREAD_TCB));
+#endif
+
+  return info;
+}
+
+void Thread::AddInfo(ThreadInfo* info, TaskHandle_t handle) {
+  info->handle = handle;
+
+  taskENTER_CRITICAL();
+  info->next = info_list_;
+  info_list_ = info;
+  taskEXIT_CRITICAL();
+}
+
+void Thread::RemoveInfo(TaskHandle_t handle) {
+  if (handle == NULL) {
+    return;
+  }
+
+  const bool SELF = handle == xTaskGetCurrentTaskHandle();
+
+  taskENTER_CRITICAL();
+  for (ThreadInfo** pos = &info_list_; *pos != NULL; pos = &(*pos)->next) {
+    if ((*pos)->handle != handle) {
+      continue;
+    }
+
+    ThreadInfo* info = *pos;
+    *pos = info->next;
+    info->handle = NULL;
+
+    /* 删除自身时由空闲任务回收，栈与TCB此时仍在使用 */
+    if (!SELF) {
+      info->next = free_list_;
+      free_list_ = info;
+    }
+    break;
+  }
+  taskEXIT_CRITICAL();
+}
+
+void Thread::PrintReport() {
+  printf("%-20s %10s %10s\r\n", "thread", "stack(B)", "free(B)");
+
+  /* 每次只在挂起调度时读取一条记录，打印期间线程可能被删除 */
+  for (size_t index = 0;; index++) {
+    char name[configMAX_TASK_NAME_LEN + 1] = {};
+    unsigned int stack = 0, free = 0;
+    bool found = false;
+
+    vTaskSuspendAll();
+    ThreadInfo* info = info_list_;
+    for (size_t i = 0; info != NULL && i < index; i++) {
+      info = info->next;
+    }
+    if (info != NULL) {
+      found = true;
+      strncpy(name, pcTaskGetName(info->handle), configMAX_TASK_NAME_LEN);
+      stack =
+          static_cast<unsigned int>(info->stack_depth * sizeof(StackType_t));
+#if INCLUDE_uxTaskGetStackHighWaterMark
+      free = static_cast<unsigned int>(
+          uxTaskGetStackHighWaterMark(info->handle) * sizeof(StackType_t));
+#endif
+    }
+    xTaskResumeAll();
+
+    if (!found) {
+      break;
+    }
+
+    printf("%-20s %10u %10u\r\n", name, stack, free);
+  }
+}
@@ -3,16 +3,22 @@
 #include <cstdint>
 #include <string>
 
+#include <memory.hpp>
+
 #include "FreeRTOS.h"
 #include "bsp_time.h"
 #include "system_ext.hpp"
 #include "task.h"
+#include "trace.hpp"
 
 namespace System {
 class Thread {
  public:
   typedef enum { IDLE, LOW, MEDIUM, HIGH, REALTIME } Priority;
 
+  /* 是否支持抢占式多线程 */
+  static constexpr bool MULTITHREAD = true;
+
   Thread(){};
   Thread(TaskHandle_t handle) : handle_(handle){};
 
@@ -21,15 +27,93 @@ class Thread {
               Priority priority) {
     (void)static_cast<void (*)(ArgType)>(fun);
 
-    TypeErasure<void, ArgType>* type = static_cast<TypeErasure<void, ArgType>*>(
-        pvPortMalloc(sizeof(TypeErasure<void, ArgType>)));
+    /* 优先复用已删除线程的记录 */
+    ThreadInfo* info =
+        TakeInfo(stack_depth, sizeof(TypeErasure<void, ArgType>));
+
+    TypeErasure<void, ArgType>* type =
+        static_cast<TypeErasure<void, ArgType>*>(info->type);
 
     *type = TypeErasure<void, ArgType>(fun, arg);
 
+    /* 新线程优先级更高时会立即运行，登记完成前不切换 */
+    vTaskSuspendAll();
+
+#if FREERTOS_STATIC_ALLOCATION
+    this->handle_ = xTaskCreateStatic(type->Port, name, info->stack_depth,
+                                      type, priority, info->stack, info->tcb);
+#else
     xTaskCreate(type->Port, name, stack_depth, type, priority,
                 &(this->handle_));
+#endif
+
+    AddInfo(info, this->handle_);
+
+    xTaskResumeAll();
+  }
+
+  /* 每cycle毫秒调用一次fun，与无操作系统时的周期任务写法一致 */
+  template <typename FunType, typename ArgType>
+  void CreatePeriodic(FunType fun, ArgType arg, const char* name,
+                      uint32_t stack_depth, Priority priority,
+                      uint32_t cycle) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      uint32_t cycle;
+      Thread* thread;
+    } PeriodicBlock;
+
+    PeriodicBlock* block = static_cast<PeriodicBlock*>(Memory::MallocStatic(
+        sizeof(PeriodicBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->cycle = cycle;
+    block->thread = this;
+
+    auto periodic_thread = [](PeriodicBlock* block) {
+      uint32_t last_online_time = bsp_time_get_ms();
+
+      while (1) {
+        block->type.fun_(block->type.arg_);
+        block->thread->SleepUntil(block->cycle, last_online_time);
+      }
+    };
+
+    this->Create(periodic_thread, block, name, stack_depth, priority);
   }
 
+  /* 每次event.Wait成功时调用一次fun */
+  template <typename FunType, typename ArgType, typename EventType>
+  void CreateEvent(FunType fun, ArgType arg, const char* name,
+                   uint32_t stack_depth, Priority priority, EventType& event) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      EventType* event;
+    } EventBlock;
+
+    EventBlock* block = static_cast<EventBlock*>(
+        Memory::MallocStatic(sizeof(EventBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->event = &event;
+
+    auto event_thread = [](EventBlock* block) {
+      while (1) {
+        block->event->Wait(UINT32_MAX);
+        Trace::Begin(Trace::THREAD);
+        block->type.fun_(block->type.arg_);
+        Trace::End(Trace::THREAD);
+      }
+    };
+
+    this->Create(event_thread, block, name, stack_depth, priority);
+  }
+
+  /* 打印每个线程的栈大小与剩余量 */
+  static void PrintReport();
+
   static Thread Current(void) { return Thread(xTaskGetCurrentTaskHandle()); }
 
   static void Sleep(uint32_t microseconds) { vTaskDelay(microseconds); }
@@ -55,13 +139,42 @@ class Thread {
   }
 
   void SleepUntil(uint32_t microseconds, uint32_t& last_wakeup_time) {
+    Trace::End(Trace::THREAD);
     vTaskDelayUntil(&last_wakeup_time, microseconds);
+    Trace::Begin(Trace::THREAD);
   }
 
-  void Delete() { vTaskDelete(this->handle_); }
+  /* 线程记录在删除前摘除，删除自身时栈仍在使用，不复用 */
+  void Delete() {
+    RemoveInfo(this->handle_);
+    vTaskDelete(this->handle_);
+  }
 
   static void Yield() { taskYIELD(); }
 
   TaskHandle_t handle_ = NULL;
+
+ private:
+  typedef struct ThreadInfo {
+    TaskHandle_t handle;
+    uint32_t stack_depth;
+    void* type; /* 线程入口的TypeErasure */
+    size_t type_size;
+#if FREERTOS_STATIC_ALLOCATION
+    StackType_t* stack;
+    StaticTask_t* tcb;
+#endif
+    ThreadInfo* next;
+  } ThreadInfo;
+
+  /* 从空闲链表中取出足够大的记录，没有时从静态内存中分配 */
+  static ThreadInfo* TakeInfo(uint32_t stack_depth, size_t type_size);
+
+  static void AddInfo(ThreadInfo* info, TaskHandle_t handle);
+
+  static void RemoveInfo(TaskHandle_t handle);
+
+  static ThreadInfo* info_list_;
+  static ThreadInfo* free_list_; /* 已删除线程的记录 */
 };
 }  // namespace System
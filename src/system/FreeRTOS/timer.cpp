@@ -32,7 +32,9 @@ bool Timer::Refresh(ControlBlock& block, void* arg) {
   block.count++;
   if (block.cycle <= block.count) {
     block.count = 0;
+    Trace::Begin(Trace::TIMER, "timer", block.type);
     block.fun(block.type);
+    Trace::End(Trace::TIMER, "timer", block.type);
   }
 
   return true;
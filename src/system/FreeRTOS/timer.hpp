@@ -1,6 +1,8 @@
 #pragma once
 
 #include <list.hpp>
+#include <memory.hpp>
+#include <new>
 #include <thread.hpp>
 
 #include "FreeRTOS.h"
@@ -28,9 +30,16 @@ class Timer {
   static TimerHandle Create(FunType fun, ArgType arg, uint32_t cycle) {
     (void)static_cast<void (*)(ArgType)>(fun);
     TypeErasure<void, ArgType>* type = static_cast<TypeErasure<void, ArgType>*>(
-        pvPortMalloc(sizeof(TypeErasure<void, ArgType>)));
+        Memory::MallocStatic(sizeof(TypeErasure<void, ArgType>),
+                             Memory::STATIC_CALLBACK));
     *type = TypeErasure<void, ArgType>(fun, arg);
+#if FREERTOS_STATIC_ALLOCATION
+    auto block = new (Memory::MallocStatic(
+        sizeof(System::List<ControlBlock>::Node), Memory::STATIC_TIMER))
+        System::List<ControlBlock>::Node;
+#else
     auto block = new System::List<ControlBlock>::Node;
+#endif
     block->data_.count = 0;
     block->data_.cycle = cycle;
     block->data_.fun = type->Port;
@@ -42,7 +51,11 @@ class Timer {
 
   static void Delete(TimerHandle& handle) {
     self_->list_.Delete(*handle);
+#if FREERTOS_STATIC_ALLOCATION
+    /* 静态内存池中的控制块不回收 */
+#else
     delete (handle);
+#endif
   }
 
   static void Start(TimerHandle& handle) { handle->data_.running = true; }
@@ -0,0 +1,197 @@
+#include <executor.hpp>
+#include <term.hpp>
+
+#include "bsp_def.h"
+#include "bsp_time.h"
+#include "trace.hpp"
+
+using namespace System;
+
+#if LINUX_TASK_EXECUTOR
+pthread_mutex_t Executor::mutex_ = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t Executor::cond_ = PTHREAD_COND_INITIALIZER;
+
+Executor::Task* Executor::ready_head_;
+Executor::Task* Executor::ready_tail_;
+Executor::Task* Executor::timer_list_;
+Executor::Task* Executor::list_;
+
+void Executor::Init() {
+  /* 终端在机器人对象构造前初始化，此时注册命令是安全的 */
+  new System::Term::Command<Executor*>(NULL, Command, "executor",
+                                       System::Term::BinDir());
+
+  for (int i = 0; i < LINUX_TASK_EXECUTOR_WORKER_NUM; i++) {
+    pthread_t handle;
+    pthread_create(&handle, NULL, Worker, NULL);
+  }
+}
+
+Executor::Task* Executor::Create(Task::Fun fun, void* arg, const char* name,
+                                 uint32_t cycle) {
+  Task* task = new Task();
+
+  task->name_ = name;
+  task->fun_ = fun;
+  task->arg_ = arg;
+  task->cycle_ = cycle;
+  task->wake_time_ = bsp_time_get_ms();
+
+  pthread_mutex_lock(&mutex_);
+
+  const bool FIRST = list_ == nullptr;
+
+  task->list_next_ = list_;
+  list_ = task;
+
+  /* 周期任务立即执行第一次，事件任务先检查一次创建前到达的事件 */
+  PushReady(task);
+
+  pthread_mutex_unlock(&mutex_);
+
+  if (FIRST) {
+    Init();
+  }
+
+  return task;
+}
+
+void Executor::Wake(Task* task) {
+  pthread_mutex_lock(&mutex_);
+
+  if (task->running_) {
+    task->pending_ = true;
+  } else if (!task->queued_) {
+    PushReady(task);
+  }
+
+  pthread_mutex_unlock(&mutex_);
+}
+
+void Executor::PushReady(Task* task) {
+  task->queued_ = true;
+  task->next_ = nullptr;
+
+  if (ready_tail_ == nullptr) {
+    ready_head_ = task;
+  } else {
+    ready_tail_->next_ = task;
+  }
+  ready_tail_ = task;
+
+  pthread_cond_signal(&cond_);
+}
+
+void Executor::PushTimer(Task* task) {
+  /* 按唤醒时间排序 */
+  Task** pos = &timer_list_;
+  while (*pos != nullptr &&
+         static_cast<int32_t>(task->wake_time_ - (*pos)->wake_time_) >= 0) {
+    pos = &(*pos)->next_;
+  }
+  task->next_ = *pos;
+  *pos = task;
+}
+
+void* Executor::Worker(void* arg) {
+  XB_UNUSED(arg);
+
+  pthread_mutex_lock(&mutex_);
+
+  while (1) {
+    const uint32_t NOW = bsp_time_get_ms();
+
+    /* 到期的周期任务转入就绪队列 */
+    while (timer_list_ != nullptr &&
+           static_cast<int32_t>(NOW - timer_list_->wake_time_) >= 0) {
+      Task* task = timer_list_;
+      timer_list_ = task->next_;
+      PushReady(task);
+    }
+
+    if (ready_head_ != nullptr) {
+      Task* task = ready_head_;
+      ready_head_ = task->next_;
+      if (ready_head_ == nullptr) {
+        ready_tail_ = nullptr;
+      }
+
+      task->queued_ = false;
+      task->running_ = true;
+
+      pthread_mutex_unlock(&mutex_);
+
+      const uint64_t START = bsp_time_get();
+      Trace::Begin(Trace::THREAD, task->name_);
+      task->fun_(task->arg_);
+      Trace::End(Trace::THREAD, task->name_);
+      const uint32_t DURATION = static_cast<uint32_t>(bsp_time_get() - START);
+
+      pthread_mutex_lock(&mutex_);
+
+      task->running_ = false;
+      task->run_count_++;
+      if (DURATION > task->run_max_us_) {
+        task->run_max_us_ = DURATION;
+      }
+
+      if (task->cycle_ > 0) {
+        /* 与SleepUntil一致，落后时连续执行追赶 */
+        task->wake_time_ += task->cycle_;
+        if (static_cast<int32_t>(bsp_time_get_ms() - task->wake_time_) > 0) {
+          task->miss_count_++;
+        }
+        PushTimer(task);
+      } else if (task->pending_) {
+        task->pending_ = false;
+        PushReady(task);
+      }
+
+      continue;
+    }
+
+    if (timer_list_ == nullptr) {
+      pthread_cond_wait(&cond_, &mutex_);
+      continue;
+    }
+
+    const uint32_t TIMEOUT = timer_list_->wake_time_ - NOW;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    long raw_time = TIMEOUT % 1000 * 1000L * 1000L + ts.tv_nsec;
+    ts.tv_sec += TIMEOUT / 1000 + raw_time / (1000L * 1000L * 1000L);
+    ts.tv_nsec = raw_time % (1000L * 1000L * 1000L);
+
+    pthread_cond_timedwait(&cond_, &mutex_, &ts);
+  }
+
+  return NULL;
+}
+
+int Executor::Command(Executor* executor, int argc, char** argv) {
+  XB_UNUSED(executor);
+  XB_UNUSED(argv);
+
+  if (argc != 1) {
+    printf("打印执行器中各任务的运行统计\r\n");
+    return 0;
+  }
+
+  printf("workers: %d\r\n", LINUX_TASK_EXECUTOR_WORKER_NUM);
+  printf("%-20s %6s %10s %6s %10s\r\n", "name", "cycle", "run", "miss",
+         "max(us)");
+
+  pthread_mutex_lock(&mutex_);
+  for (Task* task = list_; task != nullptr; task = task->list_next_) {
+    printf("%-20s %6lu %10lu %6lu %10lu\r\n", task->name_,
+           static_cast<unsigned long>(task->cycle_),
+           static_cast<unsigned long>(task->run_count_),
+           static_cast<unsigned long>(task->miss_count_),
+           static_cast<unsigned long>(task->run_max_us_));
+  }
+  pthread_mutex_unlock(&mutex_);
+
+  return 0;
+}
+#endif
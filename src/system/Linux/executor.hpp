@@ -0,0 +1,88 @@
+/*
+  周期任务与事件任务的执行器。
+  开启LINUX_TASK_EXECUTOR后，CreatePeriodic与CreateEvent不再各自创建线程，
+  而是由少量工作线程按唤醒时间与事件轮流执行，Create创建的线程不受影响。
+*/
+
+#pragma once
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef LINUX_TASK_EXECUTOR_WORKER_NUM
+#define LINUX_TASK_EXECUTOR_WORKER_NUM (2)
+#endif
+
+namespace System {
+class Executor {
+ public:
+  class Task {
+   public:
+    typedef void (*Fun)(void* arg);
+
+   private:
+    const char* name_;
+    Fun fun_;
+    void* arg_;
+    uint32_t cycle_; /* 0为事件任务 */
+    uint32_t wake_time_;
+
+    bool queued_ = false;
+    bool running_ = false;
+    bool pending_ = false; /* 执行期间再次被唤醒 */
+
+    Task* next_ = nullptr;      /* 就绪队列或定时队列 */
+    Task* list_next_ = nullptr; /* 全部任务，用于统计 */
+
+    uint32_t run_count_ = 0;
+    uint32_t miss_count_ = 0;
+    uint32_t run_max_us_ = 0;
+
+    friend class Executor;
+  };
+
+  /* cycle为0时只在Wake后执行，否则从创建时起每cycle毫秒执行一次 */
+  static Task* Create(Task::Fun fun, void* arg, const char* name,
+                      uint32_t cycle);
+
+  /* 唤醒事件任务，可在任意线程中调用 */
+  static void Wake(Task* task);
+
+  static int Command(Executor* executor, int argc, char** argv);
+
+ private:
+  static void Init();
+
+  static void* Worker(void* arg);
+
+  static void PushReady(Task* task);
+
+  static void PushTimer(Task* task);
+
+  static pthread_mutex_t mutex_;
+  static pthread_cond_t cond_;
+
+  static Task* ready_head_;
+  static Task* ready_tail_;
+  static Task* timer_list_;
+  static Task* list_;
+};
+
+/* 绑定到执行器的信号量在Post时唤醒对应任务 */
+class ExecutorListener {
+ public:
+  void Listen(Executor::Task* task) { this->task_.store(task); }
+
+  void Notify() {
+    Executor::Task* task = this->task_.load();
+    if (task != nullptr) {
+      Executor::Wake(task);
+    }
+  }
+
+ private:
+  std::atomic<Executor::Task*> task_{nullptr};
+};
+}  // namespace System
@@ -8,6 +8,7 @@
 #include <thread.hpp>
 
 #include "bsp_time.h"
+#include "trace.hpp"
 
 namespace System {
 class Semaphore {
@@ -16,7 +17,18 @@ class Semaphore {
 
   ~Semaphore() { sem_destroy(&this->handle_); }
 
-  void Post() { sem_post(&this->handle_); }
+  void Post() {
+    Trace::Instant(Trace::SEMAPHORE, "post", this);
+    sem_post(&this->handle_);
+#if LINUX_TASK_EXECUTOR
+    this->listener_.Notify();
+#endif
+  }
+
+#if LINUX_TASK_EXECUTOR
+  /* 由CreateEvent绑定，Post时唤醒执行器中的任务 */
+  void Listen(Executor::Task* task) { this->listener_.Listen(task); }
+#endif
 
   bool Wait(uint32_t timeout = UINT32_MAX) {
     struct timespec ts;
@@ -30,7 +42,15 @@ class Semaphore {
     ts.tv_sec += (add + secs);
     ts.tv_nsec = raw_time % (1000U * 1000U * 1000U);
 
-    return sem_timedwait(&handle_, &ts) == 0;
+    if (timeout == 0 && secs == 0) {
+      return sem_timedwait(&handle_, &ts) == 0;
+    }
+
+    /* 只记录可能阻塞的等待 */
+    Trace::Begin(Trace::SEMAPHORE, "wait", this);
+    bool ans = sem_timedwait(&handle_, &ts) == 0;
+    Trace::End(Trace::SEMAPHORE, "wait", this);
+    return ans;
   }
 
   uint32_t Value() {
@@ -41,5 +61,9 @@ class Semaphore {
 
  private:
   sem_t handle_;
+
+#if LINUX_TASK_EXECUTOR
+  ExecutorListener listener_;
+#endif
 };
 }  // namespace System
@@ -13,6 +13,7 @@
 #include "bsp_udp_server.h"
 #include "ms.h"
 #include "om.hpp"
+#include "trace.hpp"
 
 using namespace System;
 
@@ -22,6 +23,10 @@ static bsp_udp_server_t term_udp_server;
 
 static ms_item_t power_ctrl;
 
+#if SYSTEM_TRACE
+static ms_item_t trace;
+#endif
+
 static int kbhit() {
   struct termios oldt, newt;
   int ch;
@@ -139,6 +144,19 @@ Term::Term() {
   ms_file_init(&power_ctrl, "power", pwr_cmd_fn, NULL, 0, false);
   ms_cmd_add(&power_ctrl);
 
+#if SYSTEM_TRACE
+  System::Trace::Init();
+
+  auto trace_cmd_fn = [](ms_item_t *item, int argc, char **argv) {
+    XB_UNUSED(item);
+
+    return System::Trace::Command(argc, argv);
+  };
+
+  ms_file_init(&trace, "trace", trace_cmd_fn, NULL, 0, false);
+  ms_cmd_add(&trace);
+#endif
+
   term_thread.Create(term_thread_fn, static_cast<void *>(0), "term_thread", 512,
                      System::Thread::LOW);
 }
@@ -6,18 +6,23 @@
 
 #include <csignal>
 #include <cstring>
+#include <executor.hpp>
 #include <memory.hpp>
 #include <string>
 
 #include "bsp_def.h"
 #include "bsp_time.h"
 #include "system_ext.hpp"
+#include "trace.hpp"
 
 namespace System {
 class Thread {
  public:
   typedef enum { IDLE, LOW, MEDIUM, HIGH, REALTIME } Priority;
 
+  /* 是否支持抢占式多线程 */
+  static constexpr bool MULTITHREAD = true;
+
   Thread(){};
   Thread(pthread_t handle) : handle_(handle){};
 
@@ -47,6 +52,12 @@ class Thread {
       ThreadBlock* block = static_cast<ThreadBlock*>(arg);
       const char* name = block->name_;
       XB_UNUSED(name);
+#if SYSTEM_TRACE
+      /* 线程名最长15个字符，用于导出跟踪时区分线程 */
+      char thread_name[16] = {};
+      strncpy(thread_name, name, sizeof(thread_name) - 1);
+      pthread_setname_np(pthread_self(), thread_name);
+#endif
       sigset_t waitset;
       sigfillset(&waitset);
       pthread_sigmask(SIG_BLOCK, &waitset, NULL);
@@ -64,6 +75,91 @@ class Thread {
     pthread_create(&this->handle_, &attr, port, block);
   }
 
+  /* 每cycle毫秒调用一次fun，与无操作系统时的周期任务写法一致 */
+  template <typename FunType, typename ArgType>
+  void CreatePeriodic(FunType fun, ArgType arg, const char* name,
+                      uint32_t stack_depth, Priority priority,
+                      uint32_t cycle) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+#if LINUX_TASK_EXECUTOR
+    XB_UNUSED(stack_depth);
+    XB_UNUSED(priority);
+
+    TypeErasure<void, ArgType>* type = new TypeErasure<void, ArgType>(fun, arg);
+    Executor::Create(type->Port, type, name, cycle);
+#else
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      uint32_t cycle;
+      Thread* thread;
+    } PeriodicBlock;
+
+    PeriodicBlock* block = static_cast<PeriodicBlock*>(Memory::MallocStatic(
+        sizeof(PeriodicBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->cycle = cycle;
+    block->thread = this;
+
+    auto periodic_thread = [](PeriodicBlock* block) {
+      uint32_t last_online_time = bsp_time_get_ms();
+
+      while (1) {
+        block->type.fun_(block->type.arg_);
+        block->thread->SleepUntil(block->cycle, last_online_time);
+      }
+    };
+
+    this->Create(periodic_thread, block, name, stack_depth, priority);
+#endif
+  }
+
+  /* 每次event.Wait成功时调用一次fun */
+  template <typename FunType, typename ArgType, typename EventType>
+  void CreateEvent(FunType fun, ArgType arg, const char* name,
+                   uint32_t stack_depth, Priority priority, EventType& event) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      EventType* event;
+    } EventBlock;
+
+#if LINUX_TASK_EXECUTOR
+    XB_UNUSED(stack_depth);
+    XB_UNUSED(priority);
+
+    EventBlock* block = new EventBlock{TypeErasure<void, ArgType>(fun, arg),
+                                       &event};
+
+    /* 每次唤醒时处理完所有已到达的事件 */
+    auto event_task = [](void* arg) {
+      EventBlock* block = static_cast<EventBlock*>(arg);
+      while (block->event->Wait(0)) {
+        block->type.fun_(block->type.arg_);
+      }
+    };
+
+    event.Listen(Executor::Create(event_task, block, name, 0));
+#else
+    EventBlock* block = static_cast<EventBlock*>(
+        Memory::MallocStatic(sizeof(EventBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->event = &event;
+
+    auto event_thread = [](EventBlock* block) {
+      while (1) {
+        block->event->Wait(UINT32_MAX);
+        Trace::Begin(Trace::THREAD);
+        block->type.fun_(block->type.arg_);
+        Trace::End(Trace::THREAD);
+      }
+    };
+
+    this->Create(event_thread, block, name, stack_depth, priority);
+#endif
+  }
+
   static Thread Current(void) { return Thread(pthread_self()); }
 
   static void Sleep(uint32_t microseconds) {
@@ -93,10 +189,12 @@ class Thread {
   }
 
   void SleepUntil(uint32_t microseconds, uint32_t& last_wakeup_time) {
+    Trace::End(Trace::THREAD);
     while (bsp_time_get_ms() - last_wakeup_time < microseconds) {
       poll(NULL, 0, 1);
     }
     last_wakeup_time += microseconds;
+    Trace::Begin(Trace::THREAD);
   }
 
   void Delete() { pthread_cancel(this->handle_); }
@@ -0,0 +1,179 @@
+#include <thread_pool.hpp>
+#include <unistd.h>
+
+#include "bsp_def.h"
+
+using namespace System;
+
+thread_local ThreadPool::Worker* ThreadPool::current_;
+
+ThreadPool::ThreadPool(uint32_t worker_num) : worker_num_(worker_num) {
+  if (this->worker_num_ == 0) {
+    long cpu_num = sysconf(_SC_NPROCESSORS_ONLN);
+    this->worker_num_ = cpu_num > 0 ? static_cast<uint32_t>(cpu_num) : 1;
+  }
+
+  this->workers_ = new Worker[this->worker_num_];
+
+  for (uint32_t i = 0; i < this->worker_num_; i++) {
+    Worker* worker = &this->workers_[i];
+    worker->pool = this;
+    worker->index = i;
+    worker->run_count = 0;
+    worker->steal_count = 0;
+    pthread_mutex_init(&worker->mutex, NULL);
+  }
+
+  for (uint32_t i = 0; i < this->worker_num_; i++) {
+    this->workers_[i].thread.Create(WorkerThread, &this->workers_[i],
+                                    "pool_worker", 0, Thread::MEDIUM);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  this->Wait();
+
+  pthread_mutex_lock(&this->idle_mutex_);
+  this->stop_ = true;
+  pthread_cond_broadcast(&this->idle_cond_);
+  pthread_mutex_unlock(&this->idle_mutex_);
+
+  for (uint32_t i = 0; i < this->worker_num_; i++) {
+    pthread_join(this->workers_[i].thread.handle_, NULL);
+    pthread_mutex_destroy(&this->workers_[i].mutex);
+  }
+
+  delete[] this->workers_;
+}
+
+ThreadPool& ThreadPool::Default() {
+  static ThreadPool* pool = nullptr;
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+  pthread_once(&once, []() {
+    pool = new ThreadPool();
+    /* 终端在机器人对象构造前初始化，此时注册命令是安全的 */
+    new System::Term::Command<ThreadPool*>(pool, Command, "pool",
+                                           System::Term::BinDir());
+  });
+
+  return *pool;
+}
+
+void ThreadPool::Push(Job* job, Thread::Priority priority) {
+  /* 池内线程提交的任务放入自己的队列，其余轮流分配 */
+  Worker* worker = current_;
+  if (worker == nullptr || worker->pool != this) {
+    worker = &this->workers_[this->next_worker_.fetch_add(1) %
+                             this->worker_num_];
+  }
+
+  this->outstanding_++;
+
+  pthread_mutex_lock(&worker->mutex);
+  worker->deque[priority].push_back(job);
+  pthread_mutex_unlock(&worker->mutex);
+
+  pthread_mutex_lock(&this->idle_mutex_);
+  this->pending_++;
+  pthread_cond_signal(&this->idle_cond_);
+  pthread_mutex_unlock(&this->idle_mutex_);
+}
+
+ThreadPool::Job* ThreadPool::Take(Worker* worker) {
+  for (int prio = PRIORITY_NUM - 1; prio >= 0; prio--) {
+    Job* job = nullptr;
+
+    pthread_mutex_lock(&worker->mutex);
+    if (!worker->deque[prio].empty()) {
+      job = worker->deque[prio].back();
+      worker->deque[prio].pop_back();
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    if (job != nullptr) {
+      return job;
+    }
+
+    for (uint32_t i = 1; i < this->worker_num_; i++) {
+      Worker* victim =
+          &this->workers_[(worker->index + i) % this->worker_num_];
+
+      pthread_mutex_lock(&victim->mutex);
+      if (!victim->deque[prio].empty()) {
+        job = victim->deque[prio].front();
+        victim->deque[prio].pop_front();
+      }
+      pthread_mutex_unlock(&victim->mutex);
+
+      if (job != nullptr) {
+        worker->steal_count++;
+        return job;
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+void ThreadPool::WorkerThread(Worker* worker) {
+  ThreadPool* pool = worker->pool;
+  current_ = worker;
+
+  while (1) {
+    pthread_mutex_lock(&pool->idle_mutex_);
+    while (pool->pending_ == 0 && !pool->stop_) {
+      pthread_cond_wait(&pool->idle_cond_, &pool->idle_mutex_);
+    }
+    if (pool->stop_) {
+      pthread_mutex_unlock(&pool->idle_mutex_);
+      break;
+    }
+    pool->pending_--;
+    pthread_mutex_unlock(&pool->idle_mutex_);
+
+    /* pending_已为本线程预留一个任务，入队与计数之间可能短暂取不到 */
+    Job* job = pool->Take(worker);
+    while (job == nullptr) {
+      Thread::Yield();
+      job = pool->Take(worker);
+    }
+
+    job->Run();
+    delete job;
+    worker->run_count++;
+
+    if (--pool->outstanding_ == 0) {
+      pthread_mutex_lock(&pool->idle_mutex_);
+      pthread_cond_broadcast(&pool->done_cond_);
+      pthread_mutex_unlock(&pool->idle_mutex_);
+    }
+  }
+}
+
+void ThreadPool::Wait() {
+  pthread_mutex_lock(&this->idle_mutex_);
+  while (this->outstanding_ != 0) {
+    pthread_cond_wait(&this->done_cond_, &this->idle_mutex_);
+  }
+  pthread_mutex_unlock(&this->idle_mutex_);
+}
+
+int ThreadPool::Command(ThreadPool* pool, int argc, char** argv) {
+  XB_UNUSED(argv);
+
+  if (argc != 1) {
+    printf("打印线程池各工作线程的执行与窃取次数\r\n");
+    return 0;
+  }
+
+  printf("workers: %u pending: %u outstanding: %u\r\n", pool->worker_num_,
+         pool->pending_.load(), pool->outstanding_.load());
+  printf("%-8s %10s %10s\r\n", "worker", "run", "steal");
+  for (uint32_t i = 0; i < pool->worker_num_; i++) {
+    printf("%-8u %10u %10u\r\n", i, pool->workers_[i].run_count,
+           pool->workers_[i].steal_count);
+  }
+
+  return 0;
+}
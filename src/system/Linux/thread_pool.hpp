@@ -0,0 +1,95 @@
+/*
+  工作窃取线程池。
+  每个工作线程按优先级各有一组双端队列，本线程提交的任务从队尾取出，
+  空闲线程从其他线程的队首窃取，高优先级的任务总是先被取出。
+*/
+
+#pragma once
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <term.hpp>
+#include <thread.hpp>
+
+namespace System {
+class ThreadPool {
+ public:
+  static constexpr uint32_t PRIORITY_NUM = Thread::REALTIME + 1;
+
+  /* worker_num为0时使用全部在线核心 */
+  ThreadPool(uint32_t worker_num = 0);
+
+  ~ThreadPool();
+
+  /* 提交一个任务，可在任意线程中调用 */
+  template <typename FunType, typename ArgType>
+  void Submit(FunType fun, ArgType arg,
+              Thread::Priority priority = Thread::MEDIUM) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    this->Push(new JobImpl<ArgType>(fun, arg), priority);
+  }
+
+  /* 阻塞到所有已提交的任务执行完毕，不能在池内线程中调用 */
+  void Wait();
+
+  uint32_t WorkerNum() { return this->worker_num_; }
+
+  /* 进程内共享的线程池，第一次调用时创建 */
+  static ThreadPool& Default();
+
+  static int Command(ThreadPool* pool, int argc, char** argv);
+
+ private:
+  class Job {
+   public:
+    virtual ~Job() = default;
+    virtual void Run() = 0;
+  };
+
+  template <typename ArgType>
+  class JobImpl : public Job {
+   public:
+    JobImpl(void (*fun)(ArgType), ArgType arg) : type_(fun, arg) {}
+
+    void Run() override { this->type_.fun_(this->type_.arg_); }
+
+   private:
+    TypeErasure<void, ArgType> type_;
+  };
+
+  typedef struct {
+    ThreadPool* pool;
+    uint32_t index;
+    Thread thread;
+    pthread_mutex_t mutex;
+    std::deque<Job*> deque[PRIORITY_NUM];
+    uint32_t run_count;
+    uint32_t steal_count;
+  } Worker;
+
+  void Push(Job* job, Thread::Priority priority);
+
+  /* 先取本线程队尾，再从其他线程队首窃取 */
+  Job* Take(Worker* worker);
+
+  static void WorkerThread(Worker* worker);
+
+  uint32_t worker_num_;
+  Worker* workers_;
+
+  std::atomic<uint32_t> next_worker_{0};
+  std::atomic<uint32_t> pending_{0};     /* 队列中的任务 */
+  std::atomic<uint32_t> outstanding_{0}; /* 尚未执行完的任务 */
+  std::atomic<bool> stop_{false};
+
+  pthread_mutex_t idle_mutex_ = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t idle_cond_ = PTHREAD_COND_INITIALIZER;
+  pthread_cond_t done_cond_ = PTHREAD_COND_INITIALIZER;
+
+  static thread_local Worker* current_;
+};
+}  // namespace System
@@ -1,3 +1,4 @@
+#include <thread_pool.hpp>
 #include <timer.hpp>
 
 #include "bsp_time.h"
@@ -32,7 +33,22 @@ bool Timer::Refresh(ControlBlock& block, void* arg) {
   block.count++;
   if (block.cycle <= block.count) {
     block.count = 0;
-    block.fun(block.type);
+
+    if (!block.async) {
+      Trace::Begin(Trace::TIMER, "timer", block.type);
+      block.fun(block.type);
+      Trace::End(Trace::TIMER, "timer", block.type);
+    } else if (!block.busy.exchange(true)) {
+      /* 上一次尚未执行完时跳过本次 */
+      auto async_fn = [](ControlBlock* block) {
+        Trace::Begin(Trace::TIMER, "timer", block->type);
+        block->fun(block->type);
+        Trace::End(Trace::TIMER, "timer", block->type);
+        block->busy = false;
+      };
+
+      ThreadPool::Default().Submit(async_fn, &block, block.priority);
+    }
   }
 
   return true;
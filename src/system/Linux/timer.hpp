@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <list.hpp>
 #include <thread.hpp>
 
@@ -14,6 +15,9 @@ class Timer {
     uint16_t cycle;
     uint16_t count;
     bool running;
+    bool async; /* 交给线程池执行 */
+    Thread::Priority priority;
+    std::atomic<bool> busy; /* 线程池中尚有未执行完的任务 */
   } ControlBlock;
 
   typedef System::List<ControlBlock>::Node* TimerHandle;
@@ -24,22 +28,22 @@ class Timer {
 
   template <typename FunType, typename ArgType>
   static TimerHandle Create(FunType fun, ArgType arg, uint32_t cycle) {
-    (void)static_cast<void (*)(ArgType)>(fun);
-    TypeErasure<void, ArgType>* type = static_cast<TypeErasure<void, ArgType>*>(
-        malloc(sizeof(TypeErasure<void, ArgType>)));
-    *type = TypeErasure<void, ArgType>(fun, arg);
-    auto block = new System::List<ControlBlock>::Node;
-    block->data_.count = 0;
-    block->data_.cycle = cycle;
-    block->data_.fun = type->Port;
-    block->data_.type = type;
-    block->data_.running = true;
-    self_->list_.Add(*block);
-    return block;
+    return Create(fun, arg, cycle, false, Thread::MEDIUM);
+  }
+
+  /* 回调在线程池中执行，不占用定时器线程 */
+  template <typename FunType, typename ArgType>
+  static TimerHandle CreateAsync(FunType fun, ArgType arg, uint32_t cycle,
+                                 Thread::Priority priority = Thread::MEDIUM) {
+    return Create(fun, arg, cycle, true, priority);
   }
 
+  /* 等待线程池中的任务执行完再释放，不能在该定时器的回调中调用 */
   static void Delete(TimerHandle& handle) {
     self_->list_.Delete(*handle);
+    while (handle->data_.busy) {
+      Thread::Sleep(1);
+    }
     delete (handle);
   }
 
@@ -54,5 +58,27 @@ class Timer {
   static Timer* self_;
   List<ControlBlock> list_;
   Thread thread_;
+
+ private:
+  /* 控制块填写完整后再加入链表，定时器线程不会看到未初始化的字段 */
+  template <typename FunType, typename ArgType>
+  static TimerHandle Create(FunType fun, ArgType arg, uint32_t cycle,
+                            bool async, Thread::Priority priority) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+    TypeErasure<void, ArgType>* type = static_cast<TypeErasure<void, ArgType>*>(
+        malloc(sizeof(TypeErasure<void, ArgType>)));
+    *type = TypeErasure<void, ArgType>(fun, arg);
+    auto block = new System::List<ControlBlock>::Node;
+    block->data_.count = 0;
+    block->data_.cycle = cycle;
+    block->data_.fun = type->Port;
+    block->data_.type = type;
+    block->data_.running = true;
+    block->data_.async = async;
+    block->data_.priority = priority;
+    block->data_.busy = false;
+    self_->list_.Add(*block);
+    return block;
+  }
 };
 }  // namespace System
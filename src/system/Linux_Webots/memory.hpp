@@ -7,7 +7,34 @@
 namespace System {
 class Memory {
  public:
+  typedef enum {
+    STATIC_THREAD_STACK,
+    STATIC_THREAD_TCB,
+    STATIC_QUEUE,
+    STATIC_CALLBACK,
+    STATIC_TIMER,
+    STATIC_ROBOT,
+    STATIC_OTHER,
+    STATIC_TYPE_NUM
+  } StaticType;
+
   static void* Malloc(size_t size) { return malloc(size); }
   static void Free(void* block) { free(block); }
+
+  /* 永不释放的系统对象，此平台直接从堆中分配 */
+  static void* MallocStatic(size_t size, StaticType type = STATIC_OTHER) {
+    (void)type;
+    return malloc(size);
+  }
+
+  /* 此平台不统计各模块的内存使用 */
+  static void SetOwner(const char* owner) { (void)owner; }
+
+  static void Seal() {}
+
+  class Owner {
+   public:
+    Owner(const char* name) { SetOwner(name); }
+  };
 };
 }  // namespace System
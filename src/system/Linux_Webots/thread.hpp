@@ -19,6 +19,9 @@ class Thread {
  public:
   typedef enum { IDLE, LOW, MEDIUM, HIGH, REALTIME } Priority;
 
+  /* 是否支持抢占式多线程 */
+  static constexpr bool MULTITHREAD = true;
+
   Thread(){};
   Thread(pthread_t handle) : handle_(handle){};
 
@@ -65,6 +68,63 @@ class Thread {
     pthread_create(&this->handle_, &attr, port, block);
   }
 
+  /* 每cycle毫秒调用一次fun，与无操作系统时的周期任务写法一致 */
+  template <typename FunType, typename ArgType>
+  void CreatePeriodic(FunType fun, ArgType arg, const char* name,
+                      uint32_t stack_depth, Priority priority,
+                      uint32_t cycle) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      uint32_t cycle;
+      Thread* thread;
+    } PeriodicBlock;
+
+    PeriodicBlock* block = static_cast<PeriodicBlock*>(Memory::MallocStatic(
+        sizeof(PeriodicBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->cycle = cycle;
+    block->thread = this;
+
+    auto periodic_thread = [](PeriodicBlock* block) {
+      uint32_t last_online_time = bsp_time_get_ms();
+
+      while (1) {
+        block->type.fun_(block->type.arg_);
+        block->thread->SleepUntil(block->cycle, last_online_time);
+      }
+    };
+
+    this->Create(periodic_thread, block, name, stack_depth, priority);
+  }
+
+  /* 每次event.Wait成功时调用一次fun */
+  template <typename FunType, typename ArgType, typename EventType>
+  void CreateEvent(FunType fun, ArgType arg, const char* name,
+                   uint32_t stack_depth, Priority priority, EventType& event) {
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      EventType* event;
+    } EventBlock;
+
+    EventBlock* block = static_cast<EventBlock*>(
+        Memory::MallocStatic(sizeof(EventBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->event = &event;
+
+    auto event_thread = [](EventBlock* block) {
+      while (1) {
+        block->event->Wait(UINT32_MAX);
+        block->type.fun_(block->type.arg_);
+      }
+    };
+
+    this->Create(event_thread, block, name, stack_depth, priority);
+  }
+
   static Thread Current(void) { return Thread(pthread_self()); }
 
   static void Sleep(uint32_t microseconds) {
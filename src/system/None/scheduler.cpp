@@ -0,0 +1,132 @@
+#include <cstdio>
+#include <memory.hpp>
+#include <new>
+#include <scheduler.hpp>
+#include <timer.hpp>
+
+#include "bsp_def.h"
+
+using namespace System;
+
+Scheduler::Task* Scheduler::list_;
+
+Scheduler::Scheduler() : cmd_(this, Command, "task", System::Term::BinDir()) {
+  auto timer_task = [](Task* task, void* arg) {
+    XB_UNUSED(arg);
+
+    XB_TASK_BEGIN(task);
+
+    while (1) {
+      Timer::self_->list_.Foreach(Timer::Refresh, NULL);
+      XB_TASK_SLEEP_UNTIL(task, 1);
+    }
+
+    XB_TASK_END(task);
+  };
+
+  Create(timer_task, NULL, "timer", UINT32_MAX);
+}
+
+Scheduler::Task* Scheduler::Create(Task::Fun fun, void* arg, const char* name,
+                                   uint32_t priority) {
+  Task* task = static_cast<Task*>(
+      Memory::MallocStatic(sizeof(Task), Memory::STATIC_THREAD_TCB));
+  new (task) Task();
+
+  task->name_ = name;
+  task->fun_ = fun;
+  task->arg_ = arg;
+  task->priority_ = priority;
+  task->wake_time_ = bsp_time_get_ms();
+
+  /* 按优先级从高到低插入，同优先级按创建顺序 */
+  Task** pos = &list_;
+  while (*pos != nullptr && (*pos)->priority_ >= priority) {
+    pos = &(*pos)->next_;
+  }
+  task->next_ = *pos;
+  *pos = task;
+
+  return task;
+}
+
+void Scheduler::Poll() {
+  Task** pos = &list_;
+
+  while (*pos != nullptr) {
+    Task* task = *pos;
+
+    if (task->status_ == TASK_SLEEP &&
+        static_cast<int32_t>(bsp_time_get_ms() - task->wake_time_) < 0) {
+      pos = &task->next_;
+      continue;
+    }
+
+#ifdef USE_VIRTUAL_CLOCK
+    /* 虚拟时钟在任务执行期间不走，耗时按主机CPU时间统计 */
+    const uint64_t START = bsp_time_get_cpu_us();
+    task->status_ = task->fun_(task, task->arg_);
+    const uint32_t DURATION =
+        static_cast<uint32_t>(bsp_time_get_cpu_us() - START);
+#else
+    const uint64_t START = bsp_time_get();
+    task->status_ = task->fun_(task, task->arg_);
+    const uint32_t DURATION = static_cast<uint32_t>(bsp_time_get() - START);
+#endif
+
+    task->run_count_++;
+    if (DURATION > task->run_max_us_) {
+      task->run_max_us_ = DURATION;
+    }
+
+    if (task->status_ == TASK_EXIT) {
+      *pos = task->next_;
+    } else {
+      pos = &task->next_;
+    }
+  }
+}
+
+uint32_t Scheduler::NextWakeTime() {
+  const uint32_t NOW = bsp_time_get_ms();
+  uint32_t next = NOW + 1;
+  bool found = false;
+
+  for (Task* task = list_; task != nullptr; task = task->next_) {
+    if (task->status_ != TASK_SLEEP) {
+      continue;
+    }
+    if (!found || static_cast<int32_t>(task->wake_time_ - next) < 0) {
+      next = task->wake_time_;
+      found = true;
+    }
+  }
+
+  return next;
+}
+
+int Scheduler::Command(Scheduler* scheduler, int argc, char** argv) {
+  XB_UNUSED(scheduler);
+
+  if (argc == 1) {
+    printf("%-20s %8s %10s %6s %10s\r\n", "name", "priority", "run", "miss",
+           "max(us)");
+    for (Task* task = list_; task != nullptr; task = task->next_) {
+      printf("%-20s %8lu %10lu %6lu %10lu\r\n", task->name_,
+             static_cast<unsigned long>(task->priority_),
+             static_cast<unsigned long>(task->run_count_),
+             static_cast<unsigned long>(task->miss_count_),
+             static_cast<unsigned long>(task->run_max_us_));
+    }
+  } else if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+    for (Task* task = list_; task != nullptr; task = task->next_) {
+      task->run_count_ = 0;
+      task->miss_count_ = 0;
+      task->run_max_us_ = 0;
+    }
+  } else {
+    printf("[reset] 清除统计数据\r\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+  无操作系统时的协作式调度器。
+  任务为无栈协程，每次调用执行到让出点后返回，不需要独立的栈。
+  每轮调度按优先级从高到低执行所有已就绪的任务，任务之间不会抢占。
+  局部变量在让出后失效，需要跨越让出点的状态放在参数对象中。
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <term.hpp>
+
+#include "bsp_time.h"
+
+/* 以行号作为恢复位置，同一行不能出现两个让出点 */
+#define XB_TASK_BEGIN(_task) \
+  switch ((_task)->lc_) {    \
+    case 0:
+
+#define XB_TASK_END(_task) \
+  }                        \
+  (_task)->lc_ = 0;        \
+  return System::Scheduler::TASK_EXIT
+
+/* 让出一次，下一轮调度继续执行 */
+#define XB_TASK_YIELD(_task)              \
+  do {                                    \
+    (_task)->lc_ = __LINE__;              \
+    return System::Scheduler::TASK_READY; \
+    case __LINE__:;                       \
+  } while (0)
+
+/* 条件不满足时让出，每轮调度重新检查 */
+#define XB_TASK_WAIT_UNTIL(_task, _cond)      \
+  do {                                        \
+    (_task)->lc_ = __LINE__;                  \
+    case __LINE__:                            \
+      if (!(_cond)) {                         \
+        return System::Scheduler::TASK_READY; \
+      }                                       \
+  } while (0)
+
+/* 从上次唤醒时间起休眠_cycle毫秒，用于固定周期 */
+#define XB_TASK_SLEEP_UNTIL(_task, _cycle) \
+  do {                                     \
+    (_task)->Delay(_cycle);                \
+    (_task)->lc_ = __LINE__;               \
+    return System::Scheduler::TASK_SLEEP;  \
+    case __LINE__:;                        \
+  } while (0)
+
+namespace System {
+class Scheduler {
+ public:
+  typedef enum {
+    TASK_READY, /* 下一轮调度继续执行 */
+    TASK_SLEEP, /* 到达唤醒时间后执行 */
+    TASK_EXIT,  /* 从调度中移除 */
+  } Status;
+
+  class Task {
+   public:
+    typedef Status (*Fun)(Task* task, void* arg);
+
+    /* 唤醒时间推进一个周期，与SleepUntil一致，落后时会连续执行追赶 */
+    void Delay(uint32_t cycle) {
+      this->wake_time_ += cycle;
+      if (static_cast<int32_t>(bsp_time_get_ms() - this->wake_time_) > 0) {
+        this->miss_count_++;
+      }
+    }
+
+    uint16_t lc_ = 0;
+
+   private:
+    const char* name_;
+    Fun fun_;
+    void* arg_;
+    uint32_t priority_;
+    uint32_t wake_time_;
+    Status status_ = TASK_READY;
+    Task* next_ = nullptr;
+
+    uint32_t run_count_ = 0;
+    uint32_t miss_count_ = 0;
+    uint32_t run_max_us_ = 0;
+
+    friend class Scheduler;
+  };
+
+  /* 注册终端命令并接管软定时器 */
+  Scheduler();
+
+  /* priority越大越先执行 */
+  static Task* Create(Task::Fun fun, void* arg, const char* name,
+                      uint32_t priority);
+
+  /* 执行一轮调度 */
+  static void Poll();
+
+  /* 休眠任务中最早的唤醒时间，就绪任务只在轮询条件，不参与比较 */
+  static uint32_t NextWakeTime();
+
+  static int Command(Scheduler* scheduler, int argc, char** argv);
+
+ private:
+  System::Term::Command<Scheduler*> cmd_;
+
+  static Task* list_;
+};
+}  // namespace System
@@ -1,5 +1,6 @@
 #include <semaphore.hpp>
 
+#include "bsp_def.h"
 #include "bsp_time.h"
 
 using namespace System;
@@ -16,12 +17,21 @@ void Semaphore::Post() {
 }
 
 bool Semaphore::Wait(uint32_t timeout) {
+#ifdef USE_VIRTUAL_CLOCK
+  /* 单线程且没有中断，等待期间不会被释放，等同于超时 */
+  if (!count_) {
+    XB_ASSERT(timeout != UINT32_MAX);
+    bsp_time_advance_to(bsp_time_get_ms() + timeout);
+    return false;
+  }
+#else
   uint32_t time = bsp_time_get_ms();
   while (!count_) {
     if (bsp_time_get_ms() - time >= timeout) {
       return false;
     }
   }
+#endif
   count_--;
   return true;
 }
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory.hpp>
 #include <queue.hpp>
+#include <scheduler.hpp>
 #include <semaphore.hpp>
 #include <term.hpp>
 #include <thread.hpp>
@@ -18,16 +19,18 @@ void Start(RobotParam... param) {
   new Timer();
   new Term();
   new Database();
+  new Scheduler();
 
   static auto xrobot_debug_handle = new RobotType(param...);
 
   XB_UNUSED(xrobot_debug_handle);
 
-  uint32_t last_online_time = bsp_time_get_ms();
-
   while (1) {
-    Timer::self_->list_.Foreach(Timer::Refresh, NULL);
-    Timer::self_->thread_.SleepUntil(1, last_online_time);
+    Scheduler::Poll();
+#ifdef USE_VIRTUAL_CLOCK
+    /* 虚拟时钟不会自己走，跳到下一个任务的唤醒时间 */
+    bsp_time_advance_to(Scheduler::NextWakeTime());
+#endif
   }
 }
 }  // namespace System
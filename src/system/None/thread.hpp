@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <memory.hpp>
+#include <scheduler.hpp>
 #include <string>
 
 #include "bsp_def.h"
@@ -12,6 +14,10 @@ class Thread {
  public:
   typedef enum { IDLE, LOW, MEDIUM, HIGH, REALTIME } Priority;
 
+  /* 是否支持抢占式多线程，不支持时Create不会创建线程 */
+  static constexpr bool MULTITHREAD = false;
+
+  /* 循环线程无法在无栈调度器中运行，需要改用CreatePeriodic或CreateEvent */
   template <typename FunType, typename ArgType>
   void Create(FunType fun, ArgType arg, const char* name, uint32_t stack_depth,
               Priority priority) {
@@ -22,12 +28,74 @@ class Thread {
     XB_UNUSED(priority);
   }
 
+  /* 每cycle毫秒调用一次fun，fun执行完毕后返回 */
+  template <typename FunType, typename ArgType>
+  void CreatePeriodic(FunType fun, ArgType arg, const char* name,
+                      uint32_t stack_depth, Priority priority,
+                      uint32_t cycle) {
+    XB_UNUSED(stack_depth);
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      uint32_t cycle;
+    } PeriodicBlock;
+
+    PeriodicBlock* block = static_cast<PeriodicBlock*>(Memory::MallocStatic(
+        sizeof(PeriodicBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->cycle = cycle;
+
+    auto periodic_task = [](Scheduler::Task* task, void* arg) {
+      PeriodicBlock* block = static_cast<PeriodicBlock*>(arg);
+      block->type.fun_(block->type.arg_);
+      task->Delay(block->cycle);
+      return Scheduler::TASK_SLEEP;
+    };
+
+    Scheduler::Create(periodic_task, block, name, priority);
+  }
+
+  /* event.Wait(0)成功时调用一次fun */
+  template <typename FunType, typename ArgType, typename EventType>
+  void CreateEvent(FunType fun, ArgType arg, const char* name,
+                   uint32_t stack_depth, Priority priority, EventType& event) {
+    XB_UNUSED(stack_depth);
+    (void)static_cast<void (*)(ArgType)>(fun);
+
+    typedef struct {
+      TypeErasure<void, ArgType> type;
+      EventType* event;
+    } EventBlock;
+
+    EventBlock* block = static_cast<EventBlock*>(
+        Memory::MallocStatic(sizeof(EventBlock), Memory::STATIC_CALLBACK));
+    block->type = TypeErasure<void, ArgType>(fun, arg);
+    block->event = &event;
+
+    auto event_task = [](Scheduler::Task* task, void* arg) {
+      XB_UNUSED(task);
+      EventBlock* block = static_cast<EventBlock*>(arg);
+      if (block->event->Wait(0)) {
+        block->type.fun_(block->type.arg_);
+      }
+      return Scheduler::TASK_READY;
+    };
+
+    Scheduler::Create(event_task, block, name, priority);
+  }
+
   static Thread Current(void) { return Thread(); }
 
+  /* 虚拟时钟下直接推进时间，期间其他任务不会运行 */
   static void Sleep(uint32_t microseconds) {
+#ifdef USE_VIRTUAL_CLOCK
+    bsp_time_advance_to(bsp_time_get_ms() + microseconds);
+#else
     auto last_time = bsp_time_get_ms();
     while ((bsp_time_get_ms() - last_time) < microseconds) {
     }
+#endif
   }
 
   static void SleepMilliseconds(uint32_t microseconds) { Sleep(microseconds); }
@@ -51,8 +119,12 @@ class Thread {
   }
 
   void SleepUntil(uint32_t microseconds, uint32_t& last_time) {
+#ifdef USE_VIRTUAL_CLOCK
+    bsp_time_advance_to(last_time + microseconds);
+#else
     while ((bsp_time_get_ms() - last_time) < microseconds) {
     }
+#endif
 
     last_time += microseconds;
   }
@@ -0,0 +1,276 @@
+/*
+  调度跟踪。
+  线程循环、信号量、话题发布与软定时器的事件写入无锁环形缓冲区，
+  通过终端的trace命令导出，再由utils/python/trace_to_chrome.py转换为
+  Chrome trace格式，在chrome://tracing或Perfetto中查看。
+  未开启SYSTEM_TRACE时所有接口为空函数。
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#if SYSTEM_TRACE
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#include "bsp_time.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <time.h>
+#else
+#include "FreeRTOS.h"
+#include "bsp_sys.h"
+#include "task.h"
+#endif
+
+#ifndef SYSTEM_TRACE_BUFFER_NUM
+#define SYSTEM_TRACE_BUFFER_NUM (512)
+#endif
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__)
+#define SYSTEM_TRACE_DWT (1)
+#else
+#define SYSTEM_TRACE_DWT (0)
+#endif
+
+#endif
+
+namespace System {
+class Trace {
+ public:
+  typedef enum {
+    THREAD,    /* 线程一次循环 */
+    SEMAPHORE, /* 信号量阻塞等待与释放 */
+    TOPIC,     /* 话题发布 */
+    TIMER,     /* 软定时器回调 */
+  } Category;
+
+#if SYSTEM_TRACE
+  static_assert((SYSTEM_TRACE_BUFFER_NUM & (SYSTEM_TRACE_BUFFER_NUM - 1)) == 0,
+                "SYSTEM_TRACE_BUFFER_NUM must be a power of 2.");
+
+#if defined(__linux__)
+  typedef uint64_t Tick; /* CLOCK_MONOTONIC，单位ns */
+#else
+  typedef uint32_t Tick; /* DWT周期计数，不支持时为us */
+#endif
+
+  typedef struct {
+    std::atomic<uint32_t> seq; /* 写入完成后为序号+1 */
+    char phase;                /* B开始 E结束 i瞬时 */
+    uint8_t category;
+    Tick time;
+    const void* thread;
+    const char* name;
+    const void* obj;
+  } Event;
+
+  static void Init() {
+#if !defined(__linux__) && SYSTEM_TRACE_DWT
+    /* DEMCR.TRCENA与DWT_CTRL.CYCCNTENA */
+    *reinterpret_cast<volatile uint32_t*>(0xE000EDFCu) |= 1u << 24;
+    *reinterpret_cast<volatile uint32_t*>(0xE0001004u) = 0;
+    *reinterpret_cast<volatile uint32_t*>(0xE0001000u) |= 1u;
+#endif
+    enabled_ = true;
+  }
+
+  static Tick Now() {
+#if defined(__linux__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<Tick>(ts.tv_sec) * 1000000000u + ts.tv_nsec;
+#elif SYSTEM_TRACE_DWT
+    return *reinterpret_cast<volatile uint32_t*>(0xE0001004u);
+#else
+    return static_cast<Tick>(bsp_time_get());
+#endif
+  }
+
+  /* 可在中断中调用 */
+  static void Record(char phase, Category category, const char* name,
+                     const void* obj) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    const uint32_t IDX = head_.fetch_add(1, std::memory_order_relaxed);
+    Event& event = buffer_[IDX & (SYSTEM_TRACE_BUFFER_NUM - 1)];
+
+    event.seq.store(0, std::memory_order_relaxed);
+    event.phase = phase;
+    event.category = category;
+    event.time = Now();
+    event.thread = CurrentThread();
+    event.name = name;
+    event.obj = obj;
+    event.seq.store(IDX + 1, std::memory_order_release);
+  }
+
+  static void Begin(Category category, const char* name = nullptr,
+                    const void* obj = nullptr) {
+    Record('B', category, name, obj);
+  }
+
+  static void End(Category category, const char* name = nullptr,
+                  const void* obj = nullptr) {
+    Record('E', category, name, obj);
+  }
+
+  static void Instant(Category category, const char* name = nullptr,
+                      const void* obj = nullptr) {
+    Record('i', category, name, obj);
+  }
+
+  static int Command(int argc, char** argv) {
+    if (argc != 2) {
+      printf("[start] 开始记录\r\n");
+      printf("[stop]  停止记录\r\n");
+      printf("[dump]  停止记录并导出缓冲区\r\n");
+      return 0;
+    }
+
+    if (strcmp(argv[1], "start") == 0) {
+      head_ = 0;
+      enabled_ = true;
+    } else if (strcmp(argv[1], "stop") == 0) {
+      enabled_ = false;
+    } else if (strcmp(argv[1], "dump") == 0) {
+      enabled_ = false;
+      Dump();
+    } else {
+      printf("未知参数\r\n");
+      return -1;
+    }
+
+    return 0;
+  }
+
+ private:
+  static const void* CurrentThread() {
+#if defined(__linux__)
+    return reinterpret_cast<const void*>(pthread_self());
+#else
+    return bsp_sys_in_isr() ? nullptr : xTaskGetCurrentTaskHandle();
+#endif
+  }
+
+  static const char* ThreadName(const void* thread) {
+#if defined(__linux__)
+    static char name[16];
+    if (pthread_getname_np(reinterpret_cast<pthread_t>(thread), name,
+                           sizeof(name)) != 0) {
+      return "unknown";
+    }
+    return name;
+#else
+    if (thread == nullptr) {
+      return "isr";
+    }
+    return pcTaskGetName(
+        static_cast<TaskHandle_t>(const_cast<void*>(thread)));
+#endif
+  }
+
+  /* 时间戳每us的计数，供转换脚本换算 */
+  static float TickPerUs() {
+#if defined(__linux__)
+    return 1000.0f;
+#elif SYSTEM_TRACE_DWT
+    const uint64_t US_START = bsp_time_get();
+    const uint32_t TICK_START = Now();
+    while (bsp_time_get() - US_START < 1000) {
+    }
+    const uint32_t TICK_END = Now();
+    const uint64_t US_END = bsp_time_get();
+    return static_cast<float>(TICK_END - TICK_START) /
+           static_cast<float>(US_END - US_START);
+#else
+    return 1.0f;
+#endif
+  }
+
+  static void Dump() {
+    const uint32_t HEAD = head_.load();
+    const uint32_t START =
+        HEAD > SYSTEM_TRACE_BUFFER_NUM ? HEAD - SYSTEM_TRACE_BUFFER_NUM : 0;
+
+    printf("# xrobot trace\r\n");
+    printf("# tick_per_us %f\r\n", static_cast<double>(TickPerUs()));
+
+    /* 先输出线程名表 */
+    const void* threads[32];
+    uint32_t thread_num = 0;
+
+    for (uint32_t i = START; i < HEAD; i++) {
+      Event& event = buffer_[i & (SYSTEM_TRACE_BUFFER_NUM - 1)];
+      if (event.seq.load(std::memory_order_acquire) != i + 1) {
+        continue;
+      }
+
+      uint32_t j = 0;
+      while (j < thread_num && threads[j] != event.thread) {
+        j++;
+      }
+      if (j == thread_num && thread_num < 32) {
+        threads[thread_num++] = event.thread;
+        printf("t,%p,%s\r\n", event.thread, ThreadName(event.thread));
+      }
+    }
+
+    for (uint32_t i = START; i < HEAD; i++) {
+      Event& event = buffer_[i & (SYSTEM_TRACE_BUFFER_NUM - 1)];
+      if (event.seq.load(std::memory_order_acquire) != i + 1) {
+        continue;
+      }
+
+#if defined(__linux__)
+      printf("e,%llu,%c,%u,%p,%s,%p\r\n",
+             static_cast<unsigned long long>(event.time), event.phase,
+             event.category, event.thread,
+             event.name != nullptr ? event.name : "", event.obj);
+#else
+      printf("e,%lu,%c,%u,%p,%s,%p\r\n",
+             static_cast<unsigned long>(event.time), event.phase,
+             event.category, event.thread,
+             event.name != nullptr ? event.name : "", event.obj);
+#endif
+    }
+
+    printf("# end\r\n");
+  }
+
+  static inline Event buffer_[SYSTEM_TRACE_BUFFER_NUM];
+  static inline std::atomic<uint32_t> head_{0};
+  static inline std::atomic<bool> enabled_{false};
+#else
+  static void Init() {}
+
+  static void Begin(Category category, const char* name = nullptr,
+                    const void* obj = nullptr) {
+    (void)category;
+    (void)name;
+    (void)obj;
+  }
+
+  static void End(Category category, const char* name = nullptr,
+                  const void* obj = nullptr) {
+    (void)category;
+    (void)name;
+    (void)obj;
+  }
+
+  static void Instant(Category category, const char* name = nullptr,
+                      const void* obj = nullptr) {
+    (void)category;
+    (void)name;
+    (void)obj;
+  }
+#endif
+};
+}  // namespace System
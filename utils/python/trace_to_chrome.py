@@ -0,0 +1,103 @@
+"""
+将终端trace dump命令的输出转换为Chrome trace格式，
+生成的json文件可在chrome://tracing或https://ui.perfetto.dev中打开。
+
+用法: python trace_to_chrome.py dump.txt [trace.json]
+"""
+
+import json
+import sys
+
+CATEGORY = ["thread", "semaphore", "topic", "timer"]
+
+
+class TraceConverter:
+    def __init__(self):
+        self.tick_per_us = 1.0
+        self.threads = {}
+        self.events = []
+
+    def thread_id(self, thread):
+        if thread not in self.threads:
+            self.threads[thread] = {"tid": len(self.threads) + 1, "name": thread}
+        return self.threads[thread]["tid"]
+
+    def parse(self, lines):
+        for line in lines:
+            line = line.strip()
+            if line.startswith("# tick_per_us"):
+                self.tick_per_us = float(line.split()[2])
+            elif line.startswith("t,"):
+                _, thread, name = line.split(",", 2)
+                self.thread_id(thread)
+                self.threads[thread]["name"] = name
+            elif line.startswith("e,"):
+                fields = line.split(",")
+                if len(fields) != 7:
+                    continue
+                _, time, phase, category, thread, name, obj = fields
+                self.events.append((int(time), phase, int(category), thread, name, obj))
+
+    def convert(self):
+        trace = []
+
+        for thread in self.threads.values():
+            trace.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": thread["tid"],
+                          "args": {"name": thread["name"]}})
+
+        # MCU上的时间戳为32位计数，回绕时补上溢出部分
+        offset = 0
+        last = None
+        start = None
+        depth = {}
+
+        for time, phase, category, thread, name, obj in self.events:
+            if last is not None and last - time > 1 << 31 and last < 1 << 32:
+                offset += 1 << 32
+            last = time
+            time += offset
+
+            if start is None:
+                start = time
+
+            tid = self.thread_id(thread)
+
+            # 缓冲区覆盖掉了开始事件的结束事件无法配对
+            if phase == "E":
+                if depth.get(tid, 0) == 0:
+                    continue
+                depth[tid] -= 1
+            elif phase == "B":
+                depth[tid] = depth.get(tid, 0) + 1
+
+            cat = CATEGORY[category] if category < len(CATEGORY) else str(category)
+            event = {"name": name if name else cat, "cat": cat, "ph": phase, "pid": 1, "tid": tid,
+                     "ts": (time - start) / self.tick_per_us}
+            if phase == "i":
+                event["s"] = "t"
+            if obj not in ("(nil)", "0", "0x0"):
+                event["args"] = {"obj": obj}
+            trace.append(event)
+
+        return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("用法: python trace_to_chrome.py dump.txt [trace.json]")
+        return
+
+    output = sys.argv[2] if len(sys.argv) > 2 else "trace.json"
+
+    converter = TraceConverter()
+    with open(sys.argv[1], "r", encoding="utf-8", errors="ignore") as f:
+        converter.parse(f.readlines())
+
+    with open(output, "w", encoding="utf-8") as f:
+        json.dump(converter.convert(), f)
+
+    print("已转换%d个事件，输出到%s" % (len(converter.events), output))
+
+
+if __name__ == "__main__":
+    main()